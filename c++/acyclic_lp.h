@@ -10,6 +10,9 @@
  *  each call to {@code pathTo(int)} takes time proportional to the number of
  *  edges in the shortest path returned.
  *  <p>
+ *  The class is a template over the representation of the digraph: any
+ *  {@code WeightedDigraph}, with the argument deduced from the constructor.
+ *  <p>
  *  For additional documentation,   
  *  see <a href="https://algs4.cs.princeton.edu/44sp">Section 4.4</a> of   
  *  <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne. 
@@ -27,21 +30,41 @@
 #include <exception>
 #include <string>
 
-#include "edge_weighted_digraph.h"
+#include "directed_edge.h"
+#include "graph_concepts.h"
+#include "topological_sort.h"
 #include "directed_edge.h"
 
 namespace algs4 {
+template <WeightedDigraph Graph>
 class AcyclicLP {
  public:
   /**
    * Computes a longest paths tree from {@code s} to every other vertex in
    * the directed acyclic graph {@code G}.
+   * {@code G} must outlive this object, since {@code PathTo} reads its edges.
    * @param G the acyclic digraph
    * @param s the source vertex
    * @throws IllegalArgumentException if the digraph is not acyclic
    * @throws IllegalArgumentException unless {@code 0 <= s < V}
    */
-  AcyclicLP(const EdgeWeightedDigraph& G, int s);
+  AcyclicLP(const Graph& G, int s) :
+    dist_to_(G.V()), edge_to_(G.V(), -1), graph_(&G) {
+	ValidateVertex(s);
+
+	for (int v = 0; v < G.V(); v++)
+	  dist_to_[v] = std::numeric_limits<double>::lowest();
+	dist_to_[s] = 0.0;
+
+	// relax vertices in topological order
+	Topological topological(G);
+	if (!topological.HasOrder())
+	  throw std::invalid_argument("Digraph is not acyclic.");
+	for (int v : topological.order()) {
+	  for (int e : G.Adj(v))
+		Relax(G, e);
+	}
+  }
   AcyclicLP() = delete;
   AcyclicLP(const AcyclicLP& other) = delete;
   AcyclicLP &operator=(const AcyclicLP& other) = delete;
@@ -67,7 +90,7 @@ class AcyclicLP {
    */
   bool HasPathTo(int v) const {
 	ValidateVertex(v);
-	return dist_to_[v] > std::numeric_limits<double>::min();
+	return dist_to_[v] > std::numeric_limits<double>::lowest();
   }
   /**
    * Returns a longest path from the source vertex {@code s} to vertex {@code v}.
@@ -76,17 +99,43 @@ class AcyclicLP {
    *         as an iterable of edges, and {@code null} if no such path
    * @throws IllegalArgumentException unless {@code 0 <= v < V}
    */
-  std::vector<DirectedEdge *> PathTo(int v);
+  std::vector<DirectedEdge> PathTo(int v) {
+	ValidateVertex(v);
+	if (!HasPathTo(v)) return {};
+	std::stack<DirectedEdge> path;
+	for (int e = edge_to_[v]; e != -1; e = edge_to_[graph_->from(e)]) {
+	  path.push(DirectedEdgeOf(*graph_, e));
+	}
+	std::vector<DirectedEdge> res;
+	while (!path.empty()) {
+	  res.push_back(path.top());
+	  path.pop();
+	}
+
+	return res;
+  }
 
  private:
   // relax edge e, but update if you find a *longer* path
-  void Relax(const DirectedEdge& e);
+  void Relax(const Graph& G, int e) {
+	int v = G.from(e), w = G.to(e);
+	if (dist_to_[w] < dist_to_[v] + G.weight(e)) {
+	  dist_to_[w] = dist_to_[v] + G.weight(e);
+	  edge_to_[w] = e;
+	}
+  }
   // throw an IllegalArgumentException unless {@code 0 <= v < V}
-  void ValidateVertex(int v) const;
+  void ValidateVertex(int v) const {
+	int V = dist_to_.size();
+	if (v < 0 || v >= V)
+	  throw std::invalid_argument("vertex " + std::to_string(v) +
+								  " is not between 0 and " + std::to_string(V-1));
+  }
 
  private:
   std::vector<double> dist_to_;          // distTo[v] = distance  of longest s->v path
-  std::vector<DirectedEdge *> edge_to_;    // edgeTo[v] = last edge on longest s->v path
+  std::vector<int> edge_to_;             // edgeTo[v] = id of last edge on longest s->v path, or -1
+  const Graph* graph_;                   // the digraph, which must outlive this object
 };
 }
 
@@ -2,7 +2,8 @@
  *  Compilation:  clang++ -c -O2 directed_edge.cc -std=c++20
  *                clang++ -c -O2 edge_weighted_digraph.cc -std=c++20
  *                clang++ -c -O2 topological_sort.cc -std=c++20
- *                clang++ -DDebug -O2 acyclic_sp.cc topological_sort.o directed_edge.o edge_weighted_digraph.o -std=c++20 -o acyclic_sp
+ *                clang++ -c -O2 depth_first_order.cc -std=c++20
+ *                clang++ -DDebug -O2 acyclic_sp.cc topological_sort.o directed_edge.o edge_weighted_digraph.o depth_first_order.o -std=c++20 -o acyclic_sp
  *  Execution:    ./acyclic_sp V E
  *  Dependencies: directed_edge.cc edge_weighted_digraph.cc topological_sort.cc
  *  Data files:   https://algs4.cs.princeton.edu/44sp/tinyEWDAG.txt
@@ -23,68 +24,11 @@
 
 #include "acyclic_sp.h"
 
-#include <limits>
-#include <exception>
-
 #include "directed_edge.h"
-#include "topological_sort.h"
+#include "edge_weighted_digraph.h"
 
 using std::vector;
 using std::stack;
-using std::to_string;
-using std::numeric_limits;
-
-namespace algs4 {
-  AcyclicSP::AcyclicSP(const EdgeWeightedDigraph& G, int s) : 
-    dist_to_(G.V()), edge_to_(G.V()) {
-
-  ValidateVertex(s);
-
-  for (int v = 0; v < G.V(); v++)
-    dist_to_[v] = numeric_limits<double>::max();
-  dist_to_[s] = 0.0;
-
-  // visit vertices in topological order
-  Topological topological(G);
-  if (!topological.HasOrder())
-    throw std::invalid_argument("Digraph is not acyclic.");
-  for (int v : topological.order()) {
-    for (DirectedEdge* e : G.Adj(v))
-      Relax(e);
-  }
-}
-
-void AcyclicSP::Relax(DirectedEdge* e) {
-  int v = e->from(), w = e->to();
-  if (dist_to_[w] > dist_to_[v] + e->weight()) {
-    dist_to_[w] = dist_to_[v] + e->weight();
-    edge_to_[w] = e;
-  }
-}
-
-bool AcyclicSP::HasPathTo(int v) const {
-  ValidateVertex(v);
-  return dist_to_[v] < numeric_limits<double>::max();
-}
-
-stack<DirectedEdge *> AcyclicSP::PathTo(int v) {
-  ValidateVertex(v);
-  stack<DirectedEdge *> path;
-  if (HasPathTo(v)) {
-    for (DirectedEdge* e = edge_to_[v]; e; e = edge_to_[e->from()])
-      path.push(e);
-  }
-
-  return path;
-}
-
-void AcyclicSP::ValidateVertex(int v) const {
-  int V = dist_to_.size();
-  if (v < 0 || v >= V)
-    throw std::invalid_argument("vertex " + to_string(v) + 
-                                " is not between 0 and " + to_string(V-1));
-}
-}
 
 /**
  * Unit tests the {@code AcyclicSP} data type.
@@ -106,9 +50,9 @@ int main(int argc, char *argv[]) {
   for (int v = 0; v < G.V(); v++) {
     if (sp.HasPathTo(v)) {
       cout << s << " to " << v << " ( << " << sp.dist_to(v) << ")  ";
-      stack<DirectedEdge *> data = sp.PathTo(v);
+      stack<DirectedEdge> data = sp.PathTo(v);
       while (!data.empty()) {
-        cout << data.top()->ToString() << "   ";
+        cout << data.top().ToString() << "   ";
         data.pop();
       }
       cout << endl;
@@ -3,8 +3,13 @@
 
 #include <vector>
 #include <stack>
+#include <limits>
+#include <stdexcept>
+#include <string>
 
-#include "edge_weighted_digraph.h"
+#include "directed_edge.h"
+#include "graph_concepts.h"
+#include "topological_sort.h"
 
 /**
  *  The {@code AcyclicSP} class represents a data type for solving the
@@ -19,6 +24,9 @@
  *  It uses &Theta;(<em>V</em>) extra space (not including the
  *  edge-weighted digraph).
  *  <p>
+ *  The class is a template over the representation of the digraph: any
+ *  {@code WeightedDigraph}, with the argument deduced from the constructor.
+ *  <p>
  *  This correctly computes shortest paths if all arithmetic performed is
  *  without floating-point rounding error or arithmetic overflow.
  *  This is the case if all edge weights are integers and if none of the
@@ -36,19 +44,33 @@
  */
 namespace algs4 {
 
-class DirectedEdge;
-
+template <WeightedDigraph Graph>
 class AcyclicSP {
 public:
   /**
    * Computes a shortest paths tree from {@code s} to every other vertex in
    * the directed acyclic graph {@code G}.
+   * {@code G} must outlive this object, since {@code PathTo} reads its edges.
    * @param G the acyclic digraph
    * @param s the source vertex
    * @throws IllegalArgumentException if the digraph is not acyclic
    * @throws IllegalArgumentException unless {@code 0 <= s < V}
    */
-  AcyclicSP(const EdgeWeightedDigraph& G, int s);
+  AcyclicSP(const Graph& G, int s) :
+    dist_to_(G.V(), std::numeric_limits<double>::max()), edge_to_(G.V(), -1), graph_(&G) {
+    ValidateVertex(s);
+
+    dist_to_[s] = 0.0;
+
+    // visit vertices in topological order
+    Topological topological(G);
+    if (!topological.HasOrder())
+      throw std::invalid_argument("Digraph is not acyclic.");
+    for (int v : topological.order()) {
+      for (int e : G.Adj(v))
+        Relax(G, e);
+    }
+  }
   AcyclicSP() = delete;
   AcyclicSP(const AcyclicSP& other) = delete;
   AcyclicSP &operator=(const AcyclicSP& other) = delete;
@@ -74,7 +96,10 @@ public:
    *         {@code s} to vertex {@code v}, and {@code false} otherwise
    * @throws IllegalArgumentException unless {@code 0 <= v < V}
    */
-  bool HasPathTo(int v) const;
+  bool HasPathTo(int v) const {
+    ValidateVertex(v);
+    return dist_to_[v] < std::numeric_limits<double>::max();
+  }
 
   /**
    * Returns a shortest path from the source vertex {@code s} to vertex {@code v}.
@@ -83,17 +108,38 @@ public:
    *         as an iterable of edges, and {@code null} if no such path
    * @throws IllegalArgumentException unless {@code 0 <= v < V}
    */
-  std::stack<DirectedEdge *> PathTo(int v);
+  std::stack<DirectedEdge> PathTo(int v) {
+    ValidateVertex(v);
+    std::stack<DirectedEdge> path;
+    if (HasPathTo(v)) {
+      for (int e = edge_to_[v]; e != -1; e = edge_to_[graph_->from(e)])
+        path.push(DirectedEdgeOf(*graph_, e));
+    }
+
+    return path;
+  }
 private:
   // relax edge e
-  void Relax(DirectedEdge* e);
+  void Relax(const Graph& G, int e) {
+    int v = G.from(e), w = G.to(e);
+    if (dist_to_[w] > dist_to_[v] + G.weight(e)) {
+      dist_to_[w] = dist_to_[v] + G.weight(e);
+      edge_to_[w] = e;
+    }
+  }
 
   // throw an IllegalArgumentException unless {@code 0 <= v < V}
-  void ValidateVertex(int v) const;
+  void ValidateVertex(int v) const {
+    int V = dist_to_.size();
+    if (v < 0 || v >= V)
+      throw std::invalid_argument("vertex " + std::to_string(v) +
+                                  " is not between 0 and " + std::to_string(V-1));
+  }
 
 private:
   std::vector<double> dist_to_;         // dist_to_[v] = distance  of shortest s->v path
-  std::vector<DirectedEdge *> edge_to_;   // edge_to_[v] = last edge on shortest s->v path
+  std::vector<int> edge_to_;            // edge_to_[v] = id of last edge on shortest s->v path, or -1
+  const Graph* graph_;                  // the digraph, which must outlive this object
 };
 }
 
@@ -1,12 +1,11 @@
 /******************************************************************************
- *  Compilation:  clang++ -c -O2 directed_edge.cc -std=c++11
- *                clang++ -c -O2 edge_weighted_digraph.cc -std=c++11
- *                clang++ -c -O2 edge_weighted_directed_cycle.cc -std=c++11
- *                clang++ -c -O2 bellman_ford_sp.cc -std=c++11
- *                clang++ -O2 -DDebug arbitrage.cc bellman_ford_sp.o edge_weighted_directed_cycle.o edge_weighted_digraph.o directed_edge.o -std=c++11 -o arbitrage
+ *  Compilation:  clang++ -c -O2 directed_edge.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_digraph.cc -std=c++20
+ *                clang++ -c -O2 bellman_ford_sp.cc -std=c++20
+ *                clang++ -O2 -DDebug arbitrage.cc bellman_ford_sp.o edge_weighted_digraph.o directed_edge.o -std=c++20 -o arbitrage
  *  Execution:    arbitrage input.txt
  *  Dependencies: edge_weighted_digraph.h directed_edge.h
- *                bellman_ford_sp.h edge_weighted_directed_cycle.h
+ *                bellman_ford_sp.h
  *  Data file:    https://algs4.cs.princeton.edu/44sp/rates.txt
  *
  *  Arbitrage detection.
@@ -91,21 +90,20 @@ int main(int argc, char *argv[]) {
 	for (int w = 0; w < V; w++) {
 	  char* end;
 	  double rate = std::strtod(str, &end);
-	  DirectedEdge* e = new DirectedEdge(v, w, -std::log(rate));
-	  G.addEdge(e);
+	  G.AddEdge(v, w, -std::log(rate));
 	  str = end;
 	}
   }
 
   // find negative cycle
   BellmanFordSP spt(G, 0);
-  if (spt.hasNegativeCycle()) {
+  if (spt.HasNegativeCycle()) {
 	double stake = 1000.0;
-	stack<DirectedEdge *> edges(spt.negativeCycle());
+	stack<DirectedEdge> edges(spt.NegativeCycle());
 	while (!edges.empty()) {
-	  printf("%10.5f %s ", stake, name[edges.top()->from()].c_str());
-	  stake *= std::exp(-edges.top()->weight());
-	  printf("= %10.5f %s\n", stake, name[edges.top()->to()].c_str());
+	  printf("%10.5f %s ", stake, name[edges.top().from()].c_str());
+	  stake *= std::exp(-edges.top().weight());
+	  printf("= %10.5f %s\n", stake, name[edges.top().to()].c_str());
 	  edges.pop();
 	}
   } else {
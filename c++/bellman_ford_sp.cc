@@ -1,11 +1,9 @@
 /******************************************************************************
- *  Compilation:  clang++ -c -O2 directed_edge.cc -std=c++11
- *                clang++ -c -O2 edge_weighted_digraph.cc -std=c++11
- *                clang++ -c -O2 edge_weighted_directed_cycle.cc -std=c++11
- *                clang++ -O2 -DDebug bellman_ford_sp.cc edge_weighted_directed_cycle.o edge_weighted_digraph.o directed_edge.o -std=c++11 -o bellman_ford_sp
+ *  Compilation:  clang++ -c -O2 directed_edge.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_digraph.cc -std=c++20
+ *                clang++ -O2 -DDebug bellman_ford_sp.cc edge_weighted_digraph.o directed_edge.o -std=c++20 -o bellman_ford_sp
  *  Execution:    bellman_ford_sp filename.txt s
- *  Dependencies: edge_weighted_digraph.h directed_edge.h
- *                edge_weighted_directed_cycle.h
+ *  Dependencies: edge_weighted_digraph.h directed_edge.h search_workspace.h
  *  Data files:   https://algs4.cs.princeton.edu/44sp/tinyEWDn.txt
  *                https://algs4.cs.princeton.edu/44sp/mediumEWDnc.txt
  *
@@ -46,6 +44,9 @@
  *  {@code hasNegativeCycle} takes constant time;
  *  each call to {@code pathTo(int)} and {@code negativeCycle()}
  *  takes time proportional to length of the path returned.
+ *  The negative cycle is sought among the edges of the shortest-paths tree
+ *  built so far, each of the vertices reached having one edge in, so each
+ *  check takes time proportional to the vertices reached.
  *  <p>
  *  For additional documentation,    
  *  see <a href="https://algs4.cs.princeton.edu/44sp">Section 4.4</a> of    
@@ -65,176 +66,14 @@
 
 #include "bellman_ford_sp.h"
 
-#include <cassert>
 #include <cstdio>
-#include <algorithm>
-#include <exception>
 
 #include "directed_edge.h"
-#include "edge_weighted_directed_cycle.h"
+#include "edge_weighted_digraph.h"
 
 using std::vector;
-using std::queue;
 using std::stack;
 
-namespace algs4 {
-BellmanFordSP::BellmanFordSP(const EdgeWeightedDigraph& G, int s) {
-  dist_to_.resize(G.V());
-  edge_to_.resize(G.V());
-  on_queue_.resize(G.V());
-  for (int v = 0; v < G.V(); v++)
-	dist_to_[v] = std::numeric_limits<double>::max();
-  dist_to_[s] = 0.0;
-
-  // Bellman-Ford algorithm
-  queue_.push(s);
-  on_queue_[s] = true;
-  while (!queue_.empty() && !HasNegativeCycle()) {
-	int v = queue_.front();
-	queue_.pop();
-	on_queue_[v] = false;
-	Relax(G, v);
-  }
-
-  assert(Check(G, s));
-}
-
-// relax vertex v and put other endpoints on queue if changed
-void BellmanFordSP::Relax(const EdgeWeightedDigraph& G, int v) {
-  for (DirectedEdge* e : G.Adj(v)) {
-	int w = e->to();
-	if (dist_to_[w] > dist_to_[v] + e->weight()) {
-	  dist_to_[w] = dist_to_[v] + e->weight();
-	  edge_to_[w] = e;
-	  if (!on_queue_[w]) {
-		queue_.push(w);
-		on_queue_[w] = true;
-	  }
-	}
-	if (cost_++ % G.V() == 0) {
-	  FindNegativeCycle();
-	  if (HasNegativeCycle()) return;  // found a negative cycle
-	}
-  }
-}
-
-  // by finding a cycle in predecessor graph
-void BellmanFordSP::FindNegativeCycle() {
-  int V = edge_to_.size();
-  EdgeWeightedDigraph spt(V);
-  for (int v = 0; v < V; v++)
-	if (edge_to_[v] != nullptr) spt.AddEdge(edge_to_[v]);
-
-  EdgeWeightedDirectedCycle finder(spt);
-  cycle_ = finder.cycle();
-}
-
-/**
- * Returns the length of a shortest path from the source vertex {@code s} to vertex {@code v}.
- * @param  v the destination vertex
- * @return the length of a shortest path from the source vertex {@code s} to vertex {@code v};
- *         {@code Double.POSITIVE_INFINITY} if no such path
- * @throws UnsupportedOperationException if there is a negative cost cycle reachable
- *         from the source vertex {@code s}
- * @throws IllegalArgumentException unless {@code 0 <= v < V}
- */
-double BellmanFordSP::distTo(int v) const {
-  ValidateVertex(v);
-  if (HasNegativeCycle())
-	throw "Negative cost cycle exists";
-  return dist_to_[v];
-}
-
-/**
- * Returns a shortest path from the source {@code s} to vertex {@code v}.
- * @param  v the destination vertex
- * @return a shortest path from the source {@code s} to vertex {@code v}
- *         as an iterable of edges, and {@code null} if no such path
- * @throws UnsupportedOperationException if there is a negative cost cycle reachable
- *         from the source vertex {@code s}
- * @throws IllegalArgumentException unless {@code 0 <= v < V}
- */
-vector<DirectedEdge *> BellmanFordSP::PathTo(int v) const {
-  ValidateVertex(v);
-  if (HasNegativeCycle())
-	throw "Negative cost cycle exists";
-  if (!HasPathTo(v)) return {};
-  vector<DirectedEdge *> path;
-  for (DirectedEdge* e = edge_to_[v]; e != nullptr; e = edge_to_[e->from()])
-	path.push_back(e);
-  std::reverse(path.begin(), path.end());
-
-  return path;
-}
-
-// check optimality conditions: either 
-// (i) there exists a negative cycle reacheable from s
-//     or 
-// (ii)  for all edges e = v->w:            distTo[w] <= distTo[v] + e.weight()
-// (ii') for all edges e = v->w on the SPT: distTo[w] == distTo[v] + e.weight()
-bool BellmanFordSP::Check(const EdgeWeightedDigraph& G, int s) {
-  // has a negative cycle
-  if (HasNegativeCycle()) {
-	double weight = 0.0;
-	stack<DirectedEdge *> edges(NegativeCycle());
-	while (!edges.empty()) {
-	  weight += edges.top()->weight();
-	  edges.pop();
-	}
-	if (weight >= 0.0) {
-	  printf("error: weight of negative cycle = %lf\n", weight);
-	  return false;
-	}
-  } else { // no negative cycle reachable from source
-	// check that distTo[v] and edgeTo[v] are consistent
-	if (dist_to_[s] != 0.0 || edge_to_[s] != nullptr) {
-	  printf("distanceTo[s] and edgeTo[s] inconsistent\n");
-	  return false;
-	}
-	for (int v = 0; v < G.V(); v++) {
-	  if (v == s) continue;
-	  if (edge_to_[v] == nullptr && dist_to_[v] != std::numeric_limits<double>::max()) {
-		printf("distTo[] and edgeTo[] inconsistent\n");
-		return false;
-	  }
-	}
-
-	// check that all edges e = v->w satisfy distTo[w] <= distTo[v] + e.weight()
-	for (int v = 0; v < G.V(); v++) {
-	  for (DirectedEdge* e : G.Adj(v)) {
-		int w = e->to();
-		if (dist_to_[v] + e->weight() < dist_to_[w]) {
-		  printf("edge %s not relaxed\n", e->ToString().c_str());
-		  return false;
-		}
-	  }
-	}
-
-	// check that all edges e = v->w on SPT satisfy distTo[w] == distTo[v] + e.weight()
-	for (int w = 0; w < G.V(); w++) {
-	  if (edge_to_[w] == nullptr) continue;
-	  DirectedEdge* e = edge_to_[w];
-	  int v = e->from();
-	  if (w != e->to()) return false;
-	  if (dist_to_[v] + e->weight() != dist_to_[w]) {
-		printf("edge %s on shortest path not tight\n", e->ToString().c_str());
-		return false;
-	  }
-	}
-  }
-
-  printf("Satisfies optimality conditions\n\n");
-  return true;
-}
-
-// throw an IllegalArgumentException unless {@code 0 <= v < V}
-void BellmanFordSP::ValidateVertex(int v) const {
-  int V = dist_to_.size();
-  if (v < 0 || v >= V)
-	throw std::invalid_argument("vertex " + std::to_string(v) + " is not between 0 and " + std::to_string(V-1));
-}
-}
-
 /**
  * Unit tests the {@code BellmanFordSP} data type.
  *
@@ -256,17 +95,17 @@ int main(int args, char *argv[]) {
 
   // print negative cycle
   if (sp.HasNegativeCycle()) {
-	stack<DirectedEdge *> edges(sp.NegativeCycle());
+	stack<DirectedEdge> edges(sp.NegativeCycle());
 	while (!edges.empty()) {
-	  printf("%s\n", edges.top()->ToString().c_str());
+	  printf("%s\n", edges.top().ToString().c_str());
 	  edges.pop();
 	}
   } else { // print shortest paths
 	for (int v = 0; v < G.V(); v++) {
 	  if (sp.HasPathTo(v)) {
 		printf("%d to %d (%5.2f)  ", s, v, sp.distTo(v));
-		for (DirectedEdge* e : sp.PathTo(v)) {
-		  printf("%s   ", e->ToString().c_str());
+		for (const DirectedEdge& e : sp.PathTo(v)) {
+		  printf("%s   ", e.ToString().c_str());
 		}
 		printf("\n");
 	  } else {
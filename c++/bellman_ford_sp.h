@@ -14,6 +14,15 @@
  *  {@code hasNegativeCycle} takes constant time;
  *  each call to {@code pathTo(int)} and {@code negativeCycle()}
  *  takes time proportional to length of the path returned.
+ *  The negative cycle is sought among the edges of the shortest-paths tree
+ *  built so far, each of the vertices reached having one edge in, so each
+ *  check takes time proportional to the vertices reached. A search that
+ *  borrows a {@link SearchWorkspace} keeps its distances, paths and queue
+ *  marks there, and so takes time proportional to the vertices and edges it
+ *  reaches, times the number of passes.
+ *  <p>
+ *  The class is a template over the representation of the digraph: any
+ *  {@code WeightedDigraph}, with the argument deduced from the constructor.
  *  <p>
  *  For additional documentation,    
  *  see <a href="https://algs4.cs.princeton.edu/44sp">Section 4.4</a> of    
@@ -30,23 +39,51 @@
 #include <queue>
 #include <stack>
 #include <limits>
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
 
+#include "directed_edge.h"
 #include "edge_weighted_digraph.h"
+#include "graph_concepts.h"
+#include "search_workspace.h"
 
 namespace algs4 {
 
-class DirectedEdge;
-
+template <WeightedDigraph Graph>
 class BellmanFordSP {
  public:
   /**
    * Computes a shortest paths tree from {@code s} to every other vertex in
    * the edge-weighted digraph {@code G}.
+   * {@code G} must outlive this object, since {@code PathTo} reads its edges.
+   * @param G the acyclic digraph
+   * @param s the source vertex
+   * @throws IllegalArgumentException unless {@code 0 <= s < V}
+   */
+  BellmanFordSP(const Graph& G, int s) : cost_(0), graph_(&G) {
+    Search(G, s, own_);
+
+    assert(Check(G, s));
+  }
+  /**
+   * Computes a shortest paths tree from {@code s} to every other vertex in
+   * the edge-weighted digraph {@code G}, keeping the distances and paths in
+   * {@code workspace}: the search takes time proportional to the vertices
+   * and edges it reaches, times the number of passes. The paths are valid
+   * until {@code workspace} is used by another search.
+   * {@code G} must outlive this object, since {@code PathTo} reads its edges.
    * @param G the acyclic digraph
    * @param s the source vertex
+   * @param workspace the workspace, which must outlive this object
    * @throws IllegalArgumentException unless {@code 0 <= s < V}
    */
-  BellmanFordSP(const EdgeWeightedDigraph& G, int s);
+  BellmanFordSP(const Graph& G, int s, SearchWorkspace& workspace) :
+    workspace_(&workspace), cost_(0), graph_(&G) {
+    Search(G, s, workspace);
+  }
   BellmanFordSP() = delete;
   BellmanFordSP(const BellmanFordSP& other) = delete;
   BellmanFordSP &operator=(const BellmanFordSP& other) = delete;
@@ -64,7 +101,7 @@ class BellmanFordSP {
    * @return a negative cycle reachable from the soruce vertex {@code s} 
    *    as an iterable of edges, and {@code null} if there is no such cycle
    */
-  std::stack<DirectedEdge *> NegativeCycle() const { return cycle_; }
+  std::stack<DirectedEdge> NegativeCycle() const { return cycle_; }
   /**
    * Returns the length of a shortest path from the source vertex {@code s} to vertex {@code v}.
    * @param  v the destination vertex
@@ -74,7 +111,12 @@ class BellmanFordSP {
    *         from the source vertex {@code s}
    * @throws IllegalArgumentException unless {@code 0 <= v < V}
    */
-  double distTo(int v) const;
+  double distTo(int v) const {
+    ValidateVertex(v);
+    if (HasNegativeCycle())
+      throw "Negative cost cycle exists";
+    return workspace().distTo[v];
+  }
   /**
    * Is there a path from the source {@code s} to vertex {@code v}?
    * @param  v the destination vertex
@@ -84,7 +126,7 @@ class BellmanFordSP {
    */
   bool HasPathTo(int v) const { 
 	ValidateVertex(v); 
-	return dist_to_[v] < std::numeric_limits<double>::max(); 
+	return workspace().distTo[v] < std::numeric_limits<double>::max(); 
   }
   /**
    * Returns a shortest path from the source {@code s} to vertex {@code v}.
@@ -95,29 +137,168 @@ class BellmanFordSP {
    *         from the source vertex {@code s}
    * @throws IllegalArgumentException unless {@code 0 <= v < V}
    */
-  std::vector<DirectedEdge *> PathTo(int v) const;
+  std::vector<DirectedEdge> PathTo(int v) const {
+    ValidateVertex(v);
+    if (HasNegativeCycle())
+      throw "Negative cost cycle exists";
+    if (!HasPathTo(v)) return {};
+    std::vector<DirectedEdge> path;
+    const EpochArray<int>& edge_to = workspace().edgeTo;
+    for (int e = edge_to[v]; e != -1; e = edge_to[graph_->from(e)])
+      path.push_back(DirectedEdgeOf(*graph_, e));
+    std::reverse(path.begin(), path.end());
+
+    return path;
+  }
 
  private:
-  // relax vertex v and put other endpoints on queue if changed
-  void Relax(const EdgeWeightedDigraph& G, int v);
-  // by finding a cycle in predecessor graph
-  void FindNegativeCycle();
+  // Bellman-Ford algorithm
+  void Search(const Graph& G, int s, SearchWorkspace& workspace) {
+    workspace.distTo.Reset(G.V());
+    workspace.edgeTo.Reset(G.V());
+    workspace.marked.Reset(G.V());
+    workspace.distTo.Set(s, 0.0);
+
+    queue_.push(s);
+    workspace.marked.Mark(s);
+    while (!queue_.empty() && !HasNegativeCycle()) {
+      int v = queue_.front();
+      queue_.pop();
+      workspace.marked.Unmark(v);
+      Relax(G, v, workspace);
+    }
+  }
+  // relax vertex v and put other endpoints on queue if changed;
+  // workspace.marked[w] = is w currently on the queue?
+  void Relax(const Graph& G, int v, SearchWorkspace& workspace) {
+    EpochArray<double>& dist_to = workspace.distTo;
+    for (int e : G.Adj(v)) {
+      int w = G.to(e);
+      if (dist_to[w] > dist_to[v] + G.weight(e)) {
+        if (workspace.edgeTo[w] == -1) reached_.push_back(w);
+        dist_to.Set(w, dist_to[v] + G.weight(e));
+        workspace.edgeTo.Set(w, e);
+        if (!workspace.marked[w]) {
+          queue_.push(w);
+          workspace.marked.Mark(w);
+        }
+      }
+      if (++cost_ % G.V() == 0) {
+        FindNegativeCycle(G, workspace);
+        if (HasNegativeCycle()) return;  // found a negative cycle
+      }
+    }
+  }
+  // by finding a cycle in predecessor graph: each vertex has at most one
+  // edge in, its edgeTo, so walking the edges in backwards from a vertex
+  // either stops at a root or runs into a cycle. Of the cycles, the one
+  // returned is the one through the least vertex w, starting at w: the
+  // cycle a depth-first search of the predecessor graph finds first
+  void FindNegativeCycle(const Graph& G, SearchWorkspace& workspace) {
+    const EpochArray<int>& edge_to = workspace.edgeTo;
+    EpochArray<int>& walk = workspace.label;   // walk[v] = the vertex whose walk reached v
+    walk.Reset(G.V());
+    int least = -1;
+    for (int u : reached_) {
+      int x = u;
+      while (walk[x] == -1 && edge_to[x] != -1) {
+        walk.Set(x, u);
+        x = G.from(edge_to[x]);
+      }
+      if (walk[x] != u) continue;
+      // x is on a cycle that no earlier walk ran into
+      int y = x;
+      do {
+        if (least == -1 || y < least) least = y;
+        y = G.from(edge_to[y]);
+      } while (y != x);
+    }
+    if (least == -1) return;
+
+    for (int f = edge_to[least]; ; f = edge_to[G.from(f)]) {
+      cycle_.push(DirectedEdgeOf(G, f));
+      if (G.from(f) == least) break;
+    }
+  }
   // check optimality conditions: either 
   // (i) there exists a negative cycle reacheable from s
   //     or 
   // (ii)  for all edges e = v->w:            distTo[w] <= distTo[v] + e.weight()
   // (ii') for all edges e = v->w on the SPT: distTo[w] == distTo[v] + e.weight()
-  bool Check(const EdgeWeightedDigraph& G, int s);
+  bool Check(const Graph& G, int s) {
+    const EpochArray<double>& dist_to = workspace().distTo;
+    const EpochArray<int>& edge_to = workspace().edgeTo;
+    // has a negative cycle
+    if (HasNegativeCycle()) {
+      double weight = 0.0;
+      std::stack<DirectedEdge> edges(NegativeCycle());
+      while (!edges.empty()) {
+        weight += edges.top().weight();
+        edges.pop();
+      }
+      if (weight >= 0.0) {
+        printf("error: weight of negative cycle = %lf\n", weight);
+        return false;
+      }
+    } else { // no negative cycle reachable from source
+      // check that distTo[v] and edgeTo[v] are consistent
+      if (dist_to[s] != 0.0 || edge_to[s] != -1) {
+        printf("distanceTo[s] and edgeTo[s] inconsistent\n");
+        return false;
+      }
+      for (int v = 0; v < G.V(); v++) {
+        if (v == s) continue;
+        if (edge_to[v] == -1 && dist_to[v] != std::numeric_limits<double>::max()) {
+          printf("distTo[] and edgeTo[] inconsistent\n");
+          return false;
+        }
+      }
+
+      // check that all edges e = v->w satisfy distTo[w] <= distTo[v] + e.weight()
+      for (int v = 0; v < G.V(); v++) {
+        for (int e : G.Adj(v)) {
+          int w = G.to(e);
+          if (dist_to[v] + G.weight(e) < dist_to[w]) {
+            printf("edge %s not relaxed\n", DirectedEdgeOf(G, e).ToString().c_str());
+            return false;
+          }
+        }
+      }
+
+      // check that all edges e = v->w on SPT satisfy distTo[w] == distTo[v] + e.weight()
+      for (int w = 0; w < G.V(); w++) {
+        if (edge_to[w] == -1) continue;
+        int e = edge_to[w];
+        int v = G.from(e);
+        if (w != G.to(e)) return false;
+        if (dist_to[v] + G.weight(e) != dist_to[w]) {
+          printf("edge %s on shortest path not tight\n", DirectedEdgeOf(G, e).ToString().c_str());
+          return false;
+        }
+      }
+    }
+
+    printf("Satisfies optimality conditions\n\n");
+    return true;
+  }
+  const SearchWorkspace& workspace() const { return workspace_ ? *workspace_ : own_; }
   // throw an IllegalArgumentException unless {@code 0 <= v < V}
-  void ValidateVertex(int v) const;
+  void ValidateVertex(int v) const {
+    int V = graph_->V();
+    if (v < 0 || v >= V)
+      throw std::invalid_argument("vertex " + std::to_string(v) + " is not between 0 and " + std::to_string(V-1));
+  }
 
  private:
-  std::vector<double> dist_to_;               // distTo[v] = distance  of shortest s->v path
-  std::vector<DirectedEdge *> edge_to_;         // edgeTo[v] = last edge on shortest s->v path
-  std::vector<bool> on_queue_;             // onQueue[v] = is v currently on the queue?
+  SearchWorkspace own_;                // own_.distTo[v] = distance  of shortest s->v path
+                                       // own_.edgeTo[v] = id of last edge on shortest s->v path, or -1
+                                       // own_.marked[v] = is v currently on the queue?
+  SearchWorkspace* workspace_{nullptr};  // the borrowed workspace, if any, instead of own_
+  std::vector<int> reached_;       // vertices with an edgeTo, in order reached
   std::queue<int> queue_;          // queue of vertices to relax
   int cost_;                      // number of calls to relax()
-  std::stack<DirectedEdge *> cycle_;  // negative cycle (or null if no such cycle)
+  std::stack<DirectedEdge> cycle_;    // negative cycle (or null if no such cycle)
+  const Graph* graph_;                // the digraph, which must outlive this object
 };
 }
 
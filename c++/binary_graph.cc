@@ -0,0 +1,551 @@
+/******************************************************************************
+ *  Compilation:  clang++ -c -O2 digraph.cc -std=c++20
+ *                clang++ -c -O2 compact_digraph.cc -std=c++20
+ *                clang++ -c -O2 directed_edge.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_digraph.cc -std=c++20
+ *                clang++ -c -O2 edge.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_graph.cc -std=c++20
+ *                clang++ -c -O2 symbol_digraph.cc -std=c++20
+ *                clang++ -c -O2 mapped_file.cc -std=c++20
+ *                clang++ -DDebug -O2 binary_graph.cc digraph.o compact_digraph.o directed_edge.o edge_weighted_digraph.o edge.o edge_weighted_graph.o symbol_digraph.o mapped_file.o -std=c++20 -pthread -o binary_graph
+ *  Execution:    ./binary_graph filename.bin [name ...]
+ *  Dependencies: compact_digraph.cc edge_weighted_digraph.cc edge_weighted_graph.cc
+ *                symbol_digraph.cc mapped_file.cc
+ *
+ *  A graph in the binary graph container format, opened by memory-mapping
+ *  the file. Create a container with graph_converter. Looks up the vertex
+ *  of each name given after the file name.
+ *
+ *  % ./graph_converter symbol routes.txt routes.bin " "
+ *  % ./binary_graph routes.bin
+ *  10 vertices, 18 edges, names
+ *  JFK: MCO ATL ORD
+ *  MCO:
+ *  ORD: DEN HOU DFW PHX ATL
+ *  ...
+ *
+ *  % ./binary_graph routes.bin ORD SFO
+ *  10 vertices, 18 edges, names
+ *  ORD: 2
+ *  SFO: not a vertex
+ *
+ ******************************************************************************/
+
+#include "binary_graph.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include "compact_digraph.h"
+#include "digraph.h"
+#include "edge.h"
+#include "edge_weighted_digraph.h"
+#include "edge_weighted_graph.h"
+#include "symbol_digraph.h"
+
+using std::span;
+using std::string;
+using std::string_view;
+using std::vector;
+
+namespace algs4 {
+namespace {
+
+constexpr char kMagic[8] = { 'A', 'L', 'G', 'S', '4', 'B', 'G', '\n' };
+// written as is; reads back differently on a machine of the other byte order
+constexpr uint32_t kByteOrder = 0x01020304;
+
+// the fixed-size header at the start of every container; section
+// positions are byte offsets from the start of the file, 0 if absent
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t flags;
+  uint32_t byte_order;
+  uint32_t reserved;
+  int64_t V;
+  int64_t E;
+  uint64_t offsets;              // V + 1 int32 row offsets
+  uint64_t targets;              // E int32 head vertices
+  uint64_t weights;              // E doubles, parallel to targets
+  uint64_t name_offsets;         // V + 1 uint64 offsets into the name data
+  uint64_t name_data;            // concatenated vertex names
+  uint64_t name_bytes;           // length of the name data
+  uint64_t name_index;           // name_slots int32 vertex ids, -1 for an empty slot
+  uint64_t name_slots;           // a power of 2 greater than V; absent in version 1
+};
+
+// the size of the header of a version 1 container, which ends before name_index
+constexpr size_t kVersion1HeaderSize = offsetof(Header, name_index);
+
+// a hash of a vertex name that does not depend on the machine or the
+// library, since the index is stored in the file: FNV-1a, then the
+// SplitMix64 finalizer so that the low bits used for the slot are mixed
+uint64_t NameHash(string_view s) {
+  uint64_t h = 0xcbf29ce484222325;
+  for (unsigned char c : s) {
+    h ^= c;
+    h *= 0x100000001b3;
+  }
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111eb;
+  return h ^ (h >> 31);
+}
+
+uint64_t Align8(uint64_t n) { return (n + 7) & ~uint64_t(7); }
+
+// the view of {@code count} elements of type T at byte {@code pos} of the file
+template <typename T>
+span<const T> Section(const MappedFile& file, uint64_t pos, uint64_t count) {
+  if (pos % alignof(T) != 0 || pos > file.size() ||
+      count > (file.size() - pos) / sizeof(T))
+    throw std::invalid_argument("binary graph section does not fit in the file");
+  return { reinterpret_cast<const T*>(file.data() + pos), count };
+}
+
+// everything that goes into a container
+struct Contents {
+  int V;
+  uint32_t flags;
+  span<const int> offsets;
+  span<const int> targets;
+  span<const double> weights;
+  span<const string_view> names;
+};
+
+void Write(const string& filename, const Contents& c) {
+  Header header {};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = BinaryGraph::kVersion;
+  header.flags = c.flags;
+  header.byte_order = kByteOrder;
+  header.V = c.V;
+  header.E = c.targets.size();
+
+  // lay out the sections one after the other, each 8-byte aligned
+  uint64_t pos = Align8(sizeof(Header));
+  auto place = [&pos](uint64_t bytes) {
+    uint64_t at = pos;
+    pos = Align8(pos + bytes);
+    return at;
+  };
+  vector<uint64_t> name_offsets;
+  vector<int> name_index;
+  if (c.flags & BinaryGraph::kNamed) {
+    name_offsets.push_back(0);
+    for (string_view name : c.names)
+      name_offsets.push_back(name_offsets.back() + name.size());
+  }
+  if (c.flags & BinaryGraph::kIndexed) {
+    // linear probing in a power-of-2 table at most half full
+    uint64_t slots = 1;
+    while (slots < 2 * c.names.size()) slots *= 2;
+    name_index.assign(slots, -1);
+    for (size_t v = 0; v < c.names.size(); v++) {
+      uint64_t i = NameHash(c.names[v]) & (slots - 1);
+      while (name_index[i] >= 0) i = (i + 1) & (slots - 1);
+      name_index[i] = v;
+    }
+    header.name_slots = slots;
+  }
+  header.offsets = place(c.offsets.size() * sizeof(int));
+  header.targets = place(c.targets.size() * sizeof(int));
+  if (c.flags & BinaryGraph::kWeighted)
+    header.weights = place(c.weights.size() * sizeof(double));
+  if (c.flags & BinaryGraph::kNamed) {
+    header.name_offsets = place(name_offsets.size() * sizeof(uint64_t));
+    header.name_bytes = name_offsets.back();
+    header.name_data = place(header.name_bytes);
+  }
+  if (c.flags & BinaryGraph::kIndexed)
+    header.name_index = place(name_index.size() * sizeof(int));
+
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  if (!out) throw std::runtime_error("failed to create " + filename);
+  uint64_t written = 0;
+  auto put = [&](uint64_t at, const void* data, uint64_t bytes) {
+    static const char zeros[8] = {};
+    out.write(zeros, at - written);
+    out.write(static_cast<const char*>(data), bytes);
+    written = at + bytes;
+  };
+  put(0, &header, sizeof(header));
+  put(header.offsets, c.offsets.data(), c.offsets.size() * sizeof(int));
+  put(header.targets, c.targets.data(), c.targets.size() * sizeof(int));
+  if (c.flags & BinaryGraph::kWeighted)
+    put(header.weights, c.weights.data(), c.weights.size() * sizeof(double));
+  if (c.flags & BinaryGraph::kNamed) {
+    put(header.name_offsets, name_offsets.data(), name_offsets.size() * sizeof(uint64_t));
+    put(header.name_data, nullptr, 0);
+    for (string_view name : c.names) {
+      out.write(name.data(), name.size());
+      written += name.size();
+    }
+  }
+  if (c.flags & BinaryGraph::kIndexed)
+    put(header.name_index, name_index.data(), name_index.size() * sizeof(int));
+  out.flush();
+  if (!out) throw std::runtime_error("failed to write " + filename);
+}
+}
+
+/**
+ * Opens the binary graph container {@code filename}.
+ *
+ * @param  filename the name of the file
+ * @throws std::runtime_error if the file cannot be read
+ * @throws IllegalArgumentException if the file is not a binary graph container
+ *         of a supported version and this byte order, or its sections do not
+ *         fit in the file
+ */
+BinaryGraph::BinaryGraph(const string& filename) : file_(filename) {
+  if (file_.size() < kVersion1HeaderSize)
+    throw std::invalid_argument(filename + " is not a binary graph");
+  Header header {};
+  std::memcpy(&header, file_.data(), kVersion1HeaderSize);
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0)
+    throw std::invalid_argument(filename + " is not a binary graph");
+  if (header.byte_order != kByteOrder)
+    throw std::invalid_argument(filename + " was written on a machine of another byte order");
+  if (header.version < 1 || header.version > kVersion)
+    throw std::invalid_argument(filename + " has unsupported version " +
+                                std::to_string(header.version));
+  if (header.version >= 2) {
+    if (file_.size() < sizeof(Header))
+      throw std::invalid_argument(filename + " is not a binary graph");
+    std::memcpy(&header, file_.data(), sizeof(header));
+  } else {
+    header.flags &= ~kIndexed;
+  }
+  if (header.V < 0 || header.V >= INT32_MAX || header.E < 0 || header.E > INT32_MAX)
+    throw std::invalid_argument(filename + " has an invalid number of vertices or edges");
+
+  v_ = header.V;
+  flags_ = header.flags;
+  offsets_ = Section<int>(file_, header.offsets, header.V + 1);
+  targets_ = Section<int>(file_, header.targets, header.E);
+  if (offsets_[0] != 0 || offsets_[v_] != header.E)
+    throw std::invalid_argument(filename + " has offsets that do not describe " +
+                                std::to_string(header.E) + " edges");
+  if (IsWeighted())
+    weights_ = Section<double>(file_, header.weights, header.E);
+  if (HasNames()) {
+    name_offsets_ = Section<uint64_t>(file_, header.name_offsets, header.V + 1);
+    span<const char> data = Section<char>(file_, header.name_data, header.name_bytes);
+    name_data_ = string_view(data.data(), data.size());
+  }
+  if (HasNames() && (flags_ & kIndexed)) {
+    // the probing in Index() ends at an empty slot, so there must be one
+    uint64_t slots = header.name_slots;
+    if (slots <= static_cast<uint64_t>(v_) || (slots & (slots - 1)) != 0)
+      throw std::invalid_argument(filename + " has a name index of the wrong size");
+    name_index_ = Section<int>(file_, header.name_index, slots);
+  }
+}
+
+/**
+ * Returns the name of vertex {@code v}.
+ *
+ * @param  v the vertex
+ * @return the name of vertex {@code v}, as a view into the file
+ * @throws IllegalArgumentException unless {@code 0 <= v < V}
+ * @throws IllegalArgumentException if the container has no name table
+ */
+string_view BinaryGraph::Name(int v) const {
+  if (!HasNames())
+    throw std::invalid_argument("binary graph has no vertex names");
+  if (v < 0 || v >= v_)
+    throw std::invalid_argument("vertex " + std::to_string(v) +
+                                " is not between 0 and " + std::to_string(v_-1));
+  return name_data_.substr(name_offsets_[v], name_offsets_[v + 1] - name_offsets_[v]);
+}
+
+/**
+ * Returns the vertex named {@code s}. Takes expected constant time (plus
+ * the length of the name) with the hash index, and time proportional to
+ * the size of the name table without it.
+ *
+ * @param  s the name of a vertex
+ * @return the vertex named {@code s}, or -1 if there is none
+ * @throws IllegalArgumentException if the container has no name table
+ */
+int BinaryGraph::Index(string_view s) const {
+  if (!HasNames())
+    throw std::invalid_argument("binary graph has no vertex names");
+  auto name = [this](int v) {
+    return name_data_.substr(name_offsets_[v], name_offsets_[v + 1] - name_offsets_[v]);
+  };
+  if (name_index_.empty()) {
+    for (int v = 0; v < v_; v++)
+      if (name(v) == s) return v;
+    return -1;
+  }
+
+  // at most V slots are occupied, so this ends within V + 1 probes
+  size_t mask = name_index_.size() - 1;
+  for (size_t i = NameHash(s) & mask; name_index_[i] >= 0; i = (i + 1) & mask)
+    if (name(name_index_[i]) == s) return name_index_[i];
+  return -1;
+}
+
+/**
+ * Checks every entry of the container: that the offsets are
+ * nondecreasing, that every target is a vertex, and that the name table
+ * lies within the file. Takes time proportional to <em>V</em> + <em>E</em>.
+ *
+ * @throws IllegalArgumentException if any entry is out of range
+ */
+void BinaryGraph::Validate() const {
+  for (int v = 0; v < v_; v++) {
+    if (offsets_[v] > offsets_[v + 1])
+      throw std::invalid_argument("offsets are not nondecreasing at vertex " +
+                                  std::to_string(v));
+  }
+  for (int w : targets_) {
+    if (w < 0 || w >= v_)
+      throw std::invalid_argument("vertex " + std::to_string(w) +
+                                  " is not between 0 and " + std::to_string(v_-1));
+  }
+  if (HasNames()) {
+    if (name_offsets_[0] != 0 || name_offsets_[v_] != name_data_.size())
+      throw std::invalid_argument("name table does not cover the name data");
+    for (int v = 0; v < v_; v++) {
+      if (name_offsets_[v] > name_offsets_[v + 1])
+        throw std::invalid_argument("name offsets are not nondecreasing at vertex " +
+                                    std::to_string(v));
+    }
+  }
+  if (!name_index_.empty()) {
+    int occupied = 0;
+    for (int v : name_index_) {
+      if (v < -1 || v >= v_)
+        throw std::invalid_argument("name index holds vertex " + std::to_string(v));
+      occupied += v >= 0;
+    }
+    if (occupied != v_)
+      throw std::invalid_argument("name index holds " + std::to_string(occupied) +
+                                  " vertices instead of " + std::to_string(v_));
+    for (int v = 0; v < v_; v++) {
+      if (Index(Name(v)) != v)
+        throw std::invalid_argument("name index does not find vertex " + std::to_string(v));
+    }
+  }
+}
+
+/**
+ * Copies this graph into a {@link CompactDigraph}.
+ *
+ * @return a compact digraph with the same adjacency lists
+ */
+CompactDigraph BinaryGraph::ToCompactDigraph() const {
+  return CompactDigraph(v_, vector<int>(offsets_.begin(), offsets_.end()),
+                        vector<int>(targets_.begin(), targets_.end()));
+}
+
+/**
+ * Copies this graph into an {@link EdgeWeightedDigraph}. Edge ids follow
+ * the order of the stored edges.
+ *
+ * @return an edge-weighted digraph with the same adjacency lists
+ * @throws IllegalArgumentException if the container has no weights
+ */
+EdgeWeightedDigraph BinaryGraph::ToEdgeWeightedDigraph() const {
+  if (!IsWeighted())
+    throw std::invalid_argument("binary graph has no edge weights");
+  vector<int> from(E());
+  for (int v = 0; v < v_; v++)
+    std::fill(from.begin() + offsets_[v], from.begin() + offsets_[v + 1], v);
+
+  return EdgeWeightedDigraph(v_, std::move(from), vector<int>(targets_.begin(), targets_.end()),
+                             vector<double>(weights_.begin(), weights_.end()));
+}
+
+/**
+ * Copies this undirected graph into an {@link EdgeWeightedGraph}.
+ *
+ * @return an edge-weighted graph with the same edges
+ * @throws IllegalArgumentException if the container has no weights or is not undirected
+ */
+EdgeWeightedGraph BinaryGraph::ToEdgeWeightedGraph() const {
+  if (!IsWeighted() || !IsUndirected())
+    throw std::invalid_argument("binary graph is not an undirected edge-weighted graph");
+  vector<Edge> edges;
+  edges.reserve(E() / 2);
+  // the bits of the weights of the self-loops on v seen so far, each with the
+  // number of copies of it seen, as the two copies of a self-loop need not be
+  // adjacent; bits, so that the copies of a NaN weight pair up as well
+  vector<std::pair<uint64_t, int>> loops;
+  for (int v = 0; v < v_; v++) {
+    span<const int> adj = Adj(v);
+    span<const double> weights = Weights(v);
+    loops.clear();
+    for (size_t i = 0; i < adj.size(); i++) {
+      // each edge is stored twice; keep the copy seen from its smaller endpoint,
+      // and every other copy of a self-loop of the same weight
+      if (adj[i] > v) {
+        edges.emplace_back(v, adj[i], weights[i]);
+      } else if (adj[i] == v) {
+        uint64_t bits = std::bit_cast<uint64_t>(weights[i]);
+        auto loop = std::find_if(loops.begin(), loops.end(),
+                                 [&](const std::pair<uint64_t, int>& l) { return l.first == bits; });
+        if (loop == loops.end()) loop = loops.insert(loops.end(), {bits, 0});
+        if (loop->second++ % 2 == 0)
+          edges.emplace_back(v, v, weights[i]);
+      }
+    }
+  }
+
+  return EdgeWeightedGraph(v_, std::move(edges));
+}
+
+/**
+ * Writes the digraph {@code G} to the binary graph container {@code filename}.
+ *
+ * @param  filename the name of the file
+ * @param  G the digraph
+ * @throws std::runtime_error if the file cannot be written
+ */
+void WriteBinaryGraph(const string& filename, const CompactDigraph& G) {
+  Write(filename, { G.V(), 0, G.offsets(), G.targets(), {}, {} });
+}
+
+/**
+ * Writes the edge-weighted digraph {@code G}, with its weights, to the binary
+ * graph container {@code filename}.
+ *
+ * @param  filename the name of the file
+ * @param  G the edge-weighted digraph
+ * @throws std::runtime_error if the file cannot be written
+ */
+void WriteBinaryGraph(const string& filename, const EdgeWeightedDigraph& G) {
+  vector<int> offsets { 0 }, targets;
+  vector<double> weights;
+  targets.reserve(G.E());
+  weights.reserve(G.E());
+  for (int v = 0; v < G.V(); v++) {
+    for (int e : G.Adj(v)) {
+      targets.push_back(G.to(e));
+      weights.push_back(G.weight(e));
+    }
+    offsets.push_back(targets.size());
+  }
+  Write(filename, { G.V(), BinaryGraph::kWeighted, offsets, targets, weights, {} });
+}
+
+/**
+ * Writes the edge-weighted graph {@code G}, with its weights, to the binary
+ * graph container {@code filename}, storing each edge in both directions.
+ *
+ * @param  filename the name of the file
+ * @param  G the edge-weighted graph
+ * @throws std::runtime_error if the file cannot be written
+ */
+void WriteBinaryGraph(const string& filename, const EdgeWeightedGraph& G) {
+  vector<int> offsets { 0 }, targets;
+  vector<double> weights;
+  targets.reserve(2 * G.E());
+  weights.reserve(2 * G.E());
+  for (int v = 0; v < G.V(); v++) {
+    for (const EdgeWeightedGraph::Incident& slot : G.adj(v)) {
+      targets.push_back(slot.other);
+      weights.push_back(G.edge(slot.edge).weight());
+    }
+    offsets.push_back(targets.size());
+  }
+  Write(filename, { G.V(), BinaryGraph::kWeighted | BinaryGraph::kUndirected,
+                    offsets, targets, weights, {} });
+}
+
+/**
+ * Writes the symbol digraph {@code sg}, with its name table, to the binary
+ * graph container {@code filename}.
+ *
+ * @param  filename the name of the file
+ * @param  sg the symbol digraph
+ * @throws std::runtime_error if the file cannot be written
+ */
+void WriteBinaryGraph(const string& filename, const SymbolDigraph& sg) {
+  CompactDigraph G = sg.digraph()->Freeze();
+  vector<string_view> names;
+  names.reserve(G.V());
+  for (int v = 0; v < G.V(); v++)
+    names.push_back(sg.NameOf(v));
+  Write(filename, { G.V(), BinaryGraph::kNamed | BinaryGraph::kIndexed,
+                    G.offsets(), G.targets(), {}, names });
+}
+}
+
+/**
+ * Unit tests the {@code BinaryGraph} data type.
+ *
+ * @param args the command-line arguments
+ */
+#ifdef Debug
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <tuple>
+using namespace algs4;
+
+// writes a graph whose self-loops, one with a NaN weight, are interleaved in
+// the adjacency lists, and checks that each one reads back once
+bool SelfLoopsRoundTrip() {
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  vector<Edge> edges { {0, 0, 0.5}, {0, 0, nan}, {0, 1, 0.25}, {0, 0, 0.5}, {1, 1, nan} };
+  string filename = (std::filesystem::temp_directory_path() / "binary_graph_loops.bin").string();
+  WriteBinaryGraph(filename, EdgeWeightedGraph(2, edges));
+  EdgeWeightedGraph H = BinaryGraph(filename).ToEdgeWeightedGraph();
+  std::filesystem::remove(filename);
+
+  auto sorted = [](span<const Edge> edges) {
+    vector<std::tuple<int, int, uint64_t>> keys;
+    for (const Edge& e : edges) {
+      int v = e.Either();
+      keys.emplace_back(std::min(v, e.other(v)), std::max(v, e.other(v)),
+                        std::bit_cast<uint64_t>(e.weight()));
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+  };
+  return sorted(edges) == sorted(H.Edges());
+}
+
+int main(int argc, char *argv[]) {
+  if (!SelfLoopsRoundTrip()) {
+    printf("self-loops do not read back\n");
+    return 1;
+  }
+  BinaryGraph G(argv[1]);
+  G.Validate();
+  printf("%d vertices, %d edges%s%s%s\n", G.V(), G.E(), G.IsWeighted() ? ", weights" : "",
+         G.HasNames() ? ", names" : "", G.IsUndirected() ? ", undirected" : "");
+  if (argc > 2) {
+    for (int i = 2; i < argc; i++) {
+      int v = G.Index(argv[i]);
+      if (v >= 0) printf("%s: %d\n", argv[i], v);
+      else        printf("%s: not a vertex\n", argv[i]);
+    }
+    return 0;
+  }
+  for (int v = 0; v < G.V(); v++) {
+    if (G.HasNames()) printf("%s:", string(G.Name(v)).c_str());
+    else              printf("%d:", v);
+    for (size_t i = 0; i < G.Adj(v).size(); i++) {
+      int w = G.Adj(v)[i];
+      if (G.HasNames()) printf(" %s", string(G.Name(w)).c_str());
+      else              printf(" %d", w);
+      if (G.IsWeighted()) printf(" %.5f", G.Weights(v)[i]);
+    }
+    printf("\n");
+  }
+
+  return 0;
+}
+#endif
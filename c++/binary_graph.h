@@ -0,0 +1,244 @@
+#ifndef BINARY_GRAPH_H_
+#define BINARY_GRAPH_H_
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "mapped_file.h"
+
+/**
+ *  The {@code BinaryGraph} class represents a graph stored in the binary
+ *  graph container format and opened by memory-mapping the file, so that
+ *  no part of the graph is copied or parsed: opening a graph takes
+ *  constant time, whatever its size, and the operating system pages the
+ *  arrays in as they are used.
+ *  <p>
+ *  A container holds, after a fixed-size header, the adjacency of a digraph
+ *  in compressed sparse row form: <em>V</em> + 1 row offsets and
+ *  <em>E</em> edge targets, as 32-bit integers. It may also hold the weight
+ *  of each edge, as a {@code double} parallel to the targets, and a name
+ *  table giving the name of each vertex of a {@link SymbolDigraph}, with a
+ *  hash index from names back to vertices, so that a symbol digraph can be
+ *  reopened without tokenizing its source again: {@code Contains()},
+ *  {@code Index()} and {@code Name()} work directly on the mapped file.
+ *  An undirected {@link EdgeWeightedGraph} is stored with each edge in the
+ *  adjacency lists of both its endpoints, as {@link EdgeWeightedGraph#adj(int)}
+ *  returns them; {@code E()} then counts both directions.
+ *  <p>
+ *  All sections are 8-byte aligned and stored in the byte order of the
+ *  machine that wrote the file; opening a file of another byte order or a
+ *  newer version fails. Version 1 containers, whose name tables have no
+ *  index, can still be opened; {@code Index()} then scans the names. Opening checks that the sections fit in the file and that
+ *  the offsets start at 0 and end at <em>E</em>, but not the individual
+ *  entries; call {@code Validate()} before trusting a file from elsewhere.
+ *  <p>
+ *  The per-vertex accessors do not validate their argument.
+ *  Use {@link #WriteBinaryGraph} (see {@code graph_converter.cc}) to
+ *  create a container.
+ */
+
+namespace algs4 {
+
+class CompactDigraph;
+class EdgeWeightedDigraph;
+class EdgeWeightedGraph;
+class SymbolDigraph;
+
+class BinaryGraph {
+public:
+  static constexpr uint32_t kVersion = 2;
+  // bits of flags()
+  static constexpr uint32_t kWeighted = 1;     // the container has edge weights
+  static constexpr uint32_t kNamed = 2;        // the container has a name table
+  static constexpr uint32_t kUndirected = 4;   // every edge is stored in both directions
+  static constexpr uint32_t kIndexed = 8;      // the name table has a hash index
+
+  /**
+   * Opens the binary graph container {@code filename}.
+   *
+   * @param  filename the name of the file
+   * @throws std::runtime_error if the file cannot be read
+   * @throws IllegalArgumentException if the file is not a binary graph container
+   *         of a supported version and this byte order, or its sections do not
+   *         fit in the file
+   */
+  explicit BinaryGraph(const std::string& filename);
+  BinaryGraph() = delete;
+  BinaryGraph(const BinaryGraph& other) = delete;
+  BinaryGraph &operator=(const BinaryGraph& other) = delete;
+  BinaryGraph(BinaryGraph&& other) = default;
+  BinaryGraph &operator=(BinaryGraph&& other) = default;
+
+  /**
+   * Returns the number of vertices in this graph.
+   *
+   * @return the number of vertices in this graph
+   */
+  int V() const { return v_; }
+  /**
+   * Returns the number of stored edges in this graph.
+   *
+   * @return the number of stored edges; twice the number of edges if the
+   *         graph is undirected
+   */
+  int E() const { return static_cast<int>(targets_.size()); }
+  /**
+   * Returns the flags of this container.
+   *
+   * @return a combination of {@code kWeighted}, {@code kNamed}, {@code kUndirected}
+   *         and {@code kIndexed}
+   */
+  uint32_t flags() const { return flags_; }
+  bool IsWeighted() const { return flags_ & kWeighted; }
+  bool HasNames() const { return flags_ & kNamed; }
+  bool IsUndirected() const { return flags_ & kUndirected; }
+  /**
+   * Returns the vertices adjacent from vertex {@code v}.
+   * The vertex is not validated.
+   *
+   * @param  v the vertex, between 0 and <em>V</em> - 1
+   * @return the vertices adjacent from vertex {@code v}, as a view into the file
+   */
+  std::span<const int> Adj(int v) const {
+    return targets_.subspan(offsets_[v], offsets_[v + 1] - offsets_[v]);
+  }
+  /**
+   * Returns the weights of the edges incident from vertex {@code v}, parallel
+   * to {@code Adj(v)}. The vertex is not validated.
+   *
+   * @param  v the vertex, between 0 and <em>V</em> - 1
+   * @return the weights of the edges incident from vertex {@code v}, or an
+   *         empty range if the container has no weights
+   */
+  std::span<const double> Weights(int v) const {
+    if (weights_.empty()) return {};
+    return weights_.subspan(offsets_[v], offsets_[v + 1] - offsets_[v]);
+  }
+  /**
+   * Returns the number of edges incident from vertex {@code v}.
+   * The vertex is not validated.
+   *
+   * @param  v the vertex, between 0 and <em>V</em> - 1
+   * @return the outdegree of vertex {@code v}
+   */
+  int Outdegree(int v) const { return offsets_[v + 1] - offsets_[v]; }
+  /**
+   * Returns the name of vertex {@code v}.
+   *
+   * @param  v the vertex
+   * @return the name of vertex {@code v}, as a view into the file
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   * @throws IllegalArgumentException if the container has no name table
+   */
+  std::string_view Name(int v) const;
+  /**
+   * Returns the vertex named {@code s}. Takes expected constant time (plus
+   * the length of the name) with the hash index, and time proportional to
+   * the size of the name table without it.
+   *
+   * @param  s the name of a vertex
+   * @return the vertex named {@code s}, or -1 if there is none
+   * @throws IllegalArgumentException if the container has no name table
+   */
+  int Index(std::string_view s) const;
+  /**
+   * Does the graph have a vertex named {@code s}?
+   *
+   * @param  s the name of a vertex
+   * @return {@code true} if {@code s} is the name of a vertex, and {@code false} otherwise
+   * @throws IllegalArgumentException if the container has no name table
+   */
+  bool Contains(std::string_view s) const { return Index(s) >= 0; }
+  /**
+   * Returns the row offsets, targets and weights of this graph.
+   *
+   * @return views of the <em>V</em> + 1 row offsets, the <em>E</em> targets,
+   *         and the <em>E</em> weights (empty if the container has no weights)
+   */
+  std::span<const int> offsets() const { return offsets_; }
+  std::span<const int> targets() const { return targets_; }
+  std::span<const double> weights() const { return weights_; }
+  /**
+   * Checks every entry of the container: that the offsets are
+   * nondecreasing, that every target is a vertex, that the name table
+   * lies within the file, and that the name index finds every vertex.
+   * Takes time proportional to <em>V</em> + <em>E</em> plus the size of
+   * the name table.
+   *
+   * @throws IllegalArgumentException if any entry is out of range
+   */
+  void Validate() const;
+  /**
+   * Copies this graph into a {@link CompactDigraph}.
+   *
+   * @return a compact digraph with the same adjacency lists
+   */
+  CompactDigraph ToCompactDigraph() const;
+  /**
+   * Copies this graph into an {@link EdgeWeightedDigraph}. Edge ids follow
+   * the order of the stored edges.
+   *
+   * @return an edge-weighted digraph with the same adjacency lists
+   * @throws IllegalArgumentException if the container has no weights
+   */
+  EdgeWeightedDigraph ToEdgeWeightedDigraph() const;
+  /**
+   * Copies this undirected graph into an {@link EdgeWeightedGraph}.
+   *
+   * @return an edge-weighted graph with the same edges
+   * @throws IllegalArgumentException if the container has no weights or is not undirected
+   */
+  EdgeWeightedGraph ToEdgeWeightedGraph() const;
+
+private:
+  MappedFile file_;                   // the mapping all views point into
+  int v_;                             // number of vertices
+  uint32_t flags_;                    // kWeighted | kNamed | kUndirected
+  std::span<const int> offsets_;      // targets_[offsets_[v]..offsets_[v+1]) = adjacency list of v
+  std::span<const int> targets_;      // head vertices, grouped by tail vertex
+  std::span<const double> weights_;   // weights_[i] = weight of the edge to targets_[i]
+  std::span<const uint64_t> name_offsets_;  // name of v = name_data_[name_offsets_[v]..name_offsets_[v+1])
+  std::string_view name_data_;        // concatenated vertex names
+  std::span<const int> name_index_;   // open-addressing hash index of vertex ids, -1 if empty
+};
+
+/**
+ * Writes the digraph {@code G} to the binary graph container {@code filename}.
+ *
+ * @param  filename the name of the file
+ * @param  G the digraph
+ * @throws std::runtime_error if the file cannot be written
+ */
+void WriteBinaryGraph(const std::string& filename, const CompactDigraph& G);
+/**
+ * Writes the edge-weighted digraph {@code G}, with its weights, to the binary
+ * graph container {@code filename}.
+ *
+ * @param  filename the name of the file
+ * @param  G the edge-weighted digraph
+ * @throws std::runtime_error if the file cannot be written
+ */
+void WriteBinaryGraph(const std::string& filename, const EdgeWeightedDigraph& G);
+/**
+ * Writes the edge-weighted graph {@code G}, with its weights, to the binary
+ * graph container {@code filename}, storing each edge in both directions.
+ *
+ * @param  filename the name of the file
+ * @param  G the edge-weighted graph
+ * @throws std::runtime_error if the file cannot be written
+ */
+void WriteBinaryGraph(const std::string& filename, const EdgeWeightedGraph& G);
+/**
+ * Writes the symbol digraph {@code sg}, with its name table and name index,
+ * to the binary graph container {@code filename}.
+ *
+ * @param  filename the name of the file
+ * @param  sg the symbol digraph
+ * @throws std::runtime_error if the file cannot be written
+ */
+void WriteBinaryGraph(const std::string& filename, const SymbolDigraph& sg);
+}
+
+#endif  // BINARY_GRAPH_H_
@@ -0,0 +1,200 @@
+#ifndef BIT_PARALLEL_BFS_H_
+#define BIT_PARALLEL_BFS_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "graph_concepts.h"
+
+/**
+ *  The {@code BitParallelBFS} class runs up to 64 independent
+ *  breadth-first searches of a digraph at once, for reachability from many
+ *  sources or sets of sources. Search <em>i</em>, its <em>lane</em>, owns
+ *  bit <em>i</em> of a 64-bit word per vertex: the word of
+ *  <em>v</em> says which searches have reached <em>v</em>. The searches
+ *  advance level by level; a vertex on the frontier of several of them is
+ *  expanded once, sending the word of the searches that reached it along
+ *  each of its edges with a single AND and OR, so one scan of an adjacency
+ *  list serves the whole batch.
+ *  <p>
+ *  {@code Run(sources)} gives lane <em>i</em> the source
+ *  {@code sources[i]}, and {@code Run(sets)} the set of sources
+ *  {@code sets[i]}, and {@code RunLanes(seeds)} takes the sources as a word
+ *  per vertex; afterwards {@code Reached(v)} holds the lanes that
+ *  reach <em>v</em>. The workspace, three words per vertex, is allocated
+ *  once, so a traversal may run batch after batch.
+ *  <p>
+ *  A run takes time proportional to <em>V</em> plus the number of edges
+ *  leaving the vertices reached by at least one lane, times the number of
+ *  levels at which a vertex is reached by some new lane, which is at most
+ *  64 and in practice a handful: this is the multi-source BFS of Then et
+ *  al., "The More the Merrier" (VLDB 2014). Running 64 single-source
+ *  searches one by one scans those edges up to 64 times.
+ */
+
+namespace algs4 {
+
+template <DirectedGraph Graph>
+class BitParallelBFS {
+public:
+  /**
+   * The number of searches in a batch.
+   */
+  static constexpr int kLanes = 64;
+
+  /**
+   * Prepares batched searches of the digraph {@code G}, which must outlive
+   * the traversal.
+   * @param G the digraph
+   */
+  explicit BitParallelBFS(const Graph& G) :
+    graph_(&G), seen_(G.V()), visit_(G.V()), next_(G.V()) {}
+  BitParallelBFS() = delete;
+  BitParallelBFS(const BitParallelBFS& other) = delete;
+  BitParallelBFS &operator=(const BitParallelBFS& other) = delete;
+  BitParallelBFS(BitParallelBFS&& other) = default;
+  BitParallelBFS &operator=(BitParallelBFS&& other) = default;
+
+  /**
+   * Runs one search from each source: lane <em>i</em> from {@code sources[i]}.
+   * @param  sources the sources, at most {@code kLanes}
+   * @throws IllegalArgumentException if there are more than {@code kLanes} sources
+   * @throws IllegalArgumentException unless {@code 0 <= s < V} for each source {@code s}
+   */
+  void Run(std::span<const int> sources) {
+    Start(sources.size());
+    for (int i = 0; i < static_cast<int>(sources.size()); i++)
+      Seed(i, sources[i]);
+    Search();
+  }
+
+  /**
+   * Runs one search from each set of sources: lane <em>i</em> from the
+   * vertices in {@code sets[i]}.
+   * @param  sets the sets of sources, at most {@code kLanes}
+   * @throws IllegalArgumentException if there are more than {@code kLanes} sets
+   * @throws IllegalArgumentException unless {@code 0 <= s < V} for each source {@code s}
+   */
+  void Run(const std::vector<std::vector<int>>& sets) {
+    Start(sets.size());
+    for (int i = 0; i < static_cast<int>(sets.size()); i++)
+      for (int s : sets[i])
+        Seed(i, s);
+    Search();
+  }
+
+  /**
+   * Runs the searches given by a word per vertex: lane <em>i</em> from the
+   * vertices {@code v} with bit <em>i</em> of {@code seeds[v]} set.
+   * @param  seeds the lanes each vertex is a source of, one word per vertex
+   * @throws IllegalArgumentException unless there are <em>V</em> words
+   */
+  void RunLanes(std::span<const uint64_t> seeds) {
+    if (seeds.size() != seen_.size())
+      throw std::invalid_argument(std::to_string(seeds.size()) + " seeds for " +
+                                  std::to_string(seen_.size()) + " vertices");
+    Start(kLanes);
+    for (int v = 0; v < static_cast<int>(seeds.size()); v++) {
+      if (!seeds[v]) continue;
+      frontier_.push_back(v);
+      visit_[v] = seeds[v];
+      seen_[v] = seeds[v];
+    }
+    Search();
+  }
+
+  /**
+   * Returns the lanes of the last run that reach vertex {@code v}: bit
+   * <em>i</em> is set if there is a directed path to {@code v} from a
+   * source of lane <em>i</em>.
+   * @param  v the vertex
+   * @return the lanes that reach {@code v}
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   */
+  uint64_t Reached(int v) const {
+    ValidateVertex(v);
+    return seen_[v];
+  }
+
+  /**
+   * Is there a directed path from a source of lane {@code lane} to vertex {@code v}?
+   * @param  lane the lane
+   * @param  v the vertex
+   * @return {@code true} if there is a directed path, {@code false} otherwise
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   * @throws IllegalArgumentException unless {@code 0 <= lane < kLanes}
+   */
+  bool Marked(int lane, int v) const {
+    if (lane < 0 || lane >= kLanes)
+      throw std::invalid_argument("lane " + std::to_string(lane) + " is not between 0 and " +
+                                  std::to_string(kLanes - 1));
+    return Reached(v) >> lane & 1;
+  }
+
+private:
+  void Start(size_t lanes) {
+    if (lanes > kLanes)
+      throw std::invalid_argument(std::to_string(lanes) + " searches in a batch of " +
+                                  std::to_string(kLanes));
+    // a run that threw may have left its sources seeded
+    for (int v : frontier_)
+      visit_[v] = 0;
+    frontier_.clear();
+    std::fill(seen_.begin(), seen_.end(), 0);
+  }
+
+  void Seed(int lane, int v) {
+    ValidateVertex(v);
+    if (!visit_[v]) frontier_.push_back(v);
+    visit_[v] |= uint64_t{1} << lane;
+    seen_[v] |= uint64_t{1} << lane;
+  }
+
+  // advances the frontier one level at a time; visit_[v] holds the lanes
+  // that reached v at the current level, next_[w] those that reach w at the
+  // next one, and both are zero again once the search is over
+  void Search() {
+    const Graph& G = *graph_;
+    while (!frontier_.empty()) {
+      for (int v : frontier_) {
+        uint64_t lanes = visit_[v];
+        visit_[v] = 0;
+        for (int w : Heads(G, v)) {
+          uint64_t fresh = lanes & ~seen_[w];
+          if (!fresh) continue;
+          if (!next_[w]) queue_.push_back(w);
+          next_[w] |= fresh;
+        }
+      }
+      for (int w : queue_) {
+        seen_[w] |= next_[w];
+        visit_[w] = next_[w];
+        next_[w] = 0;
+      }
+      frontier_.swap(queue_);
+      queue_.clear();
+    }
+  }
+
+  // throw an IllegalArgumentException unless {@code 0 <= v < V}
+  void ValidateVertex(int v) const {
+    int V = seen_.size();
+    if (v < 0 || v >= V)
+      throw std::invalid_argument("vertex " + std::to_string(v) + " is not between 0 and " +
+                                  std::to_string(V - 1));
+  }
+
+  const Graph* graph_;
+  std::vector<uint64_t> seen_;    // seen_[v] = lanes that have reached v
+  std::vector<uint64_t> visit_;   // visit_[v] = lanes that reached v at this level
+  std::vector<uint64_t> next_;    // next_[w] = lanes that reach w at the next level
+  std::vector<int> frontier_;     // vertices with visit_[v] != 0
+  std::vector<int> queue_;        // vertices with next_[w] != 0
+};
+}
+
+#endif  // BIT_PARALLEL_BFS_H_
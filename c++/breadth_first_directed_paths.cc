@@ -0,0 +1,156 @@
+/******************************************************************************
+ *  Compilation:  clang++ -c -O2 digraph.cc -std=c++20
+ *                clang++ -c -O2 compact_digraph.cc -std=c++20
+ *                clang++ -c -O2 direction_optimizing_bfs.cc -std=c++20
+ *                clang++ -DDebug -O2 breadth_first_directed_paths.cc digraph.o compact_digraph.o direction_optimizing_bfs.o -std=c++20 -pthread -o breadth_first_directed_paths
+ *  Execution:    ./breadth_first_directed_paths digraph.txt s
+ *  Dependencies: digraph.cc compact_digraph.cc direction_optimizing_bfs.cc
+ *  Data files:   https://algs4.cs.princeton.edu/42digraph/tinyDG.txt
+ *                https://algs4.cs.princeton.edu/42digraph/mediumDG.txt
+ *                https://algs4.cs.princeton.edu/42digraph/largeDG.txt
+ *
+ *  Run breadth-first search on a digraph.
+ *  Runs in O(E + V) time.
+ *
+ *  % ./breadth_first_directed_paths tinyDG.txt 3
+ *  3 to 0 (2):  3->2->0
+ *  3 to 1 (3):  3->2->0->1
+ *  3 to 2 (1):  3->2
+ *  3 to 3 (0):  3
+ *  3 to 4 (2):  3->5->4
+ *  3 to 5 (1):  3->5
+ *  3 to 6 (-):  not connected
+ *  3 to 7 (-):  not connected
+ *  3 to 8 (-):  not connected
+ *  3 to 9 (-):  not connected
+ *  3 to 10 (-):  not connected
+ *  3 to 11 (-):  not connected
+ *  3 to 12 (-):  not connected
+ *
+ ******************************************************************************/
+
+/**
+ *  The {@code BreadthFirstDirectedPaths} class represents a data type for
+ *  finding shortest paths (number of edges) from a source vertex <em>s</em>
+ *  (or set of source vertices) to every other vertex in the digraph.
+ *  <p>
+ *  This implementation uses the direction-optimizing breadth-first search
+ *  of {@link DirectionOptimizingBFS}, on the digraph in compressed sparse
+ *  row form and its reverse, expanding each level on several threads.
+ *  With more than one thread, which of several shortest paths is found may
+ *  vary from run to run.
+ *  The constructor takes &Theta;(<em>V</em> + <em>E</em>) time in the
+ *  worst case, where <em>V</em> is the number of vertices and <em>E</em> is
+ *  the number of edges.
+ *  Each instance method takes &Theta;(1) time, except {@code pathTo}, which
+ *  takes time proportional to the length of the path.
+ *  It uses &Theta;(<em>V</em> + <em>E</em>) extra space (not including the
+ *  digraph), for its reverse; the paths themselves take two arrays of
+ *  <em>V</em> integers.
+ *  <p>
+ *  For additional documentation,
+ *  see <a href="https://algs4.cs.princeton.edu/42digraph">Section 4.2</a> of
+ *  <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
+ *
+ *  @author Robert Sedgewick
+ *  @author Kevin Wayne
+ */
+
+#include "breadth_first_directed_paths.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "direction_optimizing_bfs.h"
+
+using std::stack;
+using std::to_string;
+using std::vector;
+
+namespace algs4 {
+void BreadthFirstDirectedPaths::Search(const CompactDigraph& G, const vector<int>& sources,
+                                       int threads) {
+  distTo_.assign(G.V(), BreadthFirstTree::kInfinity);
+  if (sources.empty())
+    throw std::invalid_argument("zero vertices");
+  for (int s : sources)
+    validateVertex(s);
+
+  BreadthFirstTree tree = DirectionOptimizingBFS(G, G.Reverse(), sources, threads);
+  edgeTo_ = std::move(tree.edgeTo);
+  distTo_ = std::move(tree.distTo);
+}
+
+bool BreadthFirstDirectedPaths::hasPathTo(int v) const {
+  validateVertex(v);
+  return distTo_[v] != BreadthFirstTree::kInfinity;
+}
+
+int BreadthFirstDirectedPaths::distTo(int v) const {
+  validateVertex(v);
+  return distTo_[v];
+}
+
+stack<int> BreadthFirstDirectedPaths::pathTo(int v) const {
+  validateVertex(v);
+  stack<int> path;
+  if (!hasPathTo(v)) return path;
+  int x;
+  for (x = v; distTo_[x] != 0; x = edgeTo_[x])
+    path.push(x);
+  path.push(x);
+  return path;
+}
+
+void BreadthFirstDirectedPaths::validateVertex(int v) const {
+  int V = distTo_.size();
+  if (v < 0 || v >= V)
+    throw std::invalid_argument("vertex " + to_string(v) + " is not between 0 and " + to_string(V-1));
+}
+}
+
+/**
+ * Unit tests the {@code BreadthFirstDirectedPaths} data type.
+ *
+ * @param args the command-line arguments
+ */
+#ifdef Debug
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include "digraph.h"
+
+using namespace algs4;
+
+int main(int argc, char *argv[]) {
+  std::fstream in(argv[1]);
+  if (!in.is_open()) {
+    std::cout << "failed to open " << argv[1] << '\n';
+    return 1;
+  }
+
+  Digraph G(in);
+  // StdOut.println(G);
+
+  int s = strtol(argv[2], nullptr, 10);
+  BreadthFirstDirectedPaths bfs(G, s);
+
+  for (int v = 0; v < G.V(); v++) {
+    if (bfs.hasPathTo(v)) {
+      std::cout << s << " to " << v << " (" << bfs.distTo(v) << "):  ";
+      stack<int> path = bfs.pathTo(v);
+      while (!path.empty()) {
+        if (path.top() == s) std::cout << path.top();
+        else                 std::cout << "->" << path.top();
+        path.pop();
+      }
+      std::cout << std::endl;
+    } else {
+      std::cout << s << " to " << v << " (-):  not connected" << std::endl;
+    }
+  }
+
+  return 0;
+}
+#endif
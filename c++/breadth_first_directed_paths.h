@@ -0,0 +1,95 @@
+#ifndef BREADTH_FIRST_DIRECTED_PATHS_H_
+#define BREADTH_FIRST_DIRECTED_PATHS_H_
+
+#include <concepts>
+#include <stack>
+#include <vector>
+
+#include "compact_digraph.h"
+#include "graph_concepts.h"
+#include "parallel.h"
+
+namespace algs4 {
+class BreadthFirstDirectedPaths {
+public:
+  /**
+   * Computes the shortest path from {@code s} and every other vertex in the digraph {@code G}.
+   * @param G the digraph
+   * @param s the source vertex
+   * @param threads the number of threads
+   * @throws IllegalArgumentException unless {@code 0 <= s < V}
+   */
+  template <DirectedGraph Graph>
+  BreadthFirstDirectedPaths(const Graph& G, int s, int threads = DefaultThreads()) :
+    BreadthFirstDirectedPaths(G, std::vector<int>{s}, threads) {}
+  /**
+   * Computes the shortest path from any one of the source vertices in {@code sources}
+   * to every other vertex in the digraph {@code G}.
+   * @param G the digraph
+   * @param sources the source vertices
+   * @param threads the number of threads
+   * @throws IllegalArgumentException if {@code sources} is empty
+   * @throws IllegalArgumentException unless {@code 0 <= s < V} for each vertex
+   *         {@code s} in {@code sources}
+   */
+  template <DirectedGraph Graph>
+  BreadthFirstDirectedPaths(const Graph& G, const std::vector<int>& sources,
+                            int threads = DefaultThreads()) {
+    if constexpr (std::same_as<Graph, CompactDigraph>) {
+      Search(G, sources, threads);
+    } else {
+      std::vector<int> offsets(G.V() + 1), targets;
+      for (int v = 0; v < G.V(); v++) {
+        for (int w : Heads(G, v))
+          targets.push_back(w);
+        offsets[v + 1] = static_cast<int>(targets.size());
+      }
+      Search(CompactDigraph(G.V(), std::move(offsets), std::move(targets)), sources, threads);
+    }
+  }
+  BreadthFirstDirectedPaths() = delete;
+  BreadthFirstDirectedPaths(const BreadthFirstDirectedPaths& other) = default;
+  BreadthFirstDirectedPaths &operator=(const BreadthFirstDirectedPaths& other) = default;
+  BreadthFirstDirectedPaths(BreadthFirstDirectedPaths&& other) = default;
+  BreadthFirstDirectedPaths &operator=(BreadthFirstDirectedPaths&& other) = default;
+
+  /**
+   * Is there a directed path from the source {@code s} (or sources) to vertex {@code v}?
+   * @param v the vertex
+   * @return {@code true} if there is a directed path, {@code false} otherwise
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   */
+  bool hasPathTo(int v) const;
+
+  /**
+   * Returns the number of edges in a shortest path from the source {@code s}
+   * (or sources) to vertex {@code v}.
+   * @param v the vertex
+   * @return the number of edges in such a shortest path
+   *         (or {@code Integer.MAX_VALUE} if there is no such path)
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   */
+  int distTo(int v) const;
+
+  /**
+   * Returns a shortest path from {@code s} (or sources) to {@code v}, or
+   * an empty stack if no such path.
+   * @param v the vertex
+   * @return the sequence of vertices on a shortest path, as an Iterable
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   */
+  std::stack<int> pathTo(int v) const;
+
+private:
+  // runs the search, given G in compressed sparse row form
+  void Search(const CompactDigraph& G, const std::vector<int>& sources, int threads);
+  // throw an IllegalArgumentException unless {@code 0 <= v < V}
+  void validateVertex(int v) const;
+
+private:
+  std::vector<int> edgeTo_;    // edgeTo_[v] = previous vertex on shortest s->v path
+  std::vector<int> distTo_;    // distTo_[v] = length of shortest s->v path
+};
+}
+
+#endif  // BREADTH_FIRST_DIRECTED_PATHS_H_
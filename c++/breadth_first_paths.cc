@@ -0,0 +1,164 @@
+/******************************************************************************
+ *  Compilation:  clang++ -c -O2 graph.cc -std=c++20
+ *                clang++ -c -O2 compact_digraph.cc -std=c++20
+ *                clang++ -c -O2 direction_optimizing_bfs.cc -std=c++20
+ *                clang++ -c -O2 digraph.cc -std=c++20
+ *                clang++ -DDebug -O2 breadth_first_paths.cc graph.o compact_digraph.o direction_optimizing_bfs.o digraph.o -std=c++20 -pthread -o breadth_first_paths
+ *  Execution:    ./breadth_first_paths G s
+ *  Dependencies: graph.cc compact_digraph.cc direction_optimizing_bfs.cc
+ *  Data files:   https://algs4.cs.princeton.edu/41graph/tinyCG.txt
+ *                https://algs4.cs.princeton.edu/41graph/tinyG.txt
+ *                https://algs4.cs.princeton.edu/41graph/mediumG.txt
+ *                https://algs4.cs.princeton.edu/41graph/largeG.txt
+ *
+ *  Run breadth first search on an undirected graph.
+ *  Runs in O(E + V) time.
+ *
+ *  % ./breadth_first_paths tinyCG.txt 0
+ *  0 to 0 (0):  0
+ *  0 to 1 (1):  0-1
+ *  0 to 2 (1):  0-2
+ *  0 to 3 (2):  0-2-3
+ *  0 to 4 (2):  0-2-4
+ *  0 to 5 (1):  0-5
+ *
+ ******************************************************************************/
+
+/**
+ *  The {@code BreadthFirstPaths} class represents a data type for finding
+ *  shortest paths (number of edges) from a source vertex <em>s</em>
+ *  (or a set of source vertices)
+ *  to every other vertex in an undirected graph.
+ *  <p>
+ *  This implementation uses the direction-optimizing breadth-first search
+ *  of {@link DirectionOptimizingBFS}, on the graph in compressed sparse
+ *  row form, which is its own reverse, expanding each level on several
+ *  threads. With more than one thread, which of several shortest paths is
+ *  found may vary from run to run.
+ *  The constructor takes &Theta;(<em>V</em> + <em>E</em>) time in the
+ *  worst case, where <em>V</em> is the number of vertices and <em>E</em>
+ *  is the number of edges.
+ *  Each instance method takes &Theta;(1) time, except {@code pathTo}, which
+ *  takes time proportional to the length of the path.
+ *  It uses &Theta;(<em>V</em> + <em>E</em>) extra space (not including the
+ *  graph), for its compressed copy; the paths themselves take two arrays
+ *  of <em>V</em> integers.
+ *  <p>
+ *  For additional documentation,
+ *  see <a href="https://algs4.cs.princeton.edu/41graph">Section 4.1</a>
+ *  of <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
+ *
+ *  @author Robert Sedgewick
+ *  @author Kevin Wayne
+ */
+
+#include "breadth_first_paths.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "compact_digraph.h"
+#include "direction_optimizing_bfs.h"
+
+using std::stack;
+using std::to_string;
+using std::vector;
+
+namespace algs4 {
+BreadthFirstPaths::BreadthFirstPaths(const Graph& G, int s, int threads) :
+  BreadthFirstPaths(G, vector<int>{s}, threads) {}
+
+BreadthFirstPaths::BreadthFirstPaths(const Graph& G, const vector<int>& sources, int threads) :
+  distTo_(G.V(), BreadthFirstTree::kInfinity) {
+  if (sources.empty())
+    throw std::invalid_argument("zero vertices");
+  for (int s : sources)
+    validateVertex(s);
+
+  // each edge is in the adjacency lists of both its endpoints, so the
+  // digraph is symmetric and its own reverse
+  vector<int> offsets(G.V() + 1), targets;
+  targets.reserve(2 * static_cast<size_t>(G.E()));
+  for (int v = 0; v < G.V(); v++) {
+    const vector<int>& adj = G.adj(v);
+    targets.insert(targets.end(), adj.cbegin(), adj.cend());
+    offsets[v + 1] = static_cast<int>(targets.size());
+  }
+  CompactDigraph symmetric(G.V(), std::move(offsets), std::move(targets));
+
+  BreadthFirstTree tree = DirectionOptimizingBFS(symmetric, symmetric, sources, threads);
+  edgeTo_ = std::move(tree.edgeTo);
+  distTo_ = std::move(tree.distTo);
+}
+
+bool BreadthFirstPaths::hasPathTo(int v) const {
+  validateVertex(v);
+  return distTo_[v] != BreadthFirstTree::kInfinity;
+}
+
+int BreadthFirstPaths::distTo(int v) const {
+  validateVertex(v);
+  return distTo_[v];
+}
+
+stack<int> BreadthFirstPaths::pathTo(int v) const {
+  validateVertex(v);
+  stack<int> path;
+  if (!hasPathTo(v)) return path;
+  int x;
+  for (x = v; distTo_[x] != 0; x = edgeTo_[x])
+    path.push(x);
+  path.push(x);
+  return path;
+}
+
+void BreadthFirstPaths::validateVertex(int v) const {
+  int V = distTo_.size();
+  if (v < 0 || v >= V)
+    throw std::invalid_argument("vertex " + to_string(v) + " is not between 0 and " + to_string(V-1));
+}
+}
+
+/**
+ * Unit tests the {@code BreadthFirstPaths} data type.
+ *
+ * @param args the command-line arguments
+ */
+#ifdef Debug
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+using namespace algs4;
+
+int main(int argc, char *argv[]) {
+  std::fstream in(argv[1]);
+  if (!in.is_open()) {
+    std::cout << "failed to open " << argv[1] << '\n';
+    return 1;
+  }
+
+  Graph G(in);
+  // StdOut.println(G);
+
+  int s = strtol(argv[2], nullptr, 10);
+  BreadthFirstPaths bfs(G, s);
+
+  for (int v = 0; v < G.V(); v++) {
+    if (bfs.hasPathTo(v)) {
+      std::cout << s << " to " << v << " (" << bfs.distTo(v) << "):  ";
+      stack<int> path = bfs.pathTo(v);
+      while (!path.empty()) {
+        if (path.top() == s) std::cout << path.top();
+        else                 std::cout << "-" << path.top();
+        path.pop();
+      }
+      std::cout << std::endl;
+    } else {
+      std::cout << s << " to " << v << " (-):  not connected" << std::endl;
+    }
+  }
+
+  return 0;
+}
+#endif
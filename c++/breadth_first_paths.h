@@ -0,0 +1,77 @@
+#ifndef BREADTH_FIRST_PATHS_H_
+#define BREADTH_FIRST_PATHS_H_
+
+#include <stack>
+#include <vector>
+
+#include "graph.h"
+#include "parallel.h"
+
+namespace algs4 {
+class BreadthFirstPaths {
+public:
+  /**
+   * Computes the shortest path between the source vertex {@code s}
+   * and every other vertex in the graph {@code G}.
+   * @param G the graph
+   * @param s the source vertex
+   * @param threads the number of threads
+   * @throws IllegalArgumentException unless {@code 0 <= s < V}
+   */
+  BreadthFirstPaths(const Graph& G, int s, int threads = DefaultThreads());
+  /**
+   * Computes the shortest path between any one of the source vertices in {@code sources}
+   * and every other vertex in graph {@code G}.
+   * @param G the graph
+   * @param sources the source vertices
+   * @param threads the number of threads
+   * @throws IllegalArgumentException if {@code sources} is empty
+   * @throws IllegalArgumentException unless {@code 0 <= s < V} for each vertex
+   *         {@code s} in {@code sources}
+   */
+  BreadthFirstPaths(const Graph& G, const std::vector<int>& sources,
+                    int threads = DefaultThreads());
+  BreadthFirstPaths() = delete;
+  BreadthFirstPaths(const BreadthFirstPaths& other) = default;
+  BreadthFirstPaths &operator=(const BreadthFirstPaths& other) = default;
+  BreadthFirstPaths(BreadthFirstPaths&& other) = default;
+  BreadthFirstPaths &operator=(BreadthFirstPaths&& other) = default;
+
+  /**
+   * Is there a path between the source vertex {@code s} (or sources) and vertex {@code v}?
+   * @param v the vertex
+   * @return {@code true} if there is a path, and {@code false} otherwise
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   */
+  bool hasPathTo(int v) const;
+
+  /**
+   * Returns the number of edges in a shortest path between the source vertex {@code s}
+   * (or sources) and vertex {@code v}.
+   * @param v the vertex
+   * @return the number of edges in such a shortest path
+   *         (or {@code Integer.MAX_VALUE} if there is no such path)
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   */
+  int distTo(int v) const;
+
+  /**
+   * Returns a shortest path between the source vertex {@code s} (or sources)
+   * and {@code v}, or an empty stack if no such path.
+   * @param v the vertex
+   * @return the sequence of vertices on a shortest path, as an Iterable
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   */
+  std::stack<int> pathTo(int v) const;
+
+private:
+  // throw an IllegalArgumentException unless {@code 0 <= v < V}
+  void validateVertex(int v) const;
+
+private:
+  std::vector<int> edgeTo_;    // edgeTo_[v] = previous edge on shortest s-v path
+  std::vector<int> distTo_;    // distTo_[v] = number of edges shortest s-v path
+};
+}
+
+#endif  // BREADTH_FIRST_PATHS_H_
@@ -0,0 +1,350 @@
+/******************************************************************************
+ *  Compilation:  clang++ -c -O2 graph.cc -std=c++20
+ *                clang++ -c -O2 edge.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_graph.cc -std=c++20
+ *                clang++ -c -O2 digraph.cc -std=c++20
+ *                clang++ -c -O2 compact_digraph.cc -std=c++20
+ *                clang++ -c -O2 directed_edge.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_digraph.cc -std=c++20
+ *                clang++ -c -O2 graph_generator.cc -std=c++20
+ *                clang++ -DDebug -O2 cc.cc graph.o edge.o edge_weighted_graph.o digraph.o compact_digraph.o directed_edge.o edge_weighted_digraph.o graph_generator.o -std=c++20 -pthread -o cc
+ *  Execution:    ./cc filename.txt
+ *                ./cc scale E seed [threads]
+ *  Dependencies: graph.h edge_weighted_graph.h compact_digraph.h
+ *                depth_first_traversal.h parallel.h graph_generator.h
+ *  Data files:   https://algs4.cs.princeton.edu/41graph/tinyG.txt
+ *                https://algs4.cs.princeton.edu/41graph/mediumG.txt
+ *                https://algs4.cs.princeton.edu/41graph/largeG.txt
+ *
+ *  Compute connected components of an undirected graph, with depth-first
+ *  search or with Afforest; given a scale instead of a file, compare both
+ *  on an R-MAT graph with 2^scale vertices.
+ *
+ *  % ./cc tinyG.txt
+ *  3 components
+ *  0 1 2 3 4 5 6
+ *  7 8
+ *  9 10 11 12
+ *
+ *  % ./cc 22 30000000 5 4
+ *  rmat: 4194304 vertices, 30000000 edges
+ *  depth-first           724.2 ms, 2250331 components, largest 1942135
+ *  afforest              210.6 ms, 1 threads, agree
+ *  afforest              259.1 ms, 2 threads, agree
+ *  afforest              226.9 ms, 4 threads, agree
+ *
+ ******************************************************************************/
+
+#include "cc.h"
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "depth_first_traversal.h"
+
+using std::to_string;
+using std::vector;
+
+namespace algs4 {
+namespace {
+// the neighbors each vertex is linked with before sampling
+constexpr int kNeighborRounds = 2;
+// the vertices sampled to find the largest tree
+constexpr int kSamples = 1024;
+// the vertices a thread takes at a time
+constexpr int kChunk = 1 << 12;
+// enough edges to pay for starting a thread
+constexpr long long kGrain = 1 << 14;
+
+int ThreadsFor(long long work, int threads) {
+  return static_cast<int>(std::clamp<long long>(work / kGrain, 1, std::max(threads, 1)));
+}
+
+// the parents are read and written by several threads at once when shared
+int Load(vector<int>& parent, int v, bool shared) {
+  if (!shared) return parent[v];
+  return std::atomic_ref<int>(parent[v]).load(std::memory_order_relaxed);
+}
+
+// hooks the tree of u and that of v together: the greater root goes under
+// the lesser, so the root of a tree is always its least vertex
+void Link(vector<int>& parent, int u, int v, bool shared) {
+  int p1 = Load(parent, u, shared);
+  int p2 = Load(parent, v, shared);
+  while (p1 != p2) {
+    int high = std::max(p1, p2);
+    int low = std::min(p1, p2);
+    int p_high = Load(parent, high, shared);
+    if (p_high == low) return;
+    if (p_high == high) {
+      if (!shared) {
+        parent[high] = low;
+        return;
+      }
+      if (std::atomic_ref<int>(parent[high]).compare_exchange_strong(
+              p_high, low, std::memory_order_acq_rel, std::memory_order_relaxed))
+        return;
+    }
+    p1 = Load(parent, Load(parent, high, shared), shared);
+    p2 = Load(parent, low, shared);
+  }
+}
+
+// points each vertex at its root; a vertex only ever moves up its tree,
+// so the threads may compress at once
+void Compress(vector<int>& parent, int threads) {
+  int V = parent.size();
+  int t = ThreadsFor(V, threads);
+  bool shared = t > 1;
+  ParallelFor(V, t, [&](int begin, int end) {
+    for (int v = begin; v < end; v++) {
+      int p = Load(parent, v, shared);
+      for (int pp = Load(parent, p, shared); p != pp; pp = Load(parent, p, shared))
+        p = pp;
+      if (shared) std::atomic_ref<int>(parent[v]).store(p, std::memory_order_relaxed);
+      else        parent[v] = p;
+    }
+  });
+}
+
+// the neighbor in an adjacency list entry
+int Other(int w) { return w; }
+int Other(const EdgeWeightedGraph::Incident& incident) { return incident.other; }
+
+// each edge v-w is in the adjacency lists of both v and w; the lists are
+// copied in blocks of vertices, one block per thread
+template <typename Neighbors>
+CompactDigraph Symmetric(int V, Neighbors neighbors, int threads) {
+  vector<int> offsets(V + 1);
+  for (int v = 0; v < V; v++)
+    offsets[v + 1] = offsets[v] + static_cast<int>(neighbors(v).size());
+  vector<int> targets(offsets[V]);
+  ParallelFor(V, ThreadsFor(offsets[V], threads), [&](int begin, int end) {
+    for (int v = begin; v < end; v++) {
+      int i = offsets[v];
+      for (const auto& w : neighbors(v))
+        targets[i++] = Other(w);
+    }
+  });
+  return CompactDigraph(V, std::move(offsets), std::move(targets));
+}
+}
+
+CC::CC(const Graph& G, int threads) :
+  CC(Symmetric(G.V(), [&G](int v) -> const vector<int>& { return G.adj(v); }, threads),
+     threads) {}
+
+CC::CC(const EdgeWeightedGraph& G, int threads) :
+  CC(Symmetric(G.V(), [&G](int v) { return G.adj(v); }, threads), threads) {}
+
+CC::CC(const CompactDigraph& G, int threads) :
+  CC(G, threads > 1 ? Backend::kAfforest : Backend::kDepthFirst, threads) {}
+
+CC::CC(const CompactDigraph& G, Backend backend, int threads) {
+  if (backend == Backend::kAfforest) Afforest(G, threads);
+  else                               DepthFirst(G);
+}
+
+void CC::DepthFirst(const CompactDigraph& G) {
+  int V = G.V();
+  id_.assign(V, 0);
+  vector<bool> marked(V);
+  DepthFirstTraversal<CompactDigraph> dfs(G);
+  for (int s = 0; s < V; s++) {
+    if (marked[s]) continue;
+    struct Visitor {
+      CC& cc;
+      void PreVisit(int v) {
+        cc.id_[v] = cc.count() - 1;
+        cc.size_.back()++;
+      }
+    };
+    size_.push_back(0);
+    dfs.Run(s, marked, Visitor{*this});
+  }
+}
+
+void CC::Afforest(const CompactDigraph& G, int threads) {
+  int V = G.V();
+  const vector<int>& offsets = G.offsets();
+  const vector<int>& targets = G.targets();
+  vector<int> parent(V);
+  ParallelFor(V, ThreadsFor(V, threads), [&](int begin, int end) {
+    for (int v = begin; v < end; v++)
+      parent[v] = v;
+  });
+
+  // link each vertex with its first neighbors, a round at a time
+  int t = ThreadsFor(G.E(), threads);
+  bool shared = t > 1;
+  for (int r = 0; r < kNeighborRounds; r++) {
+    ParallelFor(V, t, [&](int begin, int end) {
+      for (int v = begin; v < end; v++)
+        if (r < offsets[v + 1] - offsets[v]) Link(parent, v, targets[offsets[v] + r], shared);
+    });
+    Compress(parent, threads);
+  }
+
+  // the tree most of the sampled vertices are in, most likely the largest
+  int largest = 0;
+  if (V > 0) {
+    std::unordered_map<int, int> samples;
+    std::mt19937 random(27491095);
+    for (int i = 0; i < kSamples; i++)
+      samples[parent[random() % V]]++;
+    largest = std::ranges::max_element(samples, {}, [](const auto& p) { return p.second; })->first;
+  }
+
+  // link along the remaining edges, but not from the largest tree: an edge
+  // from it to another tree is also an edge from that tree to it. The
+  // threads take chunks of vertices as they go, since a few vertices may
+  // hold most of the edges
+  std::atomic<int> next{0};
+  ParallelInvoke(t, [&](int) {
+    for (int begin = next.fetch_add(kChunk); begin < V; begin = next.fetch_add(kChunk)) {
+      int end = std::min(V, begin + kChunk);
+      for (int v = begin; v < end; v++) {
+        if (Load(parent, v, shared) == largest) continue;
+        for (int i = offsets[v] + kNeighborRounds; i < offsets[v + 1]; i++)
+          Link(parent, v, targets[i], shared);
+      }
+    }
+  });
+  Compress(parent, threads);
+
+  Number(parent);
+}
+
+void CC::Number(const vector<int>& root) {
+  int V = root.size();
+  id_.resize(V);
+  for (int v = 0; v < V; v++) {
+    if (root[v] == v) {
+      id_[v] = count();
+      size_.push_back(0);
+    } else {
+      id_[v] = id_[root[v]];
+    }
+    size_[id_[v]]++;
+  }
+}
+
+int CC::id(int v) const {
+  ValidateVertex(v);
+  return id_[v];
+}
+
+int CC::size(int v) const {
+  ValidateVertex(v);
+  return size_[id_[v]];
+}
+
+bool CC::connected(int v, int w) const {
+  ValidateVertex(v);
+  ValidateVertex(w);
+  return id_[v] == id_[w];
+}
+
+void CC::ValidateVertex(int v) const {
+  int V = id_.size();
+  if (v < 0 || v >= V)
+    throw std::invalid_argument("vertex " + to_string(v) + " is not between 0 and " + to_string(V-1));
+}
+}
+
+/**
+ * Unit tests the {@code CC} data type.
+ *
+ * @param args the command-line arguments
+ */
+#ifdef Debug
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+#include "graph_generator.h"
+
+using namespace algs4;
+using Clock = std::chrono::steady_clock;
+
+double MillisSince(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// the digraph with both v->w and w->v for each edge v->w of G
+CompactDigraph Symmetrize(const CompactDigraph& G) {
+  CompactDigraph reverse = G.Reverse();
+  vector<int> offsets(G.V() + 1), targets;
+  targets.reserve(2 * static_cast<size_t>(G.E()));
+  for (int v = 0; v < G.V(); v++) {
+    targets.insert(targets.end(), G.Adj(v).begin(), G.Adj(v).end());
+    targets.insert(targets.end(), reverse.Adj(v).begin(), reverse.Adj(v).end());
+    offsets[v + 1] = static_cast<int>(targets.size());
+  }
+  return CompactDigraph(G.V(), std::move(offsets), std::move(targets));
+}
+
+// compares the backends on an R-MAT graph
+int Benchmark(int scale, int E, uint64_t seed, int threads) {
+  CompactDigraph G = Symmetrize(GenerateDigraph(GraphModel::RMat(scale, E, seed), threads));
+  printf("rmat: %d vertices, %d edges\n", G.V(), G.E() / 2);
+
+  Clock::time_point start = Clock::now();
+  CC expected(G, CC::Backend::kDepthFirst);
+  double time = MillisSince(start);
+  int largest = 0;
+  for (int v = 0; v < G.V(); v++)
+    largest = std::max(largest, expected.size(v));
+  printf("depth-first        %8.1f ms, %d components, largest %d\n",
+         time, expected.count(), largest);
+
+  bool agree = true;
+  for (int t = 1; t <= threads; t *= 2) {
+    start = Clock::now();
+    CC cc(G, CC::Backend::kAfforest, t);
+    time = MillisSince(start);
+    bool same = cc.count() == expected.count();
+    for (int v = 0; v < G.V() && same; v++)
+      same = cc.id(v) == expected.id(v) && cc.size(v) == expected.size(v);
+    printf("afforest           %8.1f ms, %d threads, %s\n", time, t, same ? "agree" : "differ");
+    agree = agree && same;
+  }
+  return agree ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc > 2) {
+    return Benchmark(std::stoi(argv[1]), std::stoi(argv[2]), std::stoull(argv[3]),
+                     argc > 4 ? std::stoi(argv[4]) : DefaultThreads());
+  }
+  std::fstream in(argv[1]);
+  if (!in.is_open()) {
+    std::cout << "failed to open " << argv[1] << '\n';
+    return 1;
+  }
+  Graph G(in);
+  CC cc(G);
+
+  // number of connected components
+  int m = cc.count();
+  std::cout << m << " components" << std::endl;
+
+  // compute list of vertices in each connected component
+  vector<vector<int>> components(m);
+  for (int v = 0; v < G.V(); v++)
+    components[cc.id(v)].push_back(v);
+
+  // print results
+  for (int i = 0; i < m; i++) {
+    for (int v : components[i])
+      std::cout << v << " ";
+    std::cout << std::endl;
+  }
+
+  return 0;
+}
+#endif
@@ -0,0 +1,165 @@
+/**
+ *  The {@code CC} class represents a data type for
+ *  determining the connected components in an undirected graph.
+ *  The <em>id</em> operation determines in which connected component
+ *  a given vertex lies; the <em>connected</em> operation
+ *  determines whether two vertices are in the same connected component;
+ *  the <em>count</em> operation determines the number of connected
+ *  components; and the <em>size</em> operation determines the number
+ *  of vertices in the connect component containing a given vertex.
+ *  <p>
+ *  The <em>component identifier</em> of a connected component is one of the
+ *  vertices in the connected component: two vertices have the same component
+ *  identifier if and only if they are in the same connected component.
+ *  Here the components are numbered 0 to <em>count</em> - 1 in increasing
+ *  order of their least vertex, as the textbook depth-first search from
+ *  vertex 0, 1, 2, ... numbers them, whichever backend computes them.
+ *  <p>
+ *  The graph is first laid out in compressed sparse row form, each edge in
+ *  the adjacency lists of both its endpoints. There are two backends:
+ *  <ul>
+ *  <li> {@code kDepthFirst}: depth-first search, one component after the
+ *       other, on one thread.
+ *  <li> {@code kAfforest}: Sutton, Ben-Nun and Barak's Afforest
+ *       ("Optimizing Parallel Graph Connectivity Computation via Subgraph
+ *       Sampling", IPDPS 2018), a Shiloach&ndash;Vishkin style union-find
+ *       in which the threads hook the root of one tree under the lesser
+ *       root of another with compare-and-swap, and halve paths between
+ *       rounds. It first links each vertex with its first two neighbors
+ *       only, which is enough to gather most of the vertices of a large
+ *       component into one tree; it then finds that tree by sampling, and
+ *       skips the remaining edges of the vertices in it, which are most of
+ *       the edges.
+ *  </ul>
+ *  The constructors that take no backend use Afforest when given more than
+ *  one thread, and depth-first search otherwise.
+ *  <p>
+ *  This implementation takes &Theta;(<em>V</em> + <em>E</em>) time in the
+ *  worst case, where <em>V</em> is the number of vertices and <em>E</em>
+ *  is the number of edges; the Afforest backend runs in time close to
+ *  <em>V</em> + <em>E</em> / <em>threads</em> in practice.
+ *  Afterwards, the <em>id</em>, <em>count</em>, <em>connected</em>,
+ *  and <em>size</em> operations take constant time.
+ *  It uses &Theta;(<em>V</em>) extra space, besides the
+ *  &Theta;(<em>V</em> + <em>E</em>) of the compressed graph.
+ *  <p>
+ *  For additional documentation, see
+ *  <a href="https://algs4.cs.princeton.edu/41graph">Section 4.1</a>
+ *  of <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
+ *
+ *  @author Robert Sedgewick
+ *  @author Kevin Wayne
+ */
+
+#ifndef CC_H_
+#define CC_H_
+
+#include <vector>
+
+#include "compact_digraph.h"
+#include "edge_weighted_graph.h"
+#include "graph.h"
+#include "parallel.h"
+
+namespace algs4 {
+class CC {
+public:
+  /**
+   * The algorithm that labels the components.
+   */
+  enum class Backend {
+    kDepthFirst,    // depth-first search, on one thread
+    kAfforest,      // sampled union-find, on any number of threads
+  };
+
+  /**
+   * Computes the connected components of the undirected graph {@code G}.
+   *
+   * @param G the undirected graph
+   * @param threads the number of threads
+   */
+  CC(const Graph& G, int threads = DefaultThreads());
+  /**
+   * Computes the connected components of the edge-weighted graph {@code G}.
+   *
+   * @param G the edge-weighted graph
+   * @param threads the number of threads
+   */
+  CC(const EdgeWeightedGraph& G, int threads = DefaultThreads());
+  /**
+   * Computes the connected components of the undirected graph {@code G},
+   * given in compressed sparse row form: each edge v-w must be both in the
+   * adjacency list of v and in that of w.
+   *
+   * @param G the undirected graph, as a symmetric digraph
+   * @param threads the number of threads
+   */
+  CC(const CompactDigraph& G, int threads = DefaultThreads());
+  /**
+   * Computes the connected components of the undirected graph {@code G},
+   * given as a symmetric digraph, with the backend {@code backend}.
+   *
+   * @param G the undirected graph, as a symmetric digraph
+   * @param backend the backend
+   * @param threads the number of threads, if the backend is {@code kAfforest}
+   */
+  CC(const CompactDigraph& G, Backend backend, int threads = DefaultThreads());
+  CC() = delete;
+  CC(const CC& other) = default;
+  CC &operator=(const CC& other) = default;
+  CC(CC&& other) = default;
+  CC &operator=(CC&& other) = default;
+
+  /**
+   * Returns the component id of the connected component containing vertex {@code v}.
+   *
+   * @param  v the vertex
+   * @return the component id of the connected component containing vertex {@code v}
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   */
+  int id(int v) const;
+  /**
+   * Returns the number of vertices in the connected component containing vertex {@code v}.
+   *
+   * @param  v the vertex
+   * @return the number of vertices in the connected component containing vertex {@code v}
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   */
+  int size(int v) const;
+  /**
+   * Returns the number of connected components in the graph {@code G}.
+   *
+   * @return the number of connected components in the graph {@code G}
+   */
+  int count() const { return static_cast<int>(size_.size()); }
+  /**
+   * Returns true if vertices {@code v} and {@code w} are in the same
+   * connected component.
+   *
+   * @param  v one vertex
+   * @param  w the other vertex
+   * @return {@code true} if vertices {@code v} and {@code w} are in the same
+   *         connected component; {@code false} otherwise
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   * @throws IllegalArgumentException unless {@code 0 <= w < V}
+   */
+  bool connected(int v, int w) const;
+
+private:
+  // label the components by depth-first search
+  void DepthFirst(const CompactDigraph& G);
+  // label the components with Afforest
+  void Afforest(const CompactDigraph& G, int threads);
+  // number the components in order of their least vertex, given for
+  // each vertex the least vertex of its component
+  void Number(const std::vector<int>& root);
+  // throw an IllegalArgumentException unless {@code 0 <= v < V}
+  void ValidateVertex(int v) const;
+
+private:
+  std::vector<int> id_;     // id_[v] = id of connected component containing v
+  std::vector<int> size_;   // size_[id] = number of vertices in given component
+};
+}
+
+#endif  // CC_H_
@@ -0,0 +1,161 @@
+/******************************************************************************
+ *  Compilation:  clang++ -c -O2 digraph.cc -std=c++20
+ *                clang++ -DDebug -O2 compact_digraph.cc digraph.o -std=c++20 -o compact_digraph
+ *  Execution:    ./compact_digraph filename.txt
+ *  Dependencies: digraph.cc
+ *  Data files:   https://algs4.cs.princeton.edu/42digraph/tinyDG.txt
+ *                https://algs4.cs.princeton.edu/42digraph/mediumDG.txt
+ *                https://algs4.cs.princeton.edu/42digraph/largeDG.txt
+ *
+ *  An immutable digraph, implemented using compressed sparse rows.
+ *  Parallel edges and self-loops are permitted.
+ *
+ *  % ./compact_digraph tinyDG.txt
+ *  13 vertices, 22 edges
+ *  0: 1 5
+ *  1:
+ *  2: 3 0
+ *  3: 2 5
+ *  4: 2 3
+ *  5: 4
+ *  6: 0 8 4 9
+ *  7: 9 6
+ *  8: 6
+ *  9: 10 11
+ *  10: 12
+ *  11: 12 4
+ *  12: 9
+ *  ...
+ *
+ ******************************************************************************/
+
+#include "compact_digraph.h"
+
+#include <stdexcept>
+
+#include "digraph.h"
+
+using std::vector;
+using std::string;
+
+namespace algs4 {
+/**
+ * Initializes a compact snapshot of the digraph {@code G}.
+ *
+ * @param  G the digraph
+ */
+CompactDigraph::CompactDigraph(const Digraph& G) : v_(G.V()), offsets_(G.V() + 1),
+                                                            indegree_(G.V()) {
+  for (int v = 0; v < v_; v++) {
+    offsets_[v + 1] = offsets_[v] + G.Outdegree(v);
+    indegree_[v] = G.Indegree(v);
+  }
+  targets_.reserve(offsets_[v_]);
+  for (int v = 0; v < v_; v++) {
+    const vector<int>& adj = G.Adj(v);
+    targets_.insert(targets_.end(), adj.cbegin(), adj.cend());
+  }
+}
+
+/**
+ * Initializes a compact digraph from its CSR arrays.
+ *
+ * @param  V the number of vertices
+ * @param  offsets the <em>V</em> + 1 row offsets into {@code targets}
+ * @param  targets the head vertex of each edge, grouped by tail vertex
+ * @throws IllegalArgumentException if {@code V < 0}
+ * @throws IllegalArgumentException if {@code offsets} is not a nondecreasing
+ *         array of length <em>V</em> + 1 starting at 0 and ending at
+ *         {@code targets.size()}
+ * @throws IllegalArgumentException unless {@code 0 <= w < V} for every
+ *         entry {@code w} of {@code targets}
+ */
+CompactDigraph::CompactDigraph(int V, vector<int> offsets, vector<int> targets) :
+  v_(V), offsets_(std::move(offsets)), targets_(std::move(targets)) {
+  if (V < 0)
+    throw std::invalid_argument("Number of vertices in a Digraph must be nonnegative");
+  if (offsets_.size() != static_cast<size_t>(V) + 1 || offsets_[0] != 0 ||
+      offsets_[V] != static_cast<int>(targets_.size()))
+    throw std::invalid_argument("offsets do not describe " + std::to_string(targets_.size()) +
+                                " edges over " + std::to_string(V) + " vertices");
+  for (int v = 0; v < V; v++) {
+    if (offsets_[v] > offsets_[v + 1])
+      throw std::invalid_argument("offsets are not nondecreasing at vertex " +
+                                  std::to_string(v));
+  }
+  for (int w : targets_) {
+    if (w < 0 || w >= V)
+      throw std::invalid_argument("vertex " + std::to_string(w) +
+                                  " is not between 0 and " + std::to_string(V-1));
+  }
+  CountIndegrees();
+}
+
+// recompute indegree_ from targets_
+void CompactDigraph::CountIndegrees() {
+  indegree_.assign(v_, 0);
+  for (int w : targets_) ++indegree_[w];
+}
+
+/**
+ * Returns the reverse of the digraph.
+ *
+ * @return the reverse of the digraph
+ */
+CompactDigraph CompactDigraph::Reverse() const {
+  // the indegrees of this digraph are the outdegrees of its reverse
+  vector<int> offsets(v_ + 1);
+  for (int v = 0; v < v_; v++)
+    offsets[v + 1] = offsets[v] + indegree_[v];
+
+  // scatter in increasing tail order, matching Digraph::Reverse()
+  vector<int> next(offsets.cbegin(), offsets.cend() - 1);
+  vector<int> targets(targets_.size());
+  for (int v = 0; v < v_; v++)
+    for (int w : Adj(v))
+      targets[next[w]++] = v;
+
+  return CompactDigraph(v_, std::move(offsets), std::move(targets));
+}
+
+/**
+ * Returns a string representation of the graph.
+ *
+ * @return the number of vertices <em>V</em>, followed by the number of edges <em>E</em>,
+ *         followed by the <em>V</em> adjacency lists
+ */
+string CompactDigraph::ToString() const {
+  string s =
+    std::to_string(v_) + " vertices, " + std::to_string(E()) + " edges \n";
+  for (int v = 0; v < v_; v++) {
+    s += std::to_string(v) + ": ";
+    for (int w : Adj(v)) s += std::to_string(w) + " ";
+    s += "\n";
+  }
+
+  return s;
+}
+}
+
+/**
+ * Unit tests the {@code CompactDigraph} data type.
+ *
+ * @param args the command-line arguments
+ */
+#ifdef Debug
+#include <iostream>
+#include <fstream>
+using namespace algs4;
+int main(int args, char *argv[]) {
+  std::fstream in(argv[1]);
+  if (!in.is_open()) {
+    std::cout << "failed to open " << argv[1] << '\n';
+    return 1;
+  }
+
+  Digraph G(in);
+  CompactDigraph compact = G.Freeze();
+  printf("%s\n", compact.ToString().c_str());
+  printf("reverse:\n%s\n", compact.Reverse().ToString().c_str());
+}
+#endif
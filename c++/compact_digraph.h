@@ -0,0 +1,179 @@
+#ifndef COMPACT_DIGRAPH_H_
+#define COMPACT_DIGRAPH_H_
+
+#include <vector>
+#include <span>
+#include <string>
+#include <utility>
+
+#include "digraph.h"
+#include "graph_concepts.h"
+
+/**
+ *  The {@code CompactDigraph} class represents an immutable digraph of
+ *  vertices named 0 through <em>V</em> - 1, stored in compressed sparse
+ *  row (CSR) form: a single {@code offsets} array of length <em>V</em> + 1
+ *  and a single {@code targets} array of length <em>E</em>, so that the
+ *  vertices adjacent from <em>v</em> are
+ *  {@code targets[offsets[v]]} through {@code targets[offsets[v+1] - 1]}.
+ *  <p>
+ *  A {@code CompactDigraph} is usually obtained from {@link Digraph#Freeze()}
+ *  once a digraph has been built. It keeps the adjacency lists in the
+ *  same order as the source digraph, so every traversal visits vertices in
+ *  the same order as it would on the {@link Digraph}.
+ *  <p>
+ *  Unlike {@link Digraph}, the per-vertex accessors do not validate their
+ *  argument; they are meant for the inner loops of graph algorithms that
+ *  only ever pass vertices between 0 and <em>V</em> - 1.
+ *  All operations take constant time. Construction and {@code Reverse()}
+ *  take time proportional to <em>V</em> + <em>E</em>.
+ *  <p>
+ *  For additional documentation,
+ *  see <a href="https://algs4.cs.princeton.edu/42digraph">Section 4.2</a> of
+ *  <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
+ */
+
+namespace algs4 {
+
+class CompactDigraph {
+public:
+  /**
+   * Initializes a compact snapshot of the digraph {@code G}.
+   *
+   * @param  G the digraph
+   */
+  CompactDigraph(const Digraph& G);
+  /**
+   * Initializes a compact digraph from its CSR arrays.
+   *
+   * @param  V the number of vertices
+   * @param  offsets the <em>V</em> + 1 row offsets into {@code targets}
+   * @param  targets the head vertex of each edge, grouped by tail vertex
+   * @throws IllegalArgumentException if {@code V < 0}
+   * @throws IllegalArgumentException if {@code offsets} is not a nondecreasing
+   *         array of length <em>V</em> + 1 starting at 0 and ending at
+   *         {@code targets.size()}
+   * @throws IllegalArgumentException unless {@code 0 <= w < V} for every
+   *         entry {@code w} of {@code targets}
+   */
+  CompactDigraph(int V, std::vector<int> offsets, std::vector<int> targets);
+  CompactDigraph() = delete;
+  CompactDigraph(const CompactDigraph& other) = default;
+  CompactDigraph &operator=(const CompactDigraph& other) = default;
+  CompactDigraph(CompactDigraph&& other) = default;
+  CompactDigraph &operator=(CompactDigraph&& other) = default;
+  /**
+   * Returns the number of vertices in this digraph.
+   *
+   * @return the number of vertices in this digraph
+   */
+  int V() const { return v_; }
+  /**
+   * Returns the number of edges in this digraph.
+   *
+   * @return the number of edges in this digraph
+   */
+  int E() const { return static_cast<int>(targets_.size()); }
+  /**
+   * Returns the vertices adjacent from vertex {@code v} in this digraph.
+   * The vertex is not validated.
+   *
+   * @param  v the vertex, between 0 and <em>V</em> - 1
+   * @return the vertices adjacent from vertex {@code v}, as a contiguous range
+   */
+  std::span<const int> Adj(int v) const {
+    return { targets_.data() + offsets_[v], targets_.data() + offsets_[v + 1] };
+  }
+  /**
+   * Returns the number of directed edges incident from vertex {@code v}.
+   * The vertex is not validated.
+   *
+   * @param  v the vertex, between 0 and <em>V</em> - 1
+   * @return the outdegree of vertex {@code v}
+   */
+  int Outdegree(int v) const { return offsets_[v + 1] - offsets_[v]; }
+  /**
+   * Returns the number of directed edges incident to vertex {@code v}.
+   * The vertex is not validated.
+   *
+   * @param  v the vertex, between 0 and <em>V</em> - 1
+   * @return the indegree of vertex {@code v}
+   */
+  int Indegree(int v) const { return indegree_[v]; }
+  /**
+   * Returns the row offsets of this digraph.
+   *
+   * @return the <em>V</em> + 1 offsets into {@code targets()}
+   */
+  const std::vector<int>& offsets() const { return offsets_; }
+  /**
+   * Returns the head vertices of all edges, grouped by tail vertex.
+   *
+   * @return the <em>E</em> edge targets
+   */
+  const std::vector<int>& targets() const { return targets_; }
+  /**
+   * Returns the reverse of the digraph.
+   *
+   * @return the reverse of the digraph
+   */
+  CompactDigraph Reverse() const;
+  /**
+   * Returns a string representation of the graph.
+   *
+   * @return the number of vertices <em>V</em>, followed by the number of edges <em>E</em>,
+   *         followed by the <em>V</em> adjacency lists
+   */
+  std::string ToString() const;
+private:
+  // recompute indegree_ from targets_
+  void CountIndegrees();
+private:
+  int v_;                           // number of vertices in this digraph
+  std::vector<int> offsets_;        // targets_[offsets_[v]..offsets_[v+1]) = adjacency list of v
+  std::vector<int> targets_;        // head vertices, grouped by tail vertex
+  std::vector<int> indegree_;       // indegree_[v] = indegree of vertex v
+};
+
+/**
+ * Returns the reverse of the digraph {@code G}, which may be any adjacency
+ * digraph or edge-weighted digraph, as a compact digraph. Each reversed
+ * adjacency list is in increasing order of tail vertex, as in
+ * {@link Digraph#Reverse()}.
+ *
+ * @param  G the digraph
+ * @return the reverse of the digraph
+ */
+template <DirectedGraph Graph>
+CompactDigraph ReverseOf(const Graph& G) {
+  int V = G.V();
+  std::vector<int> offsets(V + 1);
+  for (int v = 0; v < V; v++)
+    for (int w : Heads(G, v))
+      ++offsets[w + 1];
+  for (int v = 0; v < V; v++)
+    offsets[v + 1] += offsets[v];
+
+  std::vector<int> next(offsets.cbegin(), offsets.cend() - 1);
+  std::vector<int> targets(offsets[V]);
+  for (int v = 0; v < V; v++)
+    for (int w : Heads(G, v))
+      targets[next[w]++] = v;
+
+  return CompactDigraph(V, std::move(offsets), std::move(targets));
+}
+
+/**
+ * Returns an immutable compressed-sparse-row snapshot of this digraph.
+ * Later calls to {@code AddEdge} do not affect the snapshot.
+ * Defined here rather than in digraph.cc, so that only the callers of
+ * {@code Freeze()} link compact_digraph.o.
+ *
+ * @return the digraph as a {@link CompactDigraph}
+ */
+inline CompactDigraph Digraph::Freeze() const {
+  return CompactDigraph(*this);
+}
+}
+
+#endif  // COMPACT_DIGRAPH_H_
@@ -0,0 +1,338 @@
+/******************************************************************************
+ *  Compilation:  clang++ -c -O2 digraph.cc -std=c++20
+ *                clang++ -c -O2 compact_digraph.cc -std=c++20
+ *                clang++ -c -O2 directed_edge.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_digraph.cc -std=c++20
+ *                clang++ -c -O2 depth_first_order.cc -std=c++20
+ *                clang++ -c -O2 directed_dfs.cc -std=c++20
+ *                clang++ -c -O2 tarjan_scc.cc -std=c++20
+ *                clang++ -c -O2 transitive_closure.cc -std=c++20
+ *                clang++ -c -O2 kosaraju_sharir_scc.cc -std=c++20
+ *                clang++ -DDebug -O2 compressed_digraph.cc digraph.o compact_digraph.o directed_edge.o edge_weighted_digraph.o depth_first_order.o directed_dfs.o tarjan_scc.o transitive_closure.o kosaraju_sharir_scc.o -std=c++20 -pthread -o compressed_digraph
+ *  Execution:    ./compressed_digraph filename.txt
+ *  Dependencies: digraph.cc compact_digraph.cc depth_first_order.cc
+ *                directed_dfs.cc kosaraju_sharir_scc.cc
+ *  Data files:   https://algs4.cs.princeton.edu/42digraph/tinyDG.txt
+ *                https://algs4.cs.princeton.edu/42digraph/mediumDG.txt
+ *                https://algs4.cs.princeton.edu/42digraph/largeDG.txt
+ *
+ *  An immutable digraph whose sorted adjacency lists are stored as
+ *  gap-encoded variable-length integers, copied from a digraph or built from
+ *  a stream of edges in order of tail vertex.
+ *  Parallel edges and self-loops are permitted.
+ *
+ *  % ./compressed_digraph tinyDG.txt
+ *  13 vertices, 22 edges
+ *  0: 1 5
+ *  1:
+ *  2: 0 3
+ *  3: 2 5
+ *  4: 2 3
+ *  5: 4
+ *  6: 0 4 8 9
+ *  7: 6 9
+ *  8: 6
+ *  9: 10 11
+ *  10: 12
+ *  11: 4 12
+ *  12: 9
+ *
+ *  13 vertices, 22 edges: 95 bytes compressed, 144 bytes compact (1.52x)
+ *  ...
+ *
+ *  On a digraph whose edges mostly join vertices with nearby ids, 1 thread:
+ *
+ *  % ./compressed_digraph webDG.txt
+ *  1000000 vertices, 11491794 edges: 20884696 bytes compressed, 49967180 bytes compact (2.39x)
+ *                     compact ms  compressed ms
+ *  DirectedDFS             328.8          304.1
+ *  DepthFirstOrder         387.9          316.4
+ *  KosarajuSharirSCC       932.0         1077.5
+ *
+ ******************************************************************************/
+
+#include "compressed_digraph.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "compact_digraph.h"
+#include "digraph.h"
+
+using std::vector;
+using std::string;
+
+namespace algs4 {
+namespace {
+// appends x to out as a variable-length integer
+void WriteVarint(vector<uint8_t>& out, uint32_t x) {
+  while (x >= 0x80) {
+    out.push_back(static_cast<uint8_t>(x | 0x80));
+    x >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(x));
+}
+
+// maps 0, -1, 1, -2, 2, ... to 0, 1, 2, 3, 4, ...
+uint32_t Zigzag(int x) {
+  return (static_cast<uint32_t>(x) << 1) ^ static_cast<uint32_t>(x >> 31);
+}
+}
+
+/**
+ * Initializes a compressed copy of the digraph {@code G}.
+ *
+ * @param  G the digraph
+ * @param  threads the number of threads to encode with
+ */
+CompressedDigraph::CompressedDigraph(const Digraph& G, int threads) : v_(G.V()), e_(G.E()) {
+  Encode(G, threads);
+}
+
+/**
+ * Initializes a compressed copy of the compact digraph {@code G}.
+ *
+ * @param  G the compact digraph
+ * @param  threads the number of threads to encode with
+ */
+CompressedDigraph::CompressedDigraph(const CompactDigraph& G, int threads) :
+  v_(G.V()), e_(G.E()) {
+  Encode(G, threads);
+}
+
+// sort and encode the adjacency lists of G into the index and bytes_
+template <typename Graph>
+void CompressedDigraph::Encode(const Graph& G, int threads) {
+  // each thread encodes a range of vertices into its own buffer, recording
+  // where each list starts relative to the start of the buffer
+  int parts = std::clamp(v_, 1, std::max(threads, 1));
+  auto part_begin = [&](int p) { return static_cast<int>(static_cast<long long>(v_) * p / parts); };
+  vector<vector<uint8_t>> buffers(parts);
+  vector<uint64_t> starts(v_);
+  ParallelInvoke(parts, [&](int p) {
+    vector<int> list;
+    vector<uint8_t>& out = buffers[p];
+    for (int v = part_begin(p); v < part_begin(p + 1); v++) {
+      auto&& adj = G.Adj(v);
+      list.assign(adj.begin(), adj.end());
+      std::sort(list.begin(), list.end());
+      starts[v] = out.size();
+      WriteVarint(out, list.size());
+      for (size_t i = 0; i < list.size(); i++)
+        WriteVarint(out, i == 0 ? Zigzag(list[0] - v) : list[i] - list[i - 1]);
+    }
+  });
+
+  uint64_t base = 0;
+  for (int p = 0; p < parts; p++) {
+    for (int v = part_begin(p); v < part_begin(p + 1); v++)
+      starts[v] += base;
+    base += buffers[p].size();
+  }
+  block_offsets_.resize((v_ >> kBlockBits) + 1);
+  offsets_.resize(v_);
+  for (int v = 0; v < v_; v++)
+    Locate(v, starts[v]);
+
+  bytes_.reserve(base);
+  for (vector<uint8_t>& buffer : buffers) {
+    bytes_.insert(bytes_.end(), buffer.cbegin(), buffer.cend());
+    vector<uint8_t>().swap(buffer);
+  }
+}
+
+// record that the adjacency list of v starts at bytes_[start]; called in
+// increasing order of v
+void CompressedDigraph::Locate(int v, uint64_t start) {
+  uint64_t& block = block_offsets_[v >> kBlockBits];
+  if ((v & ((1 << kBlockBits) - 1)) == 0) block = start;
+  if (start - block > UINT32_MAX)
+    throw std::invalid_argument("adjacency lists near vertex " + std::to_string(v) +
+                                " take more than 4 GB");
+  offsets_[v] = start - block;
+}
+
+/**
+ * Initializes a builder for a digraph with {@code V} vertices and no edges.
+ *
+ * @param  V the number of vertices
+ * @throws IllegalArgumentException if {@code V < 0}
+ */
+CompressedDigraph::Builder::Builder(int V) : graph_(V) {
+  if (V < 0) throw std::invalid_argument("Number of vertices in a Digraph must be non-negative");
+  graph_.block_offsets_.resize((V >> kBlockBits) + 1);
+  graph_.offsets_.resize(V);
+}
+
+/**
+ * Adds the directed edge v->w.
+ *
+ * @param  v the tail vertex
+ * @param  w the head vertex
+ * @throws IllegalArgumentException unless both {@code 0 <= v < V} and {@code 0 <= w < V}
+ * @throws IllegalArgumentException if {@code v} is less than the tail of the previous edge
+ * @throws IllegalArgumentException if there are more than {@code INT_MAX} edges
+ */
+void CompressedDigraph::Builder::AddEdge(int v, int w) {
+  int V = graph_.v_;
+  if (v < 0 || v >= V || w < 0 || w >= V)
+    throw std::invalid_argument("edge " + std::to_string(v) + "->" + std::to_string(w) +
+                                " is not between 0 and " + std::to_string(V - 1));
+  if (v < tail_)
+    throw std::invalid_argument("edge " + std::to_string(v) + "->" + std::to_string(w) +
+                                " comes after an edge from " + std::to_string(tail_));
+  if (graph_.e_ == INT_MAX)
+    throw std::invalid_argument("more than " + std::to_string(INT_MAX) + " edges");
+  while (tail_ < v)
+    Flush();
+  list_.push_back(w);
+  ++graph_.e_;
+}
+
+// encode the adjacency list of tail_ and move on to the next vertex
+void CompressedDigraph::Builder::Flush() {
+  vector<uint8_t>& out = graph_.bytes_;
+  std::sort(list_.begin(), list_.end());
+  graph_.Locate(tail_, out.size());
+  WriteVarint(out, list_.size());
+  for (size_t i = 0; i < list_.size(); i++)
+    WriteVarint(out, i == 0 ? Zigzag(list_[0] - tail_) : list_[i] - list_[i - 1]);
+  list_.clear();
+  ++tail_;
+}
+
+/**
+ * Returns the digraph of the edges added. The builder is left empty.
+ *
+ * @return the compressed digraph
+ */
+CompressedDigraph CompressedDigraph::Builder::Build() {
+  while (tail_ < graph_.v_)
+    Flush();
+  graph_.bytes_.shrink_to_fit();
+  CompressedDigraph G = std::move(graph_);
+  graph_ = CompressedDigraph(0);
+  graph_.block_offsets_.resize(1);
+  tail_ = 0;
+  return G;
+}
+
+/**
+ * Returns the reverse of the digraph.
+ *
+ * @param  threads the number of threads to encode with
+ * @return the reverse of the digraph
+ */
+CompressedDigraph CompressedDigraph::Reverse(int threads) const {
+  vector<int> offsets(v_ + 1);
+  for (int v = 0; v < v_; v++)
+    for (int w : Adj(v))
+      ++offsets[w + 1];
+  for (int v = 0; v < v_; v++)
+    offsets[v + 1] += offsets[v];
+
+  // scattering in increasing tail order leaves every list sorted
+  vector<int> next(offsets.cbegin(), offsets.cend() - 1);
+  vector<int> targets(e_);
+  for (int v = 0; v < v_; v++)
+    for (int w : Adj(v))
+      targets[next[w]++] = v;
+
+  return CompressedDigraph(CompactDigraph(v_, std::move(offsets), std::move(targets)), threads);
+}
+
+/**
+ * Returns a string representation of the graph.
+ *
+ * @return the number of vertices <em>V</em>, followed by the number of edges <em>E</em>,
+ *         followed by the <em>V</em> adjacency lists
+ */
+string CompressedDigraph::ToString() const {
+  string s =
+    std::to_string(v_) + " vertices, " + std::to_string(e_) + " edges \n";
+  for (int v = 0; v < v_; v++) {
+    s += std::to_string(v) + ": ";
+    for (int w : Adj(v)) s += std::to_string(w) + " ";
+    s += "\n";
+  }
+
+  return s;
+}
+}
+
+/**
+ * Unit tests the {@code CompressedDigraph} data type: prints the digraph if
+ * it is small, then compares its size and the running times of
+ * {@code DirectedDFS}, {@code DepthFirstOrder} and {@code KosarajuSharirSCC}
+ * against the same digraph as a {@code CompactDigraph}.
+ *
+ * @param args the command-line arguments
+ */
+#ifdef Debug
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+
+#include "depth_first_order.h"
+#include "directed_dfs.h"
+#include "kosaraju_sharir_scc.h"
+
+using namespace algs4;
+
+namespace {
+// milliseconds taken by f
+double Time(const std::function<void()>& f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+}
+
+int main(int args, char *argv[]) {
+  std::fstream in(argv[1]);
+  if (!in.is_open()) {
+    std::cout << "failed to open " << argv[1] << '\n';
+    return 1;
+  }
+
+  Digraph G(in);
+  CompactDigraph compact = G.Freeze();
+  CompressedDigraph compressed(compact);
+  if (G.V() <= 100) printf("%s\n", compressed.ToString().c_str());
+
+  // the same digraph, streamed edge by edge in order of tail vertex
+  CompressedDigraph::Builder builder(G.V());
+  for (int v = 0; v < G.V(); v++)
+    for (int w : G.Adj(v))
+      builder.AddEdge(v, w);
+  if (builder.Build().ToString() != compressed.ToString())
+    printf("built digraph differs from the compressed copy\n");
+
+  size_t compact_bytes = (compact.offsets().size() + compact.targets().size()) * sizeof(int);
+  printf("%d vertices, %d edges: %zu bytes compressed, %zu bytes compact (%.2fx)\n",
+         compressed.V(), compressed.E(), compressed.bytes(), compact_bytes,
+         static_cast<double>(compact_bytes) / compressed.bytes());
+
+  printf("                   compact ms  compressed ms\n");
+  int reached[2], components[2];
+  printf("DirectedDFS      %12.1f %14.1f\n",
+         Time([&] { reached[0] = DirectedDFS(compact, 0).count(); }),
+         Time([&] { reached[1] = DirectedDFS(compressed, 0).count(); }));
+  printf("DepthFirstOrder  %12.1f %14.1f\n",
+         Time([&] { DepthFirstOrder order(compact); }),
+         Time([&] { DepthFirstOrder order(compressed); }));
+  printf("KosarajuSharirSCC%12.1f %14.1f\n",
+         Time([&] { components[0] = KosarajuSharirSCC(compact).count(); }),
+         Time([&] { components[1] = KosarajuSharirSCC(compressed).count(); }));
+  if (reached[0] != reached[1] || components[0] != components[1])
+    printf("results differ: %d/%d reachable, %d/%d components\n",
+           reached[0], reached[1], components[0], components[1]);
+}
+#endif
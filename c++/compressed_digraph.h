@@ -0,0 +1,261 @@
+#ifndef COMPRESSED_DIGRAPH_H_
+#define COMPRESSED_DIGRAPH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "parallel.h"
+
+/**
+ *  The {@code CompressedDigraph} class represents an immutable digraph of
+ *  vertices named 0 through <em>V</em> - 1 whose adjacency lists are stored
+ *  compressed, so that a digraph takes less memory than as a
+ *  {@link CompactDigraph}. Vertex and edge counts are {@code int}s, as in
+ *  the other digraphs.
+ *  <p>
+ *  Each adjacency list is sorted and encoded as a byte string of
+ *  variable-length integers (7 bits per byte, low-order group first): the
+ *  outdegree, then the first head vertex as a signed difference from the
+ *  tail vertex, then the difference between each head vertex and the one
+ *  before it. Edges between vertices with nearby ids, as in crawl-ordered
+ *  web graphs or after a {@link VertexOrdering}, take one or two bytes
+ *  instead of four. The lists are located by a 64-bit byte offset for every
+ *  block of 64 vertices and a 32-bit offset into the block for each vertex,
+ *  so that, with an average outdegree of <em>d</em>, the index costs
+ *  about 4 / <em>d</em> bytes per edge.
+ *  <p>
+ *  A compressed digraph is built either as a copy of a {@link Digraph} or
+ *  {@link CompactDigraph}, or by a {@code Builder} from a stream of edges in
+ *  order of tail vertex, such as a file of edges sorted by tail. A builder
+ *  encodes each adjacency list as soon as the next tail vertex begins, so
+ *  that only one list is held uncompressed at a time.
+ *  <p>
+ *  {@code Adj(v)} returns a range whose iterator decodes the list as it
+ *  advances, so a range-based {@code for} loop over it reads just like one
+ *  over a {@link Digraph}: {@link DirectedDFS}, {@link DepthFirstOrder} and
+ *  {@link KosarajuSharirSCC} run on it with the same code. Because the
+ *  lists are sorted, vertices are visited in increasing order within each
+ *  list, which may differ from the insertion order of the source digraph.
+ *  <p>
+ *  The per-vertex accessors do not validate their argument.
+ *  {@code Outdegree(v)} takes constant time and iterating over the vertices
+ *  adjacent from <em>v</em> takes time proportional to their number.
+ *  Construction and {@code Reverse()} take time proportional to
+ *  <em>V</em> + <em>E</em> log <em>E</em>.
+ */
+
+namespace algs4 {
+
+class CompactDigraph;
+class Digraph;
+
+class CompressedDigraph {
+public:
+  /**
+   * The vertices adjacent from a vertex, decoded on the fly.
+   */
+  class Iterator {
+  public:
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+
+    Iterator() = default;
+    Iterator(const uint8_t* p, int v) : p_(p) {
+      left_ = ReadVarint(p_);
+      if (left_ > 0) w_ = v + Unzigzag(ReadVarint(p_));
+    }
+    int operator*() const { return w_; }
+    Iterator& operator++() {
+      if (--left_ > 0) w_ += ReadVarint(p_);
+      return *this;
+    }
+    void operator++(int) { ++*this; }
+    bool operator==(std::default_sentinel_t) const { return left_ == 0; }
+
+  private:
+    const uint8_t* p_{nullptr};  // the next unread byte
+    int left_{0};                // number of vertices not yet passed, including w_
+    int w_{0};                   // the current vertex
+  };
+
+  /**
+   * The range of vertices adjacent from a vertex.
+   */
+  class Neighbors {
+  public:
+    Neighbors(const uint8_t* p, int v) : p_(p), v_(v) {}
+    Iterator begin() const { return Iterator(p_, v_); }
+    std::default_sentinel_t end() const { return {}; }
+
+  private:
+    const uint8_t* p_;  // the encoded list
+    int v_;             // the tail vertex
+  };
+
+  /**
+   * Builds a compressed digraph from edges given in order of tail vertex.
+   */
+  class Builder;
+
+  /**
+   * Initializes a compressed copy of the digraph {@code G}.
+   *
+   * @param  G the digraph
+   * @param  threads the number of threads to encode with
+   */
+  explicit CompressedDigraph(const Digraph& G, int threads = DefaultThreads());
+  /**
+   * Initializes a compressed copy of the compact digraph {@code G}.
+   *
+   * @param  G the compact digraph
+   * @param  threads the number of threads to encode with
+   */
+  explicit CompressedDigraph(const CompactDigraph& G, int threads = DefaultThreads());
+  CompressedDigraph() = delete;
+  CompressedDigraph(const CompressedDigraph& other) = default;
+  CompressedDigraph &operator=(const CompressedDigraph& other) = default;
+  CompressedDigraph(CompressedDigraph&& other) = default;
+  CompressedDigraph &operator=(CompressedDigraph&& other) = default;
+  /**
+   * Returns the number of vertices in this digraph.
+   *
+   * @return the number of vertices in this digraph
+   */
+  int V() const { return v_; }
+  /**
+   * Returns the number of edges in this digraph.
+   *
+   * @return the number of edges in this digraph
+   */
+  int E() const { return e_; }
+  /**
+   * Returns the vertices adjacent from vertex {@code v} in this digraph,
+   * in increasing order. The vertex is not validated.
+   *
+   * @param  v the vertex, between 0 and <em>V</em> - 1
+   * @return the vertices adjacent from vertex {@code v}, as an iterable
+   */
+  Neighbors Adj(int v) const { return Neighbors(List(v), v); }
+  /**
+   * Returns the number of directed edges incident from vertex {@code v}.
+   * The vertex is not validated.
+   *
+   * @param  v the vertex, between 0 and <em>V</em> - 1
+   * @return the outdegree of vertex {@code v}
+   */
+  int Outdegree(int v) const {
+    const uint8_t* p = List(v);
+    return ReadVarint(p);
+  }
+  /**
+   * Returns the number of bytes this digraph occupies: the encoded lists
+   * and their index.
+   *
+   * @return the size of this digraph in bytes
+   */
+  size_t bytes() const {
+    return bytes_.size() + block_offsets_.size() * sizeof(uint64_t) +
+           offsets_.size() * sizeof(uint32_t);
+  }
+  /**
+   * Returns the reverse of the digraph.
+   *
+   * @param  threads the number of threads to encode with
+   * @return the reverse of the digraph
+   */
+  CompressedDigraph Reverse(int threads = DefaultThreads()) const;
+  /**
+   * Returns a string representation of the graph.
+   *
+   * @return the number of vertices <em>V</em>, followed by the number of edges <em>E</em>,
+   *         followed by the <em>V</em> adjacency lists
+   */
+  std::string ToString() const;
+
+private:
+  // an empty digraph with V vertices, to be filled in by a builder
+  explicit CompressedDigraph(int V) : v_(V) {}
+  // reads a variable-length integer at p and advances p past it
+  static uint32_t ReadVarint(const uint8_t*& p) {
+    uint32_t x = *p++;
+    if (x < 0x80) return x;
+    x &= 0x7f;
+    for (int shift = 7; ; shift += 7) {
+      uint32_t b = *p++;
+      x |= (b & 0x7f) << shift;
+      if (b < 0x80) return x;
+    }
+  }
+  // maps 0, -1, 1, -2, 2, ... back from 0, 1, 2, 3, 4, ...
+  static int Unzigzag(uint32_t x) { return static_cast<int>(x >> 1) ^ -static_cast<int>(x & 1); }
+  // the encoded adjacency list of v
+  const uint8_t* List(int v) const {
+    return bytes_.data() + block_offsets_[v >> kBlockBits] + offsets_[v];
+  }
+  // sort and encode the adjacency lists of G into the index and bytes_
+  template <typename Graph>
+  void Encode(const Graph& G, int threads);
+  // record that the adjacency list of v starts at bytes_[start]; called in
+  // increasing order of v
+  void Locate(int v, uint64_t start);
+
+private:
+  static constexpr int kBlockBits = 6;   // 64 vertices per block of the index
+  int v_;                                // number of vertices in this digraph
+  int e_{0};                             // number of edges in this digraph
+  // the adjacency list of v starts at bytes_[block_offsets_[v >> kBlockBits] + offsets_[v]]
+  std::vector<uint64_t> block_offsets_;
+  std::vector<uint32_t> offsets_;
+  std::vector<uint8_t> bytes_;           // encoded adjacency lists, in vertex order
+};
+
+/**
+ * Builds a compressed digraph from edges given in nondecreasing order of
+ * tail vertex; the edges from one tail vertex may come in any order.
+ */
+/**
+ * Builds a compressed digraph from edges given in nondecreasing order of
+ * tail vertex; the edges from one tail vertex may come in any order. It
+ * holds the encoded lists of the vertices before the current tail, and the
+ * heads of the edges from the current tail uncompressed.
+ */
+class CompressedDigraph::Builder {
+public:
+  /**
+   * Initializes a builder for a digraph with {@code V} vertices and no edges.
+   *
+   * @param  V the number of vertices
+   * @throws IllegalArgumentException if {@code V < 0}
+   */
+  explicit Builder(int V);
+  /**
+   * Adds the directed edge v->w.
+   *
+   * @param  v the tail vertex
+   * @param  w the head vertex
+   * @throws IllegalArgumentException unless both {@code 0 <= v < V} and {@code 0 <= w < V}
+   * @throws IllegalArgumentException if {@code v} is less than the tail of the previous edge
+   * @throws IllegalArgumentException if there are more than {@code INT_MAX} edges
+   */
+  void AddEdge(int v, int w);
+  /**
+   * Returns the digraph of the edges added. The builder is left empty.
+   *
+   * @return the compressed digraph
+   */
+  CompressedDigraph Build();
+
+private:
+  // encode the adjacency list of tail_ and move on to the next vertex
+  void Flush();
+
+  CompressedDigraph graph_;  // the digraph, encoded up to vertex tail_
+  int tail_{0};              // the vertex whose list is being collected
+  std::vector<int> list_;    // the heads of the edges from tail_ so far
+};
+}
+
+#endif  // COMPRESSED_DIGRAPH_H_
@@ -1,12 +1,12 @@
 /******************************************************************************
- *  Compilation:  clang++ -c -O2 edge_weighted_digraph.cc -std=c++11
- *                clang++ -c -O2 directed_edge.cc -std=c++11
- *                clang++ -c -O2 digraph.cc -std=c++11
- *                clang++ -c -O2 directed_cycle.cc -std=c++11
- *                clang++ -c -O2 depth_first_order.cc -std=c++11
- *                clang++ -c -O2 edge_weighted_directed_cycle.cc -std=c++11
- *                clang++ -c -O2 topological_sort.cc -std=c++11
- *                clang+ -O2 acyclic_lp.cc edge_weighted_digraph.o directed_cycle.o directed_edge.o depth_first_order.o digraph.o edge_weighted_directed_cycle.o topological_sort.o -std=c++11 -o acyclic_lp
+ *  Compilation:  clang++ -c -O2 edge_weighted_digraph.cc -std=c++20
+ *                clang++ -c -O2 directed_edge.cc -std=c++20
+ *                clang++ -c -O2 digraph.cc -std=c++20
+ *                clang++ -c -O2 directed_cycle.cc -std=c++20
+ *                clang++ -c -O2 depth_first_order.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_directed_cycle.cc -std=c++20
+ *                clang++ -c -O2 topological_sort.cc -std=c++20
+ *                clang+ -O2 acyclic_lp.cc edge_weighted_digraph.o directed_cycle.o directed_edge.o depth_first_order.o digraph.o edge_weighted_directed_cycle.o topological_sort.o -std=c++20 -o acyclic_lp
  *  Execution:    cpm input.txt
  *  Dependencies: edge_weighted_digraph.h directed_edge.h topological_sort.h
  *                digraph.h directed_cycle.h depth_first_order.h
@@ -48,6 +48,9 @@
  *  where <em>V</em> is the number of jobs and <em>E</em> is the
  *  number of precedence constraints.
  *  <p>
+ *  See {@link DagExecutor} to run the jobs on a pool of threads,
+ *  prioritized by the critical path method.
+ *  <p>
  *  For additional documentation,
  *  see <a href="https://algs4.cs.princeton.edu/44sp">Section 4.4</a> of
  *  <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
@@ -67,6 +70,7 @@
 #include <fstream>
 #include <string>
 #include <iostream>
+#include <vector>
 
 #include "edge_weighted_digraph.h"
 #include "acyclic_lp.h"
@@ -91,15 +95,17 @@ int main(int args, char* argv[]) {
   int source = 2*n;
   int sink   = 2*n + 1;
 
-  // build network
+  // build network; collect the edges first and add them in one batch
   EdgeWeightedDigraph G(2*n + 2);
+  vector<DirectedEdge> edges;
+  edges.reserve(3*n);
   for (int i = 0; i < n; i++) {
 	getline(in, line);
 	size_t pos = 0;
 	double duration = stod(line, &pos);
-	G.addEdge(new DirectedEdge(source, i, 0.0));
-	G.addEdge(new DirectedEdge(i+n, sink, 0.0));
-	G.addEdge(new DirectedEdge(i, i+n, duration));
+	edges.emplace_back(source, i, 0.0);
+	edges.emplace_back(i+n, sink, 0.0);
+	edges.emplace_back(i, i+n, duration);
 
 	// precedence constraints
 	if (pos == string::npos) continue;
@@ -111,9 +117,10 @@ int main(int args, char* argv[]) {
 	  ++pos;
 	  line = line.substr(pos);
 	  int precedent = stoi(line, &pos);
-	  G.addEdge(new DirectedEdge(n+i, precedent, 0.0));
+	  edges.emplace_back(n+i, precedent, 0.0);
 	}
   }
+  G.AddEdges(edges);
 
   // compute longest path
   AcyclicLP lp(G, source);
@@ -0,0 +1,154 @@
+#ifndef DAG_EXECUTOR_H_
+#define DAG_EXECUTOR_H_
+
+#include <fstream>
+#include <functional>
+#include <vector>
+
+#include "parallel.h"
+
+/**
+ *  The {@code DagExecutor} class runs a set of jobs with precedence
+ *  constraints on a pool of threads, as the scheduler of the
+ *  <em>parallel precedence-constrained job scheduling problem</em> that
+ *  {@link CPM} solves on paper. A job starts once all the jobs that must
+ *  precede it have finished, and runs a callable given the job index.
+ *  <p>
+ *  The jobs are prioritized by the critical path method: the priority of a
+ *  job is the length of the longest chain of jobs that starts with it, its
+ *  duration included, computed once with {@link AcyclicLP} on the CPM
+ *  network reversed. That is the least time the rest of the schedule can
+ *  take once the job starts, so among ready jobs the one with the longest
+ *  tail runs first.
+ *  <p>
+ *  Each thread keeps its ready jobs in its own priority queue. A job made
+ *  ready by a finished one goes to the queue of the thread that ran it;
+ *  a thread whose queue is empty steals the top job of another queue, and
+ *  sleeps only when all are empty. {@code Run} returns the start and finish
+ *  time of each job, and the makespan, to compare with
+ *  {@code CriticalPath()} and with {@code LowerBound(threads)}.
+ *  <p>
+ *  The constructor takes time proportional to <em>V</em> + <em>E</em>,
+ *  where <em>V</em> is the number of jobs and <em>E</em> the number of
+ *  precedence constraints. Scheduling takes time proportional to
+ *  <em>E</em> plus <em>V</em> log <em>V</em>, besides the jobs.
+ *  <p>
+ *  For additional documentation,
+ *  see <a href="https://algs4.cs.princeton.edu/44sp">Section 4.4</a> of
+ *  <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
+ */
+
+namespace algs4 {
+class DagExecutor {
+public:
+  /**
+   * The times at which the jobs of a run started and finished, in seconds
+   * since the start of the run.
+   */
+  struct Schedule {
+    std::vector<double> start;
+    std::vector<double> finish;
+    double makespan{0.0};
+  };
+
+  /**
+   * Initializes the jobs from their durations and, for each job, the jobs
+   * that must start after it finishes.
+   *
+   * @param  durations the duration of each job
+   * @param  successors successors[i] = the jobs that must follow job {@code i}
+   * @throws IllegalArgumentException unless there are as many lists of
+   *         successors as durations
+   * @throws IllegalArgumentException if a duration is negative or a
+   *         successor is not between 0 and <em>V</em> - 1
+   * @throws IllegalArgumentException if the constraints form a cycle
+   */
+  DagExecutor(std::vector<double> durations, std::vector<std::vector<int>> successors);
+  /**
+   * Initializes the jobs from an input stream in the format of the
+   * {@code CPM} client: the number of jobs, then for each job its
+   * duration, the number of jobs that must follow it and their indices.
+   *
+   * @param  in the input stream
+   * @throws IllegalArgumentException if the input stream is in the wrong format
+   * @throws IllegalArgumentException if the constraints form a cycle
+   */
+  DagExecutor(std::fstream& in);
+  DagExecutor() = delete;
+  DagExecutor(const DagExecutor& other) = default;
+  DagExecutor &operator=(const DagExecutor& other) = default;
+  DagExecutor(DagExecutor&& other) = default;
+  DagExecutor &operator=(DagExecutor&& other) = default;
+
+  /**
+   * Returns the number of jobs.
+   * @return the number of jobs
+   */
+  int V() const { return static_cast<int>(durations_.size()); }
+  /**
+   * Returns the duration of job {@code i}.
+   * @param  i the job
+   * @return the duration of job {@code i}
+   * @throws IllegalArgumentException unless {@code 0 <= i < V}
+   */
+  double duration(int i) const;
+  /**
+   * Returns the earliest start time of job {@code i}, with unboundedly
+   * many threads: the length of the longest chain of jobs before it.
+   * @param  i the job
+   * @return the earliest start time of job {@code i}
+   * @throws IllegalArgumentException unless {@code 0 <= i < V}
+   */
+  double start(int i) const;
+  /**
+   * Returns the priority of job {@code i}: the length of the longest chain
+   * of jobs that starts with it.
+   * @param  i the job
+   * @return the priority of job {@code i}
+   * @throws IllegalArgumentException unless {@code 0 <= i < V}
+   */
+  double priority(int i) const;
+  /**
+   * Returns the length of the critical path: the makespan of the
+   * schedule with unboundedly many threads.
+   * @return the length of the critical path
+   */
+  double CriticalPath() const { return critical_path_; }
+  /**
+   * Returns a lower bound on the makespan with {@code threads} threads:
+   * the larger of the critical path and the total duration divided among
+   * the threads.
+   * @param  threads the number of threads
+   * @return a lower bound on the makespan with {@code threads} threads
+   */
+  double LowerBound(int threads) const;
+
+  /**
+   * Runs {@code job(i)} for every job {@code i}, each once all the jobs
+   * that must precede it have returned, on {@code threads} threads. If a
+   * job throws, no further job is started and the exception is rethrown
+   * once the running ones have returned.
+   *
+   * @param  job the work of the jobs, called with the job index
+   * @param  threads the number of threads
+   * @return the start and finish times of the jobs
+   */
+  Schedule Run(const std::function<void(int)>& job, int threads = DefaultThreads()) const;
+
+private:
+  // compute the priorities and start times with the critical path method
+  void Prioritize();
+  // throw an IllegalArgumentException unless {@code 0 <= i < V}
+  void ValidateJob(int i) const;
+
+private:
+  std::vector<double> durations_;             // durations_[i] = duration of job i
+  std::vector<std::vector<int>> successors_;  // successors_[i] = jobs that follow job i
+  std::vector<int> predecessors_;             // predecessors_[i] = number of jobs job i follows
+  std::vector<double> start_;                 // start_[i] = earliest start of job i
+  std::vector<double> priority_;              // priority_[i] = longest chain from job i
+  double critical_path_{0.0};                 // length of the critical path
+};
+}
+
+#endif  // DAG_EXECUTOR_H_
@@ -38,6 +38,9 @@
  *  is the number of edges.
  *  Each instance method takes &Theta;(1) time.
  *  It uses &Theta;(<em>V</em>) extra space (not including the digraph).
+ *  A search that borrows a {@link SearchWorkspace} keeps its marks and
+ *  paths there instead, and takes time proportional to the vertices and
+ *  edges it reaches.
  *  <p>
  *  See {@link DepthFirstDirectedPaths} for a nonrecursive implementation.
  *  For additional documentation,
@@ -53,24 +56,17 @@
 #include <exception>
 #include <string>
 
-using std::stack;
+#include "digraph.h"
 
-void DepthFirstDirectedPaths::dfs(const Digraph& G, int v) {
-    marked_[v] = true;
-    for (int w : G.adj(v)) {
-        if (!marked_[w]) {
-            edgeTo_[w] = v;
-            dfs(G, w);
-        }
-    }
-}
+using std::stack;
 
+namespace algs4 {
 stack<int> DepthFirstDirectedPaths::pathTo(int v) const {
     validateVertex(v);
     stack<int> path;
     if (!hasPathTo(v)) return path;
 
-    for (int x = v; x != s_; x = edgeTo_[x])
+    for (int x = v; x != s_; x = workspace().edgeTo[x])
         path.push(x);
     path.push(s_);
 
@@ -78,10 +74,11 @@ stack<int> DepthFirstDirectedPaths::pathTo(int v) const {
 }
 
 void DepthFirstDirectedPaths::validateVertex(int v) const {
-    int V = marked_.size();
+    int V = workspace().marked.size();
     if (v < 0 || v >= V)
         throw std::invalid_argument("vertex " + std::to_string(v) + " is not between 0 and " + std::to_string(V-1));
 }
+}
 
 /**
  * Unit tests the {@code DepthFirstDirectedPaths} data type.
@@ -92,6 +89,7 @@ void DepthFirstDirectedPaths::validateVertex(int v) const {
 #include <fstream>
 #include <iostream>
 #include <cstdlib>
+using namespace algs4;
 int main(int argc, char *argv[]) {
     std::fstream in(argv[1]);
     if (!in.is_open()) {
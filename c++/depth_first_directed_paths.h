@@ -4,8 +4,11 @@
 #include <vector>
 #include <stack>
 
-#include "digraph.h"
+#include "depth_first_traversal.h"
+#include "graph_concepts.h"
+#include "search_workspace.h"
 
+namespace algs4 {
 class DepthFirstDirectedPaths {
 public:
     /**
@@ -14,9 +17,28 @@ public:
      * @param  s the source vertex
      * @throws IllegalArgumentException unless {@code 0 <= s < V}
      */
-    DepthFirstDirectedPaths(const Digraph& G, int s) noexcept : marked_(G.V()), edgeTo_(G.V()), s_(s) {
+    template <DirectedGraph Graph>
+    DepthFirstDirectedPaths(const Graph& G, int s) : s_(s) {
         //validateVertex(s);
-        dfs(G, s);
+        DepthFirstTraversal<Graph> traversal(G);
+        dfs(traversal, G.V(), s);
+    }
+
+    /**
+     * Computes a directed path from {@code s} to every other vertex in digraph {@code G},
+     * keeping the marks and paths in {@code workspace}: the search takes time
+     * proportional to the vertices and edges it reaches. The paths are valid
+     * until {@code workspace} is used by another search.
+     * @param  G the digraph
+     * @param  s the source vertex
+     * @param  workspace the workspace, which must outlive this object
+     * @throws IllegalArgumentException unless {@code 0 <= s < V}
+     */
+    template <DirectedGraph Graph>
+    DepthFirstDirectedPaths(const Graph& G, int s, SearchWorkspace& workspace) :
+        workspace_(&workspace), s_(s) {
+        DepthFirstTraversal<Graph> traversal(G, workspace);
+        dfs(traversal, G.V(), s);
     }
     DepthFirstDirectedPaths() = delete;
     DepthFirstDirectedPaths(const DepthFirstDirectedPaths& other) = default;
@@ -33,7 +55,7 @@ public:
      */
     bool hasPathTo(int v) const {
         validateVertex(v);
-        return marked_[v];
+        return workspace().marked[v];
     }
 
     /**
@@ -47,16 +69,30 @@ public:
     std::stack<int> pathTo(int v) const;
 
 private:
-    void dfs(const Digraph& G, int v);
+    template <typename Traversal>
+    void dfs(Traversal& traversal, int V, int s) {
+        struct Visitor {
+            EpochArray<int>& edgeTo;
+            void TreeEdge(int v, int w, int) { edgeTo.Set(w, v); }
+        };
+        SearchWorkspace& workspace = workspace_ ? *workspace_ : own_;
+        workspace.marked.Reset(V);
+        workspace.edgeTo.Reset(V);
+        traversal.Run(s, workspace.marked, Visitor{workspace.edgeTo});
+    }
+
+    const SearchWorkspace& workspace() const { return workspace_ ? *workspace_ : own_; }
 
 
     // throw an IllegalArgumentException unless {@code 0 <= v < V}
     void validateVertex(int v) const;
 
 private:
-    std::vector<bool> marked_;  // marked_[v] = true iff v is reachable from s
-    std::vector<int> edgeTo_;      // edgeTo_[v] = last edge on path from s to v
+    SearchWorkspace own_;       // own_.marked[v] = true iff v is reachable from s
+                                // own_.edgeTo[v] = last edge on path from s to v
+    SearchWorkspace* workspace_{nullptr};  // the borrowed workspace, if any, instead of own_
     int s_;       // source vertex
 };
+}
 
 #endif
@@ -1,10 +1,12 @@
 /******************************************************************************
  *  Compilation:  clang++ -c -O2 digraph.cc -std=c++20
+ *                clang++ -c -O2 compact_digraph.cc -std=c++20
+ *                clang++ -c -O2 compressed_digraph.cc -std=c++20
  *                clang++ -c -O2 directed_edge.cc -std=c++20
  *                clang++ -c -O2 edge_weighted_digraph.cc -std=c++20
- *                clang++ -O2 -DDebug depth_first_order.cc digraph.o edge_weighted_digraph.o directed_edge.o -std=c++20 -o depth_first_order
+ *                clang++ -O2 -DDebug depth_first_order.cc digraph.o compact_digraph.o compressed_digraph.o edge_weighted_digraph.o directed_edge.o -std=c++20 -pthread -o depth_first_order
  *  Execution:    ./depth_first_order digraph.txt
- *  Dependencies: digraph.h
+ *  Dependencies: digraph.h compact_digraph.h compressed_digraph.h
  *                edge_weighted_digraph.h directed_edge.h
  *  Data files:   https://algs4.cs.princeton.edu/42digraph/tinyDAG.txt
  *                https://algs4.cs.princeton.edu/42digraph/tinyDG.txt
@@ -61,63 +63,13 @@
 #include <stack>
 #include <algorithm>
 
-#include "directed_edge.h"
+#include "digraph.h"
 
 using std::queue;
 using std::vector;
 using std::stack;
 
 namespace algs4 {
-/**
- * Determines a depth-first order for the digraph {@code G}.
- * @param G the digraph
- */
-DepthFirstOrder::DepthFirstOrder(const Digraph& G) noexcept {
-  pre_.resize(G.V());
-  post_.resize(G.V());
-  marked_.resize(G.V());
-  for (int v = 0; v < G.V(); v++)
-    if (!marked_[v]) Dfs(G, v);
-
-  assert(Check());
-}
-
-/**
- * Determines a depth-first order for the edge-weighted digraph {@code G}.
- * @param G the edge-weighted digraph
- */
-DepthFirstOrder::DepthFirstOrder(const EdgeWeightedDigraph& G) noexcept {
-  pre_.resize(G.V());
-  post_.resize(G.V());
-  marked_.resize(G.V());
-  for (int v = 0; v < G.V(); v++)
-    if (!marked_[v]) Dfs(G, v);
-}
-
-// run DFS in digraph G from vertex v and compute preorder/postorder
-void DepthFirstOrder::Dfs(const Digraph& G, int v) {
-  marked_[v] = true;
-  pre_[v] = pre_counter_++;
-  preorder_.push(v);
-  for (int w : G.Adj(v))
-    if (!marked_[w]) Dfs(G, w);
-  postorder_.push(v);
-  post_[v] = post_counter_++;
-}
-
-// run DFS in edge-weighted digraph G from vertex v and compute preorder/postorder
-void DepthFirstOrder::Dfs(const EdgeWeightedDigraph& G, int v) {
-  marked_[v] = true;
-  pre_[v] = pre_counter_++;
-  preorder_.push(v);
-  for (DirectedEdge* e : G.Adj(v)) {
-    int w = e->to();
-    if (!marked_[w]) Dfs(G, w);
-  }
-  postorder_.push(v);
-  post_[v] = post_counter_++;
-}
-
 /**
  * Returns the preorder number of vertex {@code v}.
  * @param  v the vertex
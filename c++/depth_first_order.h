@@ -1,25 +1,30 @@
 #ifndef DEPTH_FIRST_ORDER_H_
 #define DEPTH_FIRST_ORDER_H_
 
+#include <cassert>
 #include <vector>
 #include <queue>
 
-#include "digraph.h"
-#include "edge_weighted_digraph.h"
+#include "depth_first_traversal.h"
+#include "graph_concepts.h"
 
 namespace algs4 {
 class DepthFirstOrder {
 public:
   /**
-   * Determines a depth-first order for the digraph {@code G}.
+   * Determines a depth-first order for the digraph {@code G}, which may be
+   * any adjacency digraph or edge-weighted digraph.
    * @param G the digraph
    */
-  DepthFirstOrder(const Digraph& G) noexcept;
-  /**
-   * Determines a depth-first order for the edge-weighted digraph {@code G}.
-   * @param G the edge-weighted digraph
-   */
-  DepthFirstOrder(const EdgeWeightedDigraph& G) noexcept;
+  template <DirectedGraph Graph>
+  DepthFirstOrder(const Graph& G) :
+    marked_(G.V()), pre_(G.V()), post_(G.V()) {
+    DepthFirstTraversal<Graph> dfs(G);
+    for (int v = 0; v < G.V(); v++)
+      if (!marked_[v]) Dfs(dfs, v);
+
+    assert(Check());
+  }
   DepthFirstOrder() = delete;
   DepthFirstOrder(const DepthFirstOrder& other) = default;
   DepthFirstOrder &operator=(const DepthFirstOrder& other) = default;
@@ -56,9 +61,21 @@ public:
   std::vector<int> ReversePost() const;
 private:
   // run DFS in digraph G from vertex v and compute preorder/postorder
-  void Dfs(const Digraph& G, int v);
-  // run DFS in edge-weighted digraph G from vertex v and compute preorder/postorder
-  void Dfs(const EdgeWeightedDigraph& G, int v);
+  template <typename Traversal>
+  void Dfs(Traversal& dfs, int s) {
+    struct Visitor {
+      DepthFirstOrder& order;
+      void PreVisit(int v) {
+        order.pre_[v] = order.pre_counter_++;
+        order.preorder_.push(v);
+      }
+      void PostVisit(int v) {
+        order.postorder_.push(v);
+        order.post_[v] = order.post_counter_++;
+      }
+    };
+    dfs.Run(s, marked_, Visitor{*this});
+  }
   // Check that pre() and post() are consistent with pre(v) and post(v)
   bool Check() const;
 private:
@@ -0,0 +1,141 @@
+/******************************************************************************
+ *  Compilation:  clang++ -c -O2 digraph.cc -std=c++20
+ *                clang++ -c -O2 compact_digraph.cc -std=c++20
+ *                clang++ -c -O2 depth_first_order.cc -std=c++20
+ *                clang++ -c -O2 directed_cycle.cc -std=c++20
+ *                clang++ -c -O2 kosaraju_sharir_scc.cc -std=c++20
+ *                clang++ -c -O2 tarjan_scc.cc -std=c++20
+ *                clang++ -c -O2 directed_edge.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_digraph.cc -std=c++20
+ *                clang++ -c -O2 edge.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_graph.cc -std=c++20
+ *                clang++ -c -O2 graph_generator.cc -std=c++20
+ *                clang++ -c -O2 transitive_closure.cc -std=c++20
+ *                clang++ -DDebug -O2 depth_first_traversal.cc digraph.o compact_digraph.o depth_first_order.o directed_cycle.o kosaraju_sharir_scc.o tarjan_scc.o directed_edge.o edge_weighted_digraph.o edge.o edge_weighted_graph.o graph_generator.o transitive_closure.o -std=c++20 -pthread -o depth_first_traversal
+ *  Execution:    ./depth_first_traversal V E seed
+ *  Dependencies: depth_first_traversal.h depth_first_order.h directed_cycle.h
+ *                kosaraju_sharir_scc.h graph_generator.h
+ *
+ *  Compares the iterative depth-first search with the recursive one on a
+ *  random digraph, and runs it along a path of 10 million vertices, which
+ *  overflows the stack of the recursive search.
+ *
+ *  % ./depth_first_traversal 1000000 8000000 1
+ *  random digraph: 1000000 vertices, 8000000 edges
+ *  DepthFirstOrder: recursive 628.7 ms, iterative 590.8 ms, orders agree
+ *  path of 10000000 vertices:
+ *  DepthFirstOrder    915.0 ms, last vertex in preorder 9999999
+ *  DirectedCycle      541.3 ms, no cycle
+ *  KosarajuSharirSCC 1010.1 ms, 10000000 components
+ *
+ ******************************************************************************/
+
+#include "depth_first_traversal.h"
+
+/**
+ * Unit tests the {@code DepthFirstTraversal} data type.
+ *
+ * @param args the command-line arguments
+ */
+#ifdef Debug
+#include <pthread.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "compact_digraph.h"
+#include "depth_first_order.h"
+#include "directed_cycle.h"
+#include "graph_generator.h"
+#include "kosaraju_sharir_scc.h"
+
+using namespace algs4;
+using std::vector;
+using Clock = std::chrono::steady_clock;
+
+double MillisSince(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// the textbook recursive search, as the reference
+struct RecursiveOrder {
+  const CompactDigraph& G;
+  vector<bool> marked;
+  vector<int> preorder, postorder;
+
+  void Dfs(int v) {
+    marked[v] = true;
+    preorder.push_back(v);
+    for (int w : G.Adj(v))
+      if (!marked[w]) Dfs(w);
+    postorder.push_back(v);
+  }
+  static void *Run(void *arg) {
+    RecursiveOrder& order = *static_cast<RecursiveOrder *>(arg);
+    for (int v = 0; v < order.G.V(); v++)
+      if (!order.marked[v]) order.Dfs(v);
+    return nullptr;
+  }
+};
+
+vector<int> Drain(std::queue<int> queue) {
+  vector<int> list;
+  for (; !queue.empty(); queue.pop())
+    list.push_back(queue.front());
+  return list;
+}
+
+int main(int argc, char *argv[]) {
+  int V = std::stoi(argv[1]);
+  int E = std::stoi(argv[2]);
+  uint64_t seed = std::stoull(argv[3]);
+  CompactDigraph G = GenerateDigraph(GraphModel::ErdosRenyi(V, E, seed), 1);
+  printf("random digraph: %d vertices, %d edges\n", G.V(), G.E());
+
+  // the recursive search needs a stack as deep as the longest path it
+  // follows, so give its thread 1 GB
+  RecursiveOrder reference{G, vector<bool>(V), {}, {}};
+  pthread_attr_t attributes;
+  pthread_attr_init(&attributes);
+  pthread_attr_setstacksize(&attributes, size_t{1} << 30);
+  pthread_t thread;
+  Clock::time_point start = Clock::now();
+  pthread_create(&thread, &attributes, &RecursiveOrder::Run, &reference);
+  pthread_join(thread, nullptr);
+  double recursive_time = MillisSince(start);
+
+  start = Clock::now();
+  DepthFirstOrder order(G);
+  double iterative_time = MillisSince(start);
+  bool agree = Drain(order.pre()) == reference.preorder &&
+               Drain(order.post()) == reference.postorder;
+  printf("DepthFirstOrder: recursive %.1f ms, iterative %.1f ms, orders %s\n",
+         recursive_time, iterative_time, agree ? "agree" : "differ");
+
+  // a path 0->1->...->n-1
+  int n = 10000000;
+  vector<int> offsets(n + 1), targets(n - 1);
+  for (int v = 0; v < n - 1; v++) {
+    offsets[v + 1] = v + 1;
+    targets[v] = v + 1;
+  }
+  offsets[n] = n - 1;
+  CompactDigraph path(n, std::move(offsets), std::move(targets));
+  printf("path of %d vertices:\n", n);
+
+  start = Clock::now();
+  DepthFirstOrder path_order(path);
+  printf("DepthFirstOrder   %6.1f ms, last vertex in preorder %d\n",
+         MillisSince(start), path_order.pre().back());
+  start = Clock::now();
+  DirectedCycle cycle(path);
+  printf("DirectedCycle     %6.1f ms, %s\n", MillisSince(start),
+         cycle.HasCycle() ? "cycle" : "no cycle");
+  start = Clock::now();
+  KosarajuSharirSCC scc(path);
+  printf("KosarajuSharirSCC %6.1f ms, %d components\n", MillisSince(start), scc.count());
+
+  return agree && !cycle.HasCycle() && scc.count() == n ? 0 : 1;
+}
+#endif
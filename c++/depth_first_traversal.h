@@ -0,0 +1,171 @@
+#ifndef DEPTH_FIRST_TRAVERSAL_H_
+#define DEPTH_FIRST_TRAVERSAL_H_
+
+#include <any>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include "graph_concepts.h"
+#include "search_workspace.h"
+
+/**
+ *  The {@code DepthFirstTraversal} class is the depth-first search shared by
+ *  the depth-first graph algorithms ({@link DirectedDFS},
+ *  {@link DepthFirstOrder}, {@link DirectedCycle}, ...). It is iterative:
+ *  the path from the root to the current vertex is kept on an explicit stack
+ *  of frames, one per vertex, each holding the vertex, the edge it was
+ *  reached by and its position in its adjacency list. The stack is allocated
+ *  once, for <em>V</em> frames, so a search never allocates and has no depth
+ *  limit beyond <em>V</em> itself. A traversal constructed with a
+ *  {@link SearchWorkspace} keeps its stack there, so that the searches that
+ *  borrow the workspace allocate it only the first time.
+ *  <p>
+ *  {@code Run(s, marked, visitor)} searches from the unmarked vertex
+ *  <em>s</em>, marking each vertex it reaches, and visits the vertices and
+ *  edges in exactly the order of the textbook recursive search, calling
+ *  whichever of these hooks the visitor defines:
+ *  <ul>
+ *  <li> {@code PreVisit(v)}: <em>v</em> is reached, just after it is marked.
+ *  <li> {@code TreeEdge(v, w, e)}: the search is about to descend along the
+ *       edge <em>v</em>-&gt;<em>w</em> to the unmarked vertex <em>w</em>.
+ *  <li> {@code NonTreeEdge(v, w, e)}: the edge <em>v</em>-&gt;<em>w</em>
+ *       leads to a vertex that is already marked.
+ *  <li> {@code Backtrack(v, w, e)}: the search returns to <em>v</em> once
+ *       <em>w</em>, reached by the tree edge <em>v</em>-&gt;<em>w</em>, is
+ *       finished; called after {@code PostVisit(w)}.
+ *  <li> {@code PostVisit(v)}: all edges leaving <em>v</em> have been
+ *       explored.
+ *  <li> {@code Done()}: checked after each edge; returning {@code true}
+ *       abandons the search at once, without finishing the vertices on the
+ *       stack.
+ *  </ul>
+ *  The edge id <em>e</em> is that of the edge in a {@code WeightedDigraph},
+ *  and -1 in an {@code AdjacencyDigraph}. The hooks are inlined into the
+ *  loop, so a search costs no more than the recursive one.
+ *  <p>
+ *  The same traversal may run from any number of roots, sharing its stack
+ *  and the marks.
+ */
+
+namespace algs4 {
+
+template <DirectedGraph Graph>
+class DepthFirstTraversal {
+public:
+  /**
+   * Prepares a depth-first search of the digraph {@code G}, which must
+   * outlive it.
+   * @param G the digraph
+   */
+  explicit DepthFirstTraversal(const Graph& G) : graph_(&G), frames_(own_) {
+    frames_.reserve(G.V());
+  }
+  /**
+   * Prepares a depth-first search of the digraph {@code G} whose stack is
+   * kept in {@code workspace}; both must outlive it. The stack is allocated
+   * only if the workspace holds none for this type of digraph, or a smaller
+   * one.
+   * @param G the digraph
+   * @param workspace the workspace
+   */
+  DepthFirstTraversal(const Graph& G, SearchWorkspace& workspace) :
+    graph_(&G), frames_(Borrow(workspace.frames)) {
+    frames_.reserve(G.V());
+  }
+  DepthFirstTraversal() = delete;
+  DepthFirstTraversal(const DepthFirstTraversal& other) = delete;
+  DepthFirstTraversal &operator=(const DepthFirstTraversal& other) = delete;
+  DepthFirstTraversal(DepthFirstTraversal&& other) = delete;
+  DepthFirstTraversal &operator=(DepthFirstTraversal&& other) = delete;
+
+  /**
+   * Searches from the vertex {@code s}, which must not be marked, marking
+   * every vertex reached in {@code marked} and calling the hooks of
+   * {@code visitor}. Neither is validated.
+   * @param s the root of the search
+   * @param marked marked[v] = has vertex v been reached? Of size <em>V</em>
+   * @param visitor the hooks
+   */
+  template <typename Marks, typename Visitor>
+  void Run(int s, Marks& marked, Visitor&& visitor) {
+    const Graph& G = *graph_;
+    Enter(s, -1, marked, visitor);
+    while (!frames_.empty()) {
+      Frame& frame = frames_.back();
+      if (frame.next == frame.end) {
+        int w = frame.v, e = frame.edge;
+        frames_.pop_back();
+        if constexpr (requires { visitor.PostVisit(w); })
+          visitor.PostVisit(w);
+        if constexpr (requires { visitor.Backtrack(w, w, e); }) {
+          if (!frames_.empty()) visitor.Backtrack(frames_.back().v, w, e);
+        }
+        continue;
+      }
+
+      int v = frame.v;
+      int w = *frame.next, e = -1;
+      ++frame.next;
+      if constexpr (WeightedDigraph<Graph>) {
+        e = w;
+        w = G.to(e);
+      }
+      if (!marked[w]) {
+        if constexpr (requires { visitor.TreeEdge(v, w, e); })
+          visitor.TreeEdge(v, w, e);
+        Enter(w, e, marked, visitor);
+      } else {
+        if constexpr (requires { visitor.NonTreeEdge(v, w, e); })
+          visitor.NonTreeEdge(v, w, e);
+      }
+      if constexpr (requires { { visitor.Done() } -> std::convertible_to<bool>; }) {
+        if (visitor.Done()) {
+          frames_.clear();
+          return;
+        }
+      }
+    }
+  }
+
+private:
+  using Range = AdjRange<Graph>;
+
+  // a vertex on the path from the root, and its unexplored edges; frames
+  // never move, since the stack never holds more than V of them, so the
+  // iterators may point into the range
+  struct Frame {
+    Frame(const Graph& G, int v, int edge) :
+      v(v), edge(edge), adj(G.Adj(v)),
+      next(std::ranges::begin(adj)), end(std::ranges::end(adj)) {}
+
+    int v;
+    int edge;
+    Range adj;
+    std::ranges::iterator_t<Range> next;
+    std::ranges::sentinel_t<Range> end;
+  };
+
+  template <typename Marks, typename Visitor>
+  void Enter(int v, int edge, Marks& marked, Visitor& visitor) {
+    marked[v] = true;
+    if constexpr (requires { visitor.PreVisit(v); })
+      visitor.PreVisit(v);
+    frames_.emplace_back(*graph_, v, edge);
+  }
+
+  // the frame stack kept in slot, replacing whatever another type of
+  // traversal left there
+  static std::vector<Frame>& Borrow(std::any& slot) {
+    if (std::vector<Frame>* frames = std::any_cast<std::vector<Frame>>(&slot))
+      return *frames;
+    return slot.emplace<std::vector<Frame>>();
+  }
+
+  const Graph* graph_;
+  std::vector<Frame> own_;      // the stack, unless it is borrowed
+  std::vector<Frame>& frames_;  // the stack in use
+};
+}
+
+#endif  // DEPTH_FIRST_TRAVERSAL_H_
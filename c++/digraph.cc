@@ -1,5 +1,5 @@
 /******************************************************************************
- *  Compilation:  clang++ -DDebug -O2 digraph.cc -std=c++20 -o digraph
+ *  Compilation:  clang++ -DDebug -O2 digraph.cc -std=c++20 -pthread -o digraph
  *  Execution:    ./digraph filename.txt
  *  Dependencies: 
  *  Data files:   https://algs4.cs.princeton.edu/42digraph/tinyDG.txt
@@ -50,6 +50,8 @@
 
 #include "digraph.h"
 
+#include <algorithm>
+#include <climits>
 #include <exception>
 
 using std::vector;
@@ -144,6 +146,66 @@ void Digraph::AddEdge(int v, int w) {
   ++e_;
 }
 
+/**
+ * Adds the directed edges v→w given by the pairs {@code edges} to this
+ * digraph, in the same order as that many calls to {@code AddEdge} would.
+ *
+ * @param  edges the (tail, head) pairs
+ * @param  threads the number of threads to use
+ * @throws IllegalArgumentException unless the endpoints of every edge are
+ *         between {@code 0} and {@code V-1}; the digraph is then unchanged
+ */
+void Digraph::AddEdges(std::span<const std::pair<int, int>> edges, int threads) {
+  long long n = edges.size();
+  if (n > INT_MAX - e_)
+    throw std::invalid_argument("too many edges in a Digraph");
+  unsigned V = v_;
+  long long bad = ParallelFindFirst(n, threads, [&](long long i) {
+    return (static_cast<unsigned>(edges[i].first) >= V) |
+           (static_cast<unsigned>(edges[i].second) >= V);
+  });
+  if (bad < n) {
+    ValidateVertex(edges[bad].first);
+    ValidateVertex(edges[bad].second);
+  }
+
+  // split the edges into chunks with one outdegree and one indegree histogram
+  // each; fewer chunks than threads when the histograms would outweigh the edges
+  int chunks = std::clamp<long long>(n / std::max(v_, 1), 1, std::max(threads, 1));
+  auto chunk_begin = [&](int c) { return n * c / chunks; };
+  vector<vector<int>> out(chunks, vector<int>(v_)), in(chunks, vector<int>(v_));
+  ParallelInvoke(chunks, [&](int c) {
+    for (long long i = chunk_begin(c); i < chunk_begin(c + 1); i++) {
+      ++out[c][edges[i].first];
+      ++in[c][edges[i].second];
+    }
+  });
+
+  // out[c][v] becomes the position in adj_[v] of the first edge of chunk c
+  // leaving v, and every adjacency list grows once to its final size
+  ParallelFor(v_, threads, [&](long long begin, long long end) {
+    for (long long v = begin; v < end; v++) {
+      int next = adj_[v].size();
+      for (int c = 0; c < chunks; c++) {
+        int count = out[c][v];
+        out[c][v] = next;
+        next += count;
+        indegree_[v] += in[c][v];
+      }
+      adj_[v].reserve(next);
+      adj_[v].resize(next);
+    }
+  });
+
+  ParallelInvoke(chunks, [&](int c) {
+    for (long long i = chunk_begin(c); i < chunk_begin(c + 1); i++) {
+      auto [v, w] = edges[i];
+      adj_[v][out[c][v]++] = w;
+    }
+  });
+  e_ += n;
+}
+
 /**
  * Returns the vertices adjacent from vertex {@code v} in this digraph.
  *
@@ -187,11 +249,11 @@ int Digraph::Indegree(int v) const {
  *
  * @return the reverse of the digraph
  */
-Digraph* Digraph::Reverse() const {
-  Digraph* reverse = new Digraph(v_);
+Digraph Digraph::Reverse() const {
+  Digraph reverse(v_);
   for (int v = 0; v < v_; v++)
     for (int w : Adj(v))
-      reverse->AddEdge(w, v);
+      reverse.AddEdge(w, v);
 
   return reverse;
 }
@@ -4,8 +4,15 @@
 #include <vector>
 #include <string>
 #include <fstream>
+#include <span>
+#include <utility>
+
+#include "parallel.h"
 
 namespace algs4 {
+
+class CompactDigraph;
+
 class Digraph {
 public:
   friend class Digraph;
@@ -43,6 +50,20 @@ public:
    * @throws IllegalArgumentException unless both {@code 0 <= v < V} and {@code 0 <= w < V}
    */
   void AddEdge(int v, int w);
+  /**
+   * Adds the directed edges v→w given by the pairs {@code edges} to this
+   * digraph, in the same order as that many calls to {@code AddEdge} would.
+   * The endpoints are validated in one sweep before anything is added, the
+   * outdegrees and indegrees are counted in parallel, each adjacency list
+   * grows once to its exact final size, and the edges are written straight
+   * into place.
+   *
+   * @param  edges the (tail, head) pairs
+   * @param  threads the number of threads to use
+   * @throws IllegalArgumentException unless the endpoints of every edge are
+   *         between {@code 0} and {@code V-1}; the digraph is then unchanged
+   */
+  void AddEdges(std::span<const std::pair<int, int>> edges, int threads = DefaultThreads());
   /**
    * Returns the vertices adjacent from vertex {@code v} in this digraph.
    *
@@ -74,7 +95,15 @@ public:
    *
    * @return the reverse of the digraph
    */
-  Digraph* Reverse() const;
+  Digraph Reverse() const;
+  /**
+   * Returns an immutable compressed-sparse-row snapshot of this digraph.
+   * Later calls to {@code AddEdge} do not affect the snapshot.
+   * Defined in compact_digraph.h, which callers include.
+   *
+   * @return the digraph as a {@link CompactDigraph}
+   */
+  CompactDigraph Freeze() const;
   /**
    * Returns a string representation of the graph.
    *
@@ -3,9 +3,16 @@
 
 #include <vector>
 #include <stack>
+#include <limits>
+#include <string>
+#include <stdexcept>
+#include <iostream>
+#include <cassert>
 
+#include "directed_edge.h"
+#include "graph_concepts.h"
 #include "index_min_priority_queue.h"
-#include "edge_weighted_digraph.h"
+#include "search_workspace.h"
 
 /**
  *  The {@code DijkstraSP} class represents a data type for solving the
@@ -19,6 +26,13 @@
  *  the number of edges. Each instance method takes &Theta;(1) time.
  *  It uses &Theta;(<em>V</em>) extra space (not including the
  *  edge-weighted digraph).
+ *  A search that borrows a {@link SearchWorkspace} keeps its distances,
+ *  paths and priority queue there instead, and takes time proportional to
+ *  the edges it relaxes times log <em>V</em>.
+ *  <p>
+ *  The class is a template over the representation of the digraph: any
+ *  {@code WeightedDigraph}, such as {@link EdgeWeightedDigraph} or an implicit
+ *  digraph, with the argument deduced from the constructor.
  *  <p>
  *  This correctly computes shortest paths if all arithmetic performed is
  *  without floating-point rounding error or arithmetic overflow.
@@ -38,20 +52,53 @@
 
 namespace algs4 {
 
-class DirectedEdge;
-
+template <WeightedDigraph Graph>
 class DijkstraSP {
 public:
     /**
      * Computes a shortest-paths tree from the source vertex {@code s} to every other
      * vertex in the edge-weighted digraph {@code G}.
+     * {@code G} must outlive this object, since {@code pathTo} reads its edges.
      *
      * @param  G the edge-weighted digraph
      * @param  s the source vertex
      * @throws IllegalArgumentException if an edge weight is negative
      * @throws IllegalArgumentException unless {@code 0 <= s < V}
      */
-  DijkstraSP(const EdgeWeightedDigraph& G, int s);
+  DijkstraSP(const Graph& G, int s) : graph_(&G) {
+    for (int v = 0; v < G.V(); v++) {
+      for (int e : G.Adj(v)) {
+        if (G.weight(e) < 0)
+          throw std::invalid_argument("edge " + DirectedEdgeOf(G, e).ToString() +
+                                      " has negative weight");
+      }
+    }
+
+    Search(G, s, own_);
+
+    // check optimality conditions
+    assert(Check(G, s));
+  }
+
+    /**
+     * Computes a shortest-paths tree from the source vertex {@code s} to every other
+     * vertex in the edge-weighted digraph {@code G}, keeping the distances and
+     * paths in {@code workspace}: the search takes time proportional to the
+     * vertices and edges it reaches, and checks only the weights of the edges
+     * it relaxes. The paths are valid until {@code workspace} is used by
+     * another search.
+     *
+     * @param  G the edge-weighted digraph
+     * @param  s the source vertex
+     * @param  workspace the workspace, which must outlive this object
+     * @throws IllegalArgumentException if an edge reachable from {@code s} has
+     *         negative weight
+     * @throws IllegalArgumentException unless {@code 0 <= s < V}
+     */
+  DijkstraSP(const Graph& G, int s, SearchWorkspace& workspace) :
+    graph_(&G), workspace_(&workspace) {
+    Search(G, s, workspace);
+  }
   DijkstraSP() = delete;
   DijkstraSP(const DijkstraSP& other) = delete;
   DijkstraSP &operator=(const DijkstraSP& other) = delete;
@@ -67,7 +114,7 @@ public:
      */
   double distTo(int v) const {
     ValidateVertex(v);
-    return distTo_[v];
+    return workspace().distTo[v];
   }
 
     /**
@@ -78,7 +125,10 @@ public:
      *         {@code s} to vertex {@code v}; {@code false} otherwise
      * @throws IllegalArgumentException unless {@code 0 <= v < V}
      */
-  bool hasPathTo(int v) const;
+  bool hasPathTo(int v) const {
+    ValidateVertex(v);
+    return workspace().distTo[v] < std::numeric_limits<double>::max();
+  }
 
     /**
      * Returns a shortest path from the source vertex {@code s} to vertex {@code v}.
@@ -88,24 +138,123 @@ public:
      *         as an iterable of edges, and {@code null} if no such path
      * @throws IllegalArgumentException unless {@code 0 <= v < V}
      */
-  std::stack<DirectedEdge *> pathTo(int v) const;
+  std::stack<DirectedEdge> pathTo(int v) const {
+    std::stack<DirectedEdge> path;
+    ValidateVertex(v);
+    if (hasPathTo(v)) {
+      const EpochArray<int>& edgeTo = workspace().edgeTo;
+      for (int e = edgeTo[v]; e != -1; e = edgeTo[graph_->from(e)])
+        path.push(DirectedEdgeOf(*graph_, e));
+    }
+
+    return path;
+  }
 
 private:
-    // relax edge e and update pq_ if changed
-  void Relax(const DirectedEdge* e);
+    // relax vertices in order of distance from s
+  void Search(const Graph& G, int s, SearchWorkspace& workspace) {
+    ValidateVertex(s);
+    workspace.distTo.Reset(G.V());
+    workspace.edgeTo.Reset(G.V());
+    IndexMinPriorityQueue<double>& pq = workspace.ResetQueue(G.V());
+
+    workspace.distTo.Set(s, 0.0);
+    pq.Insert(s, 0.0);
+    while (!pq.IsEmpty()) {
+      int v = pq.DelMin();
+      for (int e : G.Adj(v))
+        Relax(G, e, workspace, pq);
+    }
+  }
+
+    // relax edge e and update pq if changed
+  void Relax(const Graph& G, int e, SearchWorkspace& workspace, IndexMinPriorityQueue<double>& pq) {
+    if (G.weight(e) < 0)
+      throw std::invalid_argument("edge " + DirectedEdgeOf(G, e).ToString() +
+                                  " has negative weight");
+    int v = G.from(e), w = G.to(e);
+    double dist = workspace.distTo[v] + G.weight(e);
+    if (workspace.distTo[w] > dist) {
+      workspace.distTo.Set(w, dist);
+      workspace.edgeTo.Set(w, e);
+      if (pq.Contains(w)) pq.DecreaseKey(w, dist);
+      else                pq.Insert(w, dist);
+    }
+  }
+
+  const SearchWorkspace& workspace() const { return workspace_ ? *workspace_ : own_; }
 
     // check optimality conditions:
     // (i) for all edges e:            distTo_[e.to()] <= distTo_[e.from()] + e.weight()
     // (ii) for all edge e on the SPT: distTo_[e.to()] == distTo_[e.from()] + e.weight()
-  bool Check(const EdgeWeightedDigraph& G, int s) const;
+  bool Check(const Graph& G, int s) const {
+    using std::cerr;
+    using std::endl;
+    const EpochArray<double>& distTo = workspace().distTo;
+    const EpochArray<int>& edgeTo = workspace().edgeTo;
+
+    // check that edge weights are non-negative
+    for (int v = 0; v < G.V(); v++) {
+      for (int e : G.Adj(v)) {
+        if (G.weight(e) < 0) {
+          cerr << "negative edge weight detected" << endl;
+          return false;
+        }
+      }
+    }
+
+    // check that distTo[v] and edgeTo[v] are consistent
+    if (distTo[s] != 0.0 || edgeTo[s] != -1) {
+      cerr << "distTo_[s] and edgeTo_[s] inconsistent" << endl;
+      return false;
+    }
+    for (int v = 0; v < G.V(); v++) {
+      if (v == s) continue;
+      if (edgeTo[v] == -1 && distTo[v] != std::numeric_limits<double>::max()) {
+        cerr << "distTo_[] and edgeTo_[] inconsistent" << endl;
+        return false;
+      }
+    }
+
+    // check that all edges e = v->w satisfy distTo[w] <= distTo[v] + e.weight()
+    for (int v = 0; v < G.V(); v++) {
+      for (int e : G.Adj(v)) {
+        int w = G.to(e);
+        if (distTo[v] + G.weight(e) < distTo[w]) {
+          cerr << "edge " + DirectedEdgeOf(G, e).ToString() + " not relaxed" << endl;
+          return false;
+        }
+      }
+    }
+
+    // check that all edges e = v->w on SPT satisfy distTo[w] == distTo[v] + e.weight()
+    for (int w = 0; w < G.V(); w++) {
+      if (edgeTo[w] == -1) continue;
+      int e = edgeTo[w];
+      int v = G.from(e);
+      if (w != G.to(e)) return false;
+      if (distTo[v] + G.weight(e) != distTo[w]) {
+        cerr << "edge " + DirectedEdgeOf(G, e).ToString() + " on shortest path not tight" << endl;
+        return false;
+      }
+    }
+
+    return true;
+  }
 
     // throw an IllegalArgumentException unless {@code 0 <= v < V}
-  void ValidateVertex(int v) const;
+  void ValidateVertex(int v) const {
+    int V = graph_->V();
+    if (v < 0 || v >= V)
+      throw std::invalid_argument("vertex " + std::to_string(v) +
+                                  " is not between 0 and " + std::to_string(V-1));
+  }
 
 private:
-  std::vector<double> distTo_;          // distTo_[v] = distance  of shortest s->v path
-  std::vector<DirectedEdge *> edgeTo_;    // edgeTo_[v] = last edge on shortest s->v path
-  IndexMinPriorityQueue<double> pq_;    // priority queue of vertices
+  const Graph* graph_;                  // the digraph, which must outlive this object
+  SearchWorkspace own_;                 // own_.distTo[v] = distance  of shortest s->v path
+                                        // own_.edgeTo[v] = id of last edge on shortest s->v path, or -1
+  SearchWorkspace* workspace_{nullptr}; // the borrowed workspace, if any, instead of own_
 };
 }
 
@@ -45,9 +45,10 @@
 
 #include "directed_cycle.h"
 
-#include <cassert>
 #include <cstdio>
 
+#include "digraph.h"
+
 using std::vector;
 using std::stack;
 
@@ -57,42 +58,6 @@ namespace algs4 {
  * finds such a cycle.
  * @param G the digraph
  */
-DirectedCycle::DirectedCycle(const Digraph& G) noexcept {
-  marked_.resize(G.V());
-  edge_to_.resize(G.V());
-  on_stack_.resize(G.V());
-  for (int v = 0; v < G.V(); v++)
-    if (!marked_[v] && cycle_.empty()) Dfs(G, v);
-}
-
-// check that algorithm computes either the topological order or finds a directed cycle
-void DirectedCycle::Dfs(const Digraph& G, int v) {
-  on_stack_[v] = true;
-  marked_[v] = true;
-  for_each(G.Adj(v).begin(), G.Adj(v).end(), [&](int w) {
-
-    // short circuit if directed cycle found
-    if (!cycle_.empty()) return;
-
-    // found new vertex, so recur
-    else if (!marked_[w]) {
-      edge_to_[w] = v;
-      Dfs(G, w);
-    }
-
-    // trace back directed cycle
-    else if (on_stack_[w]) {
-      for (int x = v; x != w; x = edge_to_[x]) {
-        cycle_.push(x);
-      }
-      cycle_.push(w);
-      cycle_.push(v);
-      assert(Check());
-    }
-  });
-  on_stack_[v] = false;
-}
-
 // certify that digraph has a directed cycle if it reports one
 bool DirectedCycle::Check() const {
   if (HasCycle()) {
@@ -1,10 +1,12 @@
 #ifndef DIRECTED_CYCLE_H_
 #define DIRECTED_CYCLE_H_
 
+#include <cassert>
 #include <vector>
 #include <stack>
 
-#include "digraph.h"
+#include "depth_first_traversal.h"
+#include "graph_concepts.h"
 
 namespace algs4 {
 class DirectedCycle {
@@ -14,7 +16,13 @@ public:
    * finds such a cycle.
    * @param G the digraph
    */
-  DirectedCycle(const Digraph& G) noexcept;
+  template <DirectedGraph Graph>
+  DirectedCycle(const Graph& G) :
+    marked_(G.V()), edge_to_(G.V()), on_stack_(G.V()) {
+    DepthFirstTraversal<Graph> dfs(G);
+    for (int v = 0; v < G.V(); v++)
+      if (!marked_[v] && cycle_.empty()) Dfs(dfs, v);
+  }
   DirectedCycle() = default;
   DirectedCycle(const DirectedCycle& other) = default;
   DirectedCycle &operator=(const DirectedCycle& other) = default;
@@ -34,7 +42,32 @@ public:
 
 private:
   // check that algorithm computes either the topological order or finds a directed cycle
-  void Dfs(const Digraph& G, int v);
+  template <typename Traversal>
+  void Dfs(Traversal& dfs, int s) {
+    struct Visitor {
+      DirectedCycle& c;
+      void PreVisit(int v) { c.on_stack_[v] = true; }
+      void PostVisit(int v) { c.on_stack_[v] = false; }
+
+      // found new vertex, so descend
+      void TreeEdge(int v, int w, int) { c.edge_to_[w] = v; }
+
+      // trace back directed cycle
+      void NonTreeEdge(int v, int w, int) {
+        if (!c.on_stack_[w]) return;
+        for (int x = v; x != w; x = c.edge_to_[x]) {
+          c.cycle_.push(x);
+        }
+        c.cycle_.push(w);
+        c.cycle_.push(v);
+        assert(c.Check());
+      }
+
+      // short circuit if directed cycle found
+      bool Done() const { return !c.cycle_.empty(); }
+    };
+    dfs.Run(s, marked_, Visitor{*this});
+  }
   // certify that digraph has a directed cycle if it reports one
   bool Check() const;
 
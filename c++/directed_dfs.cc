@@ -1,8 +1,9 @@
 /******************************************************************************
  *  Compilation:  clang++ -c -O2 digraph.cc -std=c++20
- *                clang++ -DDebug -O2 directed_dfs.cc digraph.o -std=c++20 -o directed_dfs
+ *                clang++ -c -O2 compact_digraph.cc -std=c++20
+ *                clang++ -DDebug -O2 directed_dfs.cc digraph.o compact_digraph.o -std=c++20 -pthread -o directed_dfs
  *  Execution:    ./directed_dfs digraph.txt s
- *  Dependencies: digraph.cc
+ *  Dependencies: digraph.cc compact_digraph.cc
  *  Data files:   https://algs4.cs.princeton.edu/42digraph/tinyDG.txt
  *                https://algs4.cs.princeton.edu/42digraph/mediumDG.txt
  *                https://algs4.cs.princeton.edu/42digraph/largeDG.txt
@@ -33,6 +34,9 @@
  *  where <em>V</em> is the number of vertices and <em>E</em> is the number of edges.
  *  Each instance method takes &Theta;(1) time.
  *  It uses &Theta;(<em>V</em>) extra space (not including the digraph).
+ *  A search that borrows a {@link SearchWorkspace} keeps its marks there
+ *  instead, and takes time proportional to the vertices and edges it
+ *  reaches, so many searches of a large digraph cost no more than they visit.
  *  <p>
  *  For additional documentation,
  *  see <a href="https://algs4.cs.princeton.edu/42digraph">Section 4.2</a> of
@@ -44,31 +48,17 @@
 
 #include "directed_dfs.h"
 
-using std::vector;
+#include <stdexcept>
+#include <string>
 
-namespace algs4 {
-DirectedDFS::DirectedDFS(const Digraph& G, int s) noexcept : marked_(G.V()) {
-  Dfs(G, s);
-}
-
-DirectedDFS::DirectedDFS(const Digraph& G, const vector<int>& sources) noexcept:
-  marked_(G.V()) {
-  //        ValidateVertices(sources);
-  for (int v : sources) {
-    if (!marked_[v]) Dfs(G, v);
-  }
-}
+#include "compact_digraph.h"
+#include "digraph.h"
 
-void DirectedDFS::Dfs(const Digraph& G, int v) {
-  count_++;
-  marked_[v] = true;
-  for (int w : G.Adj(v)) {
-    if (!marked_[w]) Dfs(G, w);
-  }
-}
+using std::vector;
 
+namespace algs4 {
 void DirectedDFS::ValidateVertex(int v) const {
-  int V = marked_.size();
+  int V = marked().size();
   if (v < 0 || v >= V)
     throw std::invalid_argument("vertex " + std::to_string(v) + 
                                 " is not between 0 and " + std::to_string(V-1));
@@ -88,6 +78,7 @@ void DirectedDFS::ValidateVertices(const vector<int>& vertices) const {
 #ifdef Debug
 #include <iostream>
 #include <cstdlib>
+using namespace algs4;
 int main(int argc, char *argv[]) {
   std::fstream in(argv[1]);
   if (!in.is_open()) {
@@ -96,6 +87,7 @@ int main(int argc, char *argv[]) {
   }
 
   Digraph G(in);
+  CompactDigraph compact = G.Freeze();
 
   // read in sources from command-line arguments
   vector<int> sources;
@@ -103,7 +95,7 @@ int main(int argc, char *argv[]) {
     sources.push_back(strtol(argv[i], nullptr, 10));
 
   // multiple-source reachability
-  DirectedDFS dfs(G, sources);
+  DirectedDFS dfs(compact, sources);
 
   // print out vertices reachable from sources
   for (int v = 0; v < G.V(); v++) {
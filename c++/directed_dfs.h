@@ -1,10 +1,12 @@
 #ifndef DIRECTED_DFS_
 #define DIRECTED_DFS_
 
-#include "digraph.h"
-
 #include <vector>
 
+#include "depth_first_traversal.h"
+#include "graph_concepts.h"
+#include "search_workspace.h"
+
 namespace algs4 {
 class DirectedDFS {
 public:
@@ -15,7 +17,30 @@ public:
    * @param s the source vertex
    * @throws IllegalArgumentException unless {@code 0 <= s < V}
    */
-  DirectedDFS(const Digraph& G, int s) noexcept;
+  template <DirectedGraph Graph>
+  DirectedDFS(const Graph& G, int s) {
+    own_.marked.Reset(G.V());
+    DepthFirstTraversal<Graph> dfs(G);
+    Dfs(dfs, s);
+  }
+
+  /**
+   * Computes the vertices in digraph {@code G} that are reachable from the
+   * source vertex {@code s}, keeping the marks in {@code workspace}: the
+   * search takes time proportional to the vertices and edges it reaches.
+   * The result is valid until {@code workspace} is used by another search.
+   * @param G the digraph
+   * @param s the source vertex
+   * @param workspace the workspace, which must outlive this object
+   * @throws IllegalArgumentException unless {@code 0 <= s < V}
+   */
+  template <DirectedGraph Graph>
+  DirectedDFS(const Graph& G, int s, SearchWorkspace& workspace) :
+    workspace_(&workspace) {
+    workspace.marked.Reset(G.V());
+    DepthFirstTraversal<Graph> dfs(G, workspace);
+    Dfs(dfs, s);
+  }
 
   /**
    * Computes the vertices in digraph {@code G} that are
@@ -27,7 +52,15 @@ public:
    * @throws IllegalArgumentException unless {@code 0 <= s < V}
    *         for each vertex {@code s} in {@code sources}
    */
-  DirectedDFS(const Digraph& G, const std::vector<int>& sources) noexcept;
+  template <DirectedGraph Graph>
+  DirectedDFS(const Graph& G, const std::vector<int>& sources) {
+    //        ValidateVertices(sources);
+    own_.marked.Reset(G.V());
+    DepthFirstTraversal<Graph> dfs(G);
+    for (int v : sources) {
+      if (!marked()[v]) Dfs(dfs, v);
+    }
+  }
   DirectedDFS() = delete;
   DirectedDFS(const DirectedDFS& other) = default;
   DirectedDFS &operator=(const DirectedDFS& other) = default;
@@ -43,7 +76,7 @@ public:
    */
   bool Marked(int v) const {
     ValidateVertex(v);
-    return marked_[v];
+    return marked()[v];
   }
 
   /**
@@ -57,7 +90,16 @@ public:
   }
 
 private:
-  void Dfs(const Digraph& G, int v);
+  template <typename Traversal>
+  void Dfs(Traversal& dfs, int s) {
+    struct Visitor {
+      int& count;
+      void PreVisit(int) { count++; }
+    };
+    dfs.Run(s, workspace_ ? workspace_->marked : own_.marked, Visitor{count_});
+  }
+
+  const EpochMarks& marked() const { return workspace_ ? workspace_->marked : own_.marked; }
 
   // throw an IllegalArgumentException unless {@code 0 <= v < V}
   void ValidateVertex(int v) const;
@@ -66,7 +108,8 @@ private:
   // or has a vertex not between 0 and V-1
   void ValidateVertices(const std::vector<int>& vertices) const;
 private:
-  std::vector<bool> marked_;  // marked_[v] = true iff v is reachable from source(s)
+  SearchWorkspace own_;                  // own_.marked[v] = true iff v is reachable from source(s)
+  SearchWorkspace* workspace_{nullptr};  // the borrowed workspace, if any, instead of own_
   int count_{0};         // number of vertices reachable from source(s)
 };
 }
@@ -0,0 +1,71 @@
+#ifndef DIRECTION_OPTIMIZING_BFS_H_
+#define DIRECTION_OPTIMIZING_BFS_H_
+
+#include <climits>
+#include <span>
+#include <vector>
+
+#include "compact_digraph.h"
+#include "parallel.h"
+
+/**
+ *  {@code DirectionOptimizingBFS} is the breadth-first search behind
+ *  {@link BreadthFirstDirectedPaths} and {@link BreadthFirstPaths}. It uses
+ *  Beamer, Asanovi&cacute; and Patterson's direction-optimizing strategy
+ *  ("Direction-Optimizing Breadth-First Search", SC 2012). A level is
+ *  expanded either
+ *  <ul>
+ *  <li> <em>top-down</em>: each vertex of the frontier, kept as a list,
+ *       claims its unvisited out-neighbors, or
+ *  <li> <em>bottom-up</em>: each unvisited vertex looks for an in-neighbor
+ *       on the frontier, kept as a bitmap, and stops at the first it finds.
+ *  </ul>
+ *  Top-down costs the edges leaving the frontier, bottom-up at most the
+ *  edges entering the unvisited vertices, and far fewer once the frontier
+ *  holds a large share of the digraph. The search goes bottom-up when the
+ *  edges leaving the frontier exceed 1/14 of those leaving the unvisited
+ *  vertices, and back top-down when the frontier shrinks below 1/24 of the
+ *  vertices.
+ *  <p>
+ *  Both directions split the level among the threads: top-down by blocks of
+ *  the frontier, a vertex going to the thread that claims it first, and
+ *  bottom-up by blocks of 64 vertices, one word of the bitmap. With more
+ *  than one thread the tree may differ from run to run, but the distances
+ *  do not, and every path in it is a shortest path.
+ *  <p>
+ *  It takes &Theta;(<em>V</em> + <em>E</em>) time in the worst case and
+ *  &Theta;(<em>V</em>) extra space, besides the reverse of the digraph.
+ */
+
+namespace algs4 {
+
+/**
+ * A breadth-first search tree: the shortest paths from a set of sources.
+ */
+struct BreadthFirstTree {
+  static constexpr int kInfinity = INT_MAX;
+
+  std::vector<int> edgeTo;     // edgeTo[v] = previous vertex on shortest path to v
+  std::vector<int> distTo;     // distTo[v] = number of edges on shortest path to v
+  int levels{0};               // number of levels expanded
+  int bottom_up_levels{0};     // number of them expanded bottom-up
+};
+
+/**
+ * Computes the shortest paths from the vertices {@code sources}, which
+ * are not validated, in the digraph {@code G}, given with its reverse.
+ * For an undirected graph, both are the same symmetric digraph.
+ *
+ * @param  G the digraph
+ * @param  reverse the reverse of {@code G}
+ * @param  sources the source vertices
+ * @param  threads the number of threads
+ * @return the breadth-first search tree; the distance of a vertex that is
+ *         not reachable is {@code kInfinity}
+ */
+BreadthFirstTree DirectionOptimizingBFS(const CompactDigraph& G, const CompactDigraph& reverse,
+                                        std::span<const int> sources,
+                                        int threads = DefaultThreads());
+}
+
+#endif  // DIRECTION_OPTIMIZING_BFS_H_
@@ -0,0 +1,392 @@
+/******************************************************************************
+ *  Compilation:  clang++ -c -O2 directed_edge.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_digraph.cc -std=c++20
+ *                clang++ -c -O2 depth_first_order.cc -std=c++20
+ *                clang++ -c -O2 topological_sort.cc -std=c++20
+ *                clang++ -c -O2 directed_dfs.cc -std=c++20
+ *                clang++ -DDebug -O2 dynamic_digraph.cc directed_edge.o edge_weighted_digraph.o depth_first_order.o topological_sort.o directed_dfs.o -std=c++20 -pthread -o dynamic_digraph
+ *  Execution:    ./dynamic_digraph V batches batch-size seed [threshold]
+ *  Dependencies: directed_edge.cc edge_weighted_digraph.cc graph_generator.h
+ *                directed_dfs.h dijkstra_sp.h topological_sort.h
+ *
+ *  A digraph that is updated in batches while readers run graph algorithms
+ *  on consistent snapshots of it.
+ *
+ *  % ./dynamic_digraph 100000 200 10000 1
+ *  100000 vertices, 200 batches of 10000 additions and 2500 removals
+ *  updates:  13.611 s, 169 compactions
+ *  readers: 93 snapshots checked with DirectedDFS, DijkstraSP and Topological
+ *  final snapshot: 1504694 edges, 0 in the delta log
+ *  final snapshot matches a rebuilt EdgeWeightedDigraph
+ *
+ ******************************************************************************/
+
+#include "dynamic_digraph.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+using std::make_shared;
+using std::pair;
+using std::shared_ptr;
+using std::vector;
+
+namespace algs4 {
+DynamicDigraph::Snapshot::Snapshot(int V, int E, shared_ptr<const Base> base,
+                                   shared_ptr<const Delta> delta) noexcept :
+  V_(V), E_(E), base_(std::move(base)), delta_(std::move(delta)) {}
+
+int DynamicDigraph::Snapshot::Outdegree(int v) const {
+  ValidateVertex(v);
+  return static_cast<int>(Adj(v).size());
+}
+
+int DynamicDigraph::Snapshot::Find(int v, int w) const {
+  ValidateVertex(v);
+  ValidateVertex(w);
+  auto adj = Adj(v);
+  auto it = std::ranges::lower_bound(adj, w, {}, [this](int e) { return to(e); });
+  return it != adj.end() && to(*it) == w ? *it : -1;
+}
+
+vector<DirectedEdge> DynamicDigraph::Snapshot::edges() const {
+  vector<DirectedEdge> list;
+  list.reserve(E_);
+  for (int v = 0; v < V_; v++) {
+    for (int e : Adj(v))
+      list.emplace_back(v, to(e), weight(e));
+  }
+
+  return list;
+}
+
+// throw an IllegalArgumentException unless {@code 0 <= v < V}
+void DynamicDigraph::Snapshot::ValidateVertex(int v) const {
+  if (v < 0 || v >= V_)
+    throw std::invalid_argument("vertex " + std::to_string(v) +
+                                " is not between 0 and " + std::to_string(V_-1));
+}
+
+DynamicDigraph::DynamicDigraph(int V, int threshold) :
+  V_(V), threshold_(threshold),
+  current_(V, 0, nullptr, make_shared<Delta>()) {
+  if (V < 0) throw std::invalid_argument("Number of vertices must be non-negative");
+  if (threshold < 0) throw std::invalid_argument("threshold must be non-negative");
+  auto base = make_shared<Base>();
+  base->offsets.assign(V + 1, 0);
+  current_.base_ = std::move(base);
+}
+
+DynamicDigraph::~DynamicDigraph() {
+  if (compactor_.joinable()) compactor_.join();
+}
+
+DynamicDigraph::Snapshot DynamicDigraph::snapshot() const {
+  std::lock_guard<std::mutex> lock(version_mutex_);
+  return current_;
+}
+
+int DynamicDigraph::compactions() const {
+  return compactions_.load(std::memory_order_relaxed);
+}
+
+void DynamicDigraph::Update(std::span<const DirectedEdge> added,
+                            std::span<const pair<int, int>> removed) {
+  auto validate = [this](int v) {
+    if (v < 0 || v >= V_)
+      throw std::invalid_argument("vertex " + std::to_string(v) +
+                                  " is not between 0 and " + std::to_string(V_-1));
+  };
+  for (const DirectedEdge& e : added) {
+    validate(e.from());
+    validate(e.to());
+  }
+  for (auto [v, w] : removed) {
+    validate(v);
+    validate(w);
+  }
+  Batch batch{vector<DirectedEdge>(added.begin(), added.end()),
+              vector<pair<int, int>>(removed.begin(), removed.end())};
+
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  Publish(Apply(current_, batch));
+  if (compacting_)
+    log_.push_back(std::move(batch));
+  else if (current_.DeltaSize() > threshold_)
+    StartCompaction();
+}
+
+void DynamicDigraph::Compact() {
+  std::unique_lock<std::mutex> lock(write_mutex_);
+  compacted_.wait(lock, [this] { return !compacting_; });
+  if (current_.DeltaSize() == 0) return;
+  Publish(Snapshot(V_, current_.E_, Merge(current_), make_shared<Delta>()));
+  compactions_.fetch_add(1, std::memory_order_relaxed);
+}
+
+DynamicDigraph::Snapshot DynamicDigraph::Apply(const Snapshot& s, const Batch& batch) {
+  // one operation per edge: sort the removals of each edge before its
+  // additions, and those in batch order, so that only the last one counts
+  struct Op {
+    int v, w;
+    int order;  // -1 for a removal, the position in the batch for an addition
+    double weight;
+  };
+  vector<Op> ops;
+  ops.reserve(batch.added.size() + batch.removed.size());
+  for (auto [v, w] : batch.removed)
+    ops.push_back({v, w, -1, 0.0});
+  for (int i = 0; i < static_cast<int>(batch.added.size()); i++) {
+    const DirectedEdge& e = batch.added[i];
+    ops.push_back({e.from(), e.to(), i, e.weight()});
+  }
+  std::sort(ops.begin(), ops.end(), [](const Op& a, const Op& b) {
+    if (a.v != b.v) return a.v < b.v;
+    if (a.w != b.w) return a.w < b.w;
+    return a.order < b.order;
+  });
+  auto last = std::unique(ops.rbegin(), ops.rend(), [](const Op& a, const Op& b) {
+    return a.v == b.v && a.w == b.w;
+  });
+  ops.erase(ops.begin(), last.base());
+
+  vector<int> touched;
+  for (const Op& op : ops) {
+    if (touched.empty() || touched.back() != op.v) touched.push_back(op.v);
+  }
+
+  // copy the replacement lists of the other vertices
+  auto delta = make_shared<Delta>();
+  delta->lists.reserve(s.delta_->lists.size() + touched.size());
+  delta->tails.reserve(s.delta_->heads.size() + ops.size());
+  delta->heads.reserve(s.delta_->heads.size() + ops.size());
+  delta->weights.reserve(s.delta_->heads.size() + ops.size());
+  auto append = [&delta](int v, int w, double weight) {
+    delta->tails.push_back(v);
+    delta->heads.push_back(w);
+    delta->weights.push_back(weight);
+  };
+  for (const auto& [v, list] : s.delta_->lists) {
+    if (std::binary_search(touched.begin(), touched.end(), v)) continue;
+    int begin = static_cast<int>(delta->heads.size());
+    for (int i = list.first; i < list.second; i++)
+      append(v, s.delta_->heads[i], s.delta_->weights[i]);
+    delta->lists.emplace(v, pair<int, int>(begin, static_cast<int>(delta->heads.size())));
+  }
+
+  // merge the operations on each touched vertex into its current list;
+  // both are in order of head vertex
+  int E = s.E_;
+  for (size_t i = 0, j = 0; i < ops.size(); i = j) {
+    int v = ops[i].v;
+    for (j = i; j < ops.size() && ops[j].v == v; j++) {}
+    auto adj = s.Adj(v);
+    auto e = adj.begin();
+    int begin = static_cast<int>(delta->heads.size());
+    for (size_t k = i; e != adj.end() || k < j; ) {
+      if (k == j || (e != adj.end() && s.to(*e) < ops[k].w)) {
+        append(v, s.to(*e), s.weight(*e));
+        ++e;
+        continue;
+      }
+      if (e != adj.end() && s.to(*e) == ops[k].w) ++e;
+      if (ops[k].order >= 0) append(v, ops[k].w, ops[k].weight);
+      ++k;
+    }
+    int end = static_cast<int>(delta->heads.size());
+    E += end - begin - static_cast<int>(adj.size());
+    delta->lists.emplace(v, pair<int, int>(begin, end));
+  }
+
+  return Snapshot(s.V_, E, s.base_, std::move(delta));
+}
+
+shared_ptr<const DynamicDigraph::Base> DynamicDigraph::Merge(const Snapshot& s) {
+  auto base = make_shared<Base>();
+  base->offsets.resize(s.V_ + 1);
+  base->tails.reserve(s.E_);
+  base->heads.reserve(s.E_);
+  base->weights.reserve(s.E_);
+  for (int v = 0; v < s.V_; v++) {
+    for (int e : s.Adj(v)) {
+      base->tails.push_back(v);
+      base->heads.push_back(s.to(e));
+      base->weights.push_back(s.weight(e));
+    }
+    base->offsets[v + 1] = static_cast<int>(base->heads.size());
+  }
+
+  return base;
+}
+
+void DynamicDigraph::Publish(Snapshot s) {
+  // swap under the lock, and release the previous version outside it
+  std::lock_guard<std::mutex> lock(version_mutex_);
+  std::swap(current_, s);
+}
+
+void DynamicDigraph::StartCompaction() {
+  // a finished compaction thread may still be exiting
+  if (compactor_.joinable()) compactor_.join();
+  compacting_ = true;
+  compactor_ = std::thread(&DynamicDigraph::RunCompaction, this, current_);
+}
+
+void DynamicDigraph::RunCompaction(Snapshot target) {
+  shared_ptr<const Base> base;
+  try {
+    base = Merge(target);
+  } catch (const std::bad_alloc&) {
+    // keep the delta log; the next update that finds it too large retries
+  }
+
+  // replay the updates made since target on top of the new base
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  if (base) {
+    Snapshot s(V_, target.E_, std::move(base), make_shared<Delta>());
+    for (const Batch& batch : log_)
+      s = Apply(s, batch);
+    Publish(std::move(s));
+    compactions_.fetch_add(1, std::memory_order_relaxed);
+  }
+  log_.clear();
+  compacting_ = false;
+  compacted_.notify_all();
+}
+}
+
+/**
+ * Unit tests the {@code DynamicDigraph} data type.
+ *
+ * @param args the command-line arguments
+ */
+#ifdef Debug
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <map>
+
+#include "dijkstra_sp.h"
+#include "directed_dfs.h"
+#include "edge_weighted_digraph.h"
+#include "graph_generator.h"
+#include "topological_sort.h"
+
+using namespace algs4;
+using Clock = std::chrono::steady_clock;
+
+// the edges of the snapshot are in order of head, E() is their number,
+// it is a DAG, and the algorithms agree with each other
+bool CheckSnapshot(const DynamicDigraph::Snapshot& s) {
+  int E = 0;
+  for (int v = 0; v < s.V(); v++) {
+    int previous = -1;
+    for (int e : s.Adj(v)) {
+      if (s.from(e) != v || s.to(e) <= previous) return false;
+      previous = s.to(e);
+      E++;
+    }
+  }
+  if (E != s.E()) return false;
+
+  Topological topological(s);
+  if (!topological.HasOrder()) return false;
+  DirectedDFS dfs(s, 0);
+  DijkstraSP<DynamicDigraph::Snapshot> sp(s, 0);
+  for (int v = 0; v < s.V(); v++) {
+    if (dfs.Marked(v) != sp.hasPathTo(v)) return false;
+  }
+  return true;
+}
+
+int main(int argc, char *argv[]) {
+  int V = std::stoi(argv[1]);
+  int batches = std::stoi(argv[2]);
+  int batch_size = std::stoi(argv[3]);
+  uint64_t seed = std::stoull(argv[4]);
+  int threshold = argc > 5 ? std::stoi(argv[5]) : 1 << 16;
+
+  // the edges of the model, directed from the smaller vertex to the larger
+  // so that every snapshot is a DAG
+  GraphModel model = GraphModel::ErdosRenyi(V, batches * batch_size, seed);
+  auto edge = [&model](int e) {
+    auto [v, w] = model.Endpoints(e);
+    return DirectedEdge(std::min(v, w), std::max(v, w), model.Weight(e));
+  };
+
+  DynamicDigraph G(V, threshold);
+  std::atomic<bool> done{false};
+  std::atomic<int> checked{0};
+  std::atomic<bool> consistent{true};
+  std::thread reader([&] {
+    while (!done.load()) {
+      if (!CheckSnapshot(G.snapshot())) consistent = false;
+      checked++;
+    }
+  });
+
+  // batch b adds the edges of block b and removes every fourth edge of
+  // block b - 2; the reference follows along
+  std::map<std::pair<int, int>, double> reference;
+  Clock::time_point start = Clock::now();
+  for (int b = 0; b < batches; b++) {
+    vector<DirectedEdge> added;
+    vector<pair<int, int>> removed;
+    for (int e = b * batch_size; e < (b + 1) * batch_size; e++) {
+      DirectedEdge d = edge(e);
+      if (d.from() == d.to()) continue;
+      added.push_back(d);
+    }
+    if (b >= 2) {
+      for (int e = (b - 2) * batch_size; e < (b - 1) * batch_size; e += 4) {
+        DirectedEdge d = edge(e);
+        removed.emplace_back(d.from(), d.to());
+      }
+    }
+    G.Update(added, removed);
+    for (auto [v, w] : removed)
+      reference.erase({v, w});
+    for (const DirectedEdge& d : added)
+      reference[{d.from(), d.to()}] = d.weight();
+  }
+  double update_time = std::chrono::duration<double>(Clock::now() - start).count();
+  done = true;
+  reader.join();
+  G.Compact();
+
+  printf("%d vertices, %d batches of %d additions and %d removals\n",
+         V, batches, batch_size, batch_size / 4);
+  printf("updates: %7.3f s, %d compactions\n", update_time, G.compactions());
+  printf("readers: %d snapshots checked with DirectedDFS, DijkstraSP and Topological\n",
+         checked.load());
+
+  DynamicDigraph::Snapshot s = G.snapshot();
+  printf("final snapshot: %d edges, %d in the delta log\n", s.E(), s.DeltaSize());
+  vector<int> from, to;
+  vector<double> weights;
+  bool identical = s.E() == static_cast<int>(reference.size()) && CheckSnapshot(s);
+  auto it = reference.begin();
+  for (const DirectedEdge& e : s.edges()) {
+    if (!identical) break;
+    identical = e.from() == it->first.first && e.to() == it->first.second &&
+                e.weight() == it->second;
+    from.push_back(e.from());
+    to.push_back(e.to());
+    weights.push_back(e.weight());
+    ++it;
+  }
+  if (identical) {
+    EdgeWeightedDigraph H(V, std::move(from), std::move(to), std::move(weights));
+    DijkstraSP<DynamicDigraph::Snapshot> sp(s, 0);
+    DijkstraSP<EdgeWeightedDigraph> expected(H, 0);
+    for (int v = 0; identical && v < V; v++)
+      identical = sp.distTo(v) == expected.distTo(v);
+  }
+  printf("final snapshot %s a rebuilt EdgeWeightedDigraph\n",
+         identical ? "matches" : "differs from");
+  if (!consistent) printf("a snapshot was inconsistent\n");
+
+  return identical && consistent ? 0 : 1;
+}
+#endif
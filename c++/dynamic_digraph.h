@@ -0,0 +1,300 @@
+#ifndef DYNAMIC_DIGRAPH_H_
+#define DYNAMIC_DIGRAPH_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "directed_edge.h"
+
+/**
+ *  The {@code DynamicDigraph} class represents an edge-weighted digraph on a
+ *  fixed set of <em>V</em> vertices whose edges change over time, in
+ *  batches, while other threads keep reading it.
+ *  It is a set of edges: there is at most one edge <em>v</em>-&gt;<em>w</em>,
+ *  and adding an edge that is already present replaces its weight.
+ *  <p>
+ *  The edges are kept as a compact <em>base</em>, the adjacency lists in
+ *  compressed sparse row form, plus a <em>delta log</em> holding a
+ *  replacement adjacency list for each vertex that has been updated since.
+ *  Both are immutable once published. {@code Update} applies a batch of
+ *  removals and additions by copying the delta with the lists of the
+ *  touched vertices rebuilt, and publishes the new version; readers call
+ *  {@code snapshot()} to pin the current version, which stays unchanged,
+ *  and alive, for as long as they hold it. A batch is never seen half
+ *  applied.
+ *  <p>
+ *  Once the delta holds more than {@code threshold} edges, a background
+ *  thread merges the base and the delta of the current version into a new
+ *  base. Updates continue meanwhile and are logged; when the merge is done
+ *  they are replayed on top of the new base and the result is published in
+ *  their place, so that a compaction is never visible to readers except
+ *  as a smaller delta.
+ *  <p>
+ *  A {@code DynamicDigraph::Snapshot} is a {@code WeightedDigraph} (see
+ *  graph_concepts.h), so {@link DirectedDFS}, {@link DijkstraSP},
+ *  {@link Topological} and the other graph algorithms run on it directly,
+ *  without blocking ingestion. The adjacency list of each vertex is in
+ *  order of head vertex. Edge ids are only meaningful within a snapshot
+ *  and are not dense: they are below {@code IdBound()}, which may exceed
+ *  <em>E</em>, and the ids of the live edges are those returned by
+ *  {@code Adj(v)}.
+ *  <p>
+ *  {@code snapshot()} takes constant time. An update of a batch of
+ *  <em>k</em> edges takes time proportional to <em>k</em> log <em>k</em>
+ *  plus the size of the delta, which the threshold bounds, plus the
+ *  outdegrees of the touched vertices.
+ *  A compaction takes time proportional to <em>V</em> + <em>E</em>, off the
+ *  update path. {@code Update} and {@code snapshot()} may be called from
+ *  any number of threads; updates are applied one batch at a time.
+ */
+
+namespace algs4 {
+
+class DynamicDigraph {
+  struct Base;
+  struct Delta;
+
+public:
+  class Snapshot {
+  public:
+    /**
+     * Returns the number of vertices in the digraph.
+     *
+     * @return the number of vertices in the digraph
+     */
+    int V() const { return V_; }
+    /**
+     * Returns the number of edges in the digraph.
+     *
+     * @return the number of edges in the digraph
+     */
+    int E() const { return E_; }
+    /**
+     * Returns a bound on the edge ids of this snapshot.
+     *
+     * @return one more than the largest edge id
+     */
+    int IdBound() const;
+    /**
+     * Returns the number of edges in the delta log: the edges in the
+     * adjacency lists of the vertices updated since the last compaction.
+     *
+     * @return the number of edges in the delta log
+     */
+    int DeltaSize() const;
+    /**
+     * Returns the ids of the edges incident from vertex {@code v}, in
+     * order of head vertex. The vertex is not validated.
+     *
+     * @param  v the vertex
+     * @return the ids of the edges incident from vertex {@code v}, as an iterable
+     */
+    std::ranges::iota_view<int, int> Adj(int v) const;
+    /**
+     * Returns the number of edges incident from vertex {@code v}.
+     *
+     * @param  v the vertex
+     * @return the outdegree of vertex {@code v}
+     * @throws IllegalArgumentException unless {@code 0 <= v < V}
+     */
+    int Outdegree(int v) const;
+    /**
+     * Returns the tail vertex of the edge with id {@code e}.
+     */
+    int from(int e) const;
+    /**
+     * Returns the head vertex of the edge with id {@code e}.
+     */
+    int to(int e) const;
+    /**
+     * Returns the weight of the edge with id {@code e}.
+     */
+    double weight(int e) const;
+    /**
+     * Returns the id of the edge {@code v->w}, or -1 if there is none.
+     *
+     * @param  v the tail vertex
+     * @param  w the head vertex
+     * @return the id of the edge {@code v->w}, or -1 if there is none
+     * @throws IllegalArgumentException unless both {@code 0 <= v < V} and {@code 0 <= w < V}
+     */
+    int Find(int v, int w) const;
+    /**
+     * Returns all edges of this snapshot, in order of tail vertex and then
+     * head vertex.
+     *
+     * @return all edges of this snapshot, as an iterable
+     */
+    std::vector<DirectedEdge> edges() const;
+
+  private:
+    friend class DynamicDigraph;
+    Snapshot(int V, int E, std::shared_ptr<const Base> base,
+             std::shared_ptr<const Delta> delta) noexcept;
+    void ValidateVertex(int v) const;
+
+    int V_;
+    int E_;
+    std::shared_ptr<const Base> base_;
+    std::shared_ptr<const Delta> delta_;
+  };
+
+  /**
+   * Initializes an empty dynamic digraph with {@code V} vertices.
+   *
+   * @param  V the number of vertices
+   * @param  threshold the number of edges in the delta log above which it
+   *         is merged into the base in the background
+   * @throws IllegalArgumentException if {@code V < 0} or {@code threshold < 0}
+   */
+  explicit DynamicDigraph(int V, int threshold = 1 << 16);
+  DynamicDigraph() = delete;
+  DynamicDigraph(const DynamicDigraph& other) = delete;
+  DynamicDigraph &operator=(const DynamicDigraph& other) = delete;
+  DynamicDigraph(DynamicDigraph&& other) = delete;
+  DynamicDigraph &operator=(DynamicDigraph&& other) = delete;
+  /**
+   * Waits for a background compaction to finish.
+   */
+  ~DynamicDigraph();
+
+  /**
+   * Returns the number of vertices in the digraph.
+   *
+   * @return the number of vertices in the digraph
+   */
+  int V() const { return V_; }
+  /**
+   * Returns the current version of the digraph. The snapshot is not
+   * affected by later updates.
+   *
+   * @return the current version of the digraph
+   */
+  Snapshot snapshot() const;
+  /**
+   * Applies a batch of updates: removes the edges {@code v->w} for each pair
+   * in {@code removed} that are present, and then adds the edges in
+   * {@code added}, replacing the weight of those already present. If an
+   * edge is added more than once, the last weight wins. The whole batch
+   * becomes visible at once, or not at all if it throws.
+   *
+   * @param  added the edges to add
+   * @param  removed the tail and head vertices of the edges to remove
+   * @throws IllegalArgumentException unless all endpoints are between 0 and <em>V</em> - 1
+   */
+  void Update(std::span<const DirectedEdge> added,
+              std::span<const std::pair<int, int>> removed);
+  /**
+   * Adds a batch of edges; see {@code Update}.
+   */
+  void AddEdges(std::span<const DirectedEdge> added) { Update(added, {}); }
+  /**
+   * Removes a batch of edges; see {@code Update}.
+   */
+  void RemoveEdges(std::span<const std::pair<int, int>> removed) { Update({}, removed); }
+  /**
+   * Waits for a background compaction to finish, if one is running, and
+   * then merges the delta log into the base.
+   */
+  void Compact();
+  /**
+   * Returns the number of compactions so far.
+   *
+   * @return the number of compactions so far
+   */
+  int compactions() const;
+
+private:
+  // one batch of Update, as logged while a compaction runs
+  struct Batch {
+    std::vector<DirectedEdge> added;
+    std::vector<std::pair<int, int>> removed;
+  };
+
+  // the snapshot that results from applying the batch to snapshot s
+  static Snapshot Apply(const Snapshot& s, const Batch& batch);
+  // the base holding all edges of snapshot s
+  static std::shared_ptr<const Base> Merge(const Snapshot& s);
+  // both require write_mutex_
+  void Publish(Snapshot s);
+  void StartCompaction();
+  // the body of the background thread
+  void RunCompaction(Snapshot target);
+
+  int V_;
+  int threshold_;
+  // serializes writers; guards everything below but current_
+  std::mutex write_mutex_;
+  bool compacting_ = false;
+  std::vector<Batch> log_;
+  std::thread compactor_;
+  std::condition_variable compacted_;
+  std::atomic<int> compactions_{0};
+  // guards the replacement of current_
+  mutable std::mutex version_mutex_;
+  Snapshot current_;
+};
+
+// the edges in compressed sparse row form: those of vertex v are in
+// positions [offsets[v], offsets[v + 1]), which are also their ids
+struct DynamicDigraph::Base {
+  std::vector<int> offsets;
+  std::vector<int> tails;
+  std::vector<int> heads;
+  std::vector<double> weights;
+};
+
+// the replacement adjacency lists of the updated vertices, stored one after
+// the other: those of vertex v are in positions lists.at(v), and their ids
+// follow the base ids
+struct DynamicDigraph::Delta {
+  std::unordered_map<int, std::pair<int, int>> lists;
+  std::vector<int> tails;
+  std::vector<int> heads;
+  std::vector<double> weights;
+};
+
+inline int DynamicDigraph::Snapshot::IdBound() const {
+  return static_cast<int>(base_->heads.size() + delta_->heads.size());
+}
+
+inline int DynamicDigraph::Snapshot::DeltaSize() const {
+  return static_cast<int>(delta_->heads.size());
+}
+
+inline std::ranges::iota_view<int, int> DynamicDigraph::Snapshot::Adj(int v) const {
+  if (!delta_->lists.empty()) {
+    auto it = delta_->lists.find(v);
+    if (it != delta_->lists.end()) {
+      int offset = static_cast<int>(base_->heads.size());
+      return {offset + it->second.first, offset + it->second.second};
+    }
+  }
+  return {base_->offsets[v], base_->offsets[v + 1]};
+}
+
+inline int DynamicDigraph::Snapshot::from(int e) const {
+  int n = static_cast<int>(base_->tails.size());
+  return e < n ? base_->tails[e] : delta_->tails[e - n];
+}
+
+inline int DynamicDigraph::Snapshot::to(int e) const {
+  int n = static_cast<int>(base_->heads.size());
+  return e < n ? base_->heads[e] : delta_->heads[e - n];
+}
+
+inline double DynamicDigraph::Snapshot::weight(int e) const {
+  int n = static_cast<int>(base_->weights.size());
+  return e < n ? base_->weights[e] : delta_->weights[e - n];
+}
+}
+
+#endif  // DYNAMIC_DIGRAPH_H_
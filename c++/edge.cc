@@ -11,6 +11,7 @@
 
 #include <cassert>
 #include <exception>
+#include <stdexcept>
 
 using std::string;
 using std::to_string;
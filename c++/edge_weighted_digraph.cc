@@ -1,8 +1,8 @@
 /******************************************************************************
  *  Compilation:  clang++ -c directed_edge.cc -std=c++20
- *                clang++ -g -DDebug edge_weighted_digraph.cc directed_edge.o -std=c++20 -o edge_weighted_digraph
+ *                clang++ -g -DDebug edge_weighted_digraph.cc directed_edge.o -std=c++20 -pthread -o edge_weighted_digraph
  *  Execution:    ./edge_weighted_digraph input.txt
- *  Dependencies: directed_edge.h
+ *  Dependencies: directed_edge.h graph_generator.h
  *  Data files:   https://algs4.cs.princeton.edu/44st/tinyEWG.txt
  *                https://algs4.cs.princeton.edu/44st/mediumEWG.txt
  *                https://algs4.cs.princeton.edu/44st/largeEWG.txt
@@ -21,9 +21,12 @@
  *  methods for returning the number of vertices <em>V</em> and the number
  *  of edges <em>E</em>. Parallel edges and self-loops are permitted.
  *  <p>
- *  This implementation uses an adjacency-lists representation, which 
- *  is a vertex-indexed array of {@link Bag} objects.
- *  All operations take constant time (in the worst case) except
+ *  This implementation stores the edges once, in three parallel arrays
+ *  (tail, head and weight) indexed by a stable edge id, and indexes them by
+ *  tail vertex in compressed-sparse-row form. The index is rebuilt by a
+ *  counting sort the first time it is needed after edges were added, which
+ *  takes time proportional to <em>V</em> + <em>E</em>; all other
+ *  operations take constant time (in the worst case) except
  *  iterating over the edges incident from a given vertex, which takes
  *  time proportional to the number of such edges.
  *  <p>
@@ -37,17 +40,19 @@
 
 #include "edge_weighted_digraph.h"
 
-#include <unordered_set>
+#include <algorithm>
+#include <cassert>
+#include <climits>
 #include <exception>
 #include <vector>
 #include <fstream>
+#include <utility>
 
-#include "directed_edge.h"
+#include "graph_generator.h"
 
 using std::vector;
 using std::string;
 using std::fstream;
-using std::unordered_set;
 
 namespace algs4 {
 /**
@@ -56,32 +61,33 @@ namespace algs4 {
  * @param  V the number of vertices
  * @throws IllegalArgumentException if {@code V < 0}
  */
-EdgeWeightedDigraph::EdgeWeightedDigraph(int V) noexcept: v_(V), e_(0), adj_(V), 
-                                                          indegree_(V), gen_(rd_()) {
+EdgeWeightedDigraph::EdgeWeightedDigraph(int V) noexcept: v_(V), indegree_(V), 
+                                                          offsets_(V + 1) {
   assert(V > 0);
   //        throw std::invalid_argument("Number of vertices in a Digraph must be nonnegative");
 }
 
 /**
- * Initializes a random edge-weighted digraph with {@code V} vertices and <em>E</em> edges.
+ * Initializes a random edge-weighted digraph with {@code V} vertices and <em>E</em> edges,
+ * the Erdős–Rényi {@link GraphModel} with the given {@code seed}.
  *
  * @param  V the number of vertices
  * @param  E the number of edges
+ * @param  seed the seed; the same seed always gives the same digraph
  * @throws IllegalArgumentException if {@code V < 0}
  * @throws IllegalArgumentException if {@code E < 0}
  */
-EdgeWeightedDigraph::EdgeWeightedDigraph(int V, int E) noexcept: EdgeWeightedDigraph(V) {
-  assert (E < 0);
-  //        throw std::invalid_argument("Number of edges in a Digraph must be nonnegative");
-  std::uniform_int_distribution<> dis(0, V - 1); 
-  std::uniform_int_distribution<> dis100(0, 100 - 1); 
-  for (int i = 0; i < E; i++) {
-    int v = dis(gen_);
-    int w = dis(gen_);
-    double weight = 0.01 * dis100(gen_);
-    DirectedEdge* e = new DirectedEdge(v, w, weight);
-    AddEdge(e);
-  }
+EdgeWeightedDigraph::EdgeWeightedDigraph(int V, int E, uint64_t seed) : EdgeWeightedDigraph(V) {
+  GraphModel model = GraphModel::ErdosRenyi(V, E, seed);
+  vector<DirectedEdge> edges(E, DirectedEdge(0, 0, 0.0));
+  ParallelFor(E, DefaultThreads(), [&](long long begin, long long end) {
+    for (int e = begin; e < end; e++) {
+      auto [v, w] = model.Endpoints(e);
+      edges[e] = DirectedEdge(v, w, model.Weight(e));
+    }
+  });
+  AddEdges(edges);
+  BuildAdjacency();
 }
 
 /**  
@@ -95,11 +101,10 @@ EdgeWeightedDigraph::EdgeWeightedDigraph(int V, int E) noexcept: EdgeWeightedDig
  * @throws IllegalArgumentException if the endpoints of any edge are not in prescribed range
  * @throws IllegalArgumentException if the number of vertices or edges is negative
  */
-EdgeWeightedDigraph::EdgeWeightedDigraph(fstream& in): gen_(rd_()) {
+EdgeWeightedDigraph::EdgeWeightedDigraph(fstream& in) {
   string line;
   getline(in, line);
   v_ = stoi(line);
-  e_ = 0;
 
   if (v_ < 0) 
     throw std::invalid_argument("Number of vertices in a Digraph must be nonnegative");
@@ -109,7 +114,10 @@ EdgeWeightedDigraph::EdgeWeightedDigraph(fstream& in): gen_(rd_()) {
   if (E < 0) throw std::invalid_argument("Number of edges must be nonnegative");
 
   indegree_.resize(v_);
-  adj_.resize(v_);
+  offsets_.resize(v_ + 1);
+  from_.reserve(E);
+  to_.reserve(E);
+  weight_.reserve(E);
 		
   for (int i = 0; i < E; i++) {
     std::getline(in, line);
@@ -123,8 +131,39 @@ EdgeWeightedDigraph::EdgeWeightedDigraph(fstream& in): gen_(rd_()) {
 
     str = end;
     double weight = std::strtod(str, &end);
-    AddEdge(new DirectedEdge(v, w, weight));
+    AddEdge(v, w, weight);
   }
+  BuildAdjacency();
+}
+
+/**
+ * Initializes an edge-weighted digraph from its edge arrays: the edge with
+ * id <em>e</em> is {@code from[e]}→{@code to[e]} with weight {@code weight[e]}.
+ *
+ * @param  V the number of vertices
+ * @param  from the tail vertex of each edge
+ * @param  to the head vertex of each edge
+ * @param  weight the weight of each edge
+ * @throws IllegalArgumentException if {@code V < 0}
+ * @throws IllegalArgumentException if the three arrays differ in length
+ * @throws IllegalArgumentException if the endpoints of any edge are not in prescribed range
+ */
+EdgeWeightedDigraph::EdgeWeightedDigraph(int V, vector<int> from, vector<int> to,
+                                         vector<double> weight) :
+  v_(V), from_(std::move(from)), to_(std::move(to)), weight_(std::move(weight)) {
+  if (v_ < 0) 
+    throw std::invalid_argument("Number of vertices in a Digraph must be nonnegative");
+  if (to_.size() != from_.size() || weight_.size() != from_.size())
+    throw std::invalid_argument("edge arrays differ in length");
+
+  indegree_.resize(v_);
+  for (size_t e = 0; e < from_.size(); e++) {
+    ValidateVertex(from_[e]);
+    ValidateVertex(to_[e]);
+    ++indegree_[to_[e]];
+  }
+  adj_stale_ = true;
+  BuildAdjacency();
 }
 
 /**
@@ -134,11 +173,13 @@ EdgeWeightedDigraph::EdgeWeightedDigraph(fstream& in): gen_(rd_()) {
  */
 EdgeWeightedDigraph::EdgeWeightedDigraph(const EdgeWeightedDigraph& G) noexcept : 
   EdgeWeightedDigraph(G.V()) {
-  e_ = G.E();
-  for (int v = 0; v < G.V(); v++)
-    indegree_[v] = G.indegree(v);
-  for (int v = 0; v < G.V(); v++)
-    adj_[v] = G.Adj(v);
+  G.BuildAdjacency();
+  from_ = G.from_;
+  to_ = G.to_;
+  weight_ = G.weight_;
+  indegree_ = G.indegree_;
+  offsets_ = G.offsets_;
+  adj_ = G.adj_;
 }
 
   // throw an IllegalArgumentException unless {@code 0 <= v < V}
@@ -148,33 +189,133 @@ void EdgeWeightedDigraph::ValidateVertex(int v) const {
                                     " is not between 0 and " + std::to_string(v_-1));
 }
 
+// rebuild offsets_ and adj_ if edges were added since the last build
+void EdgeWeightedDigraph::BuildAdjacency() const {
+  if (!adj_stale_.load(std::memory_order_acquire)) return;
+  std::lock_guard<std::mutex> lock(adj_mutex_);
+  if (!adj_stale_.load(std::memory_order_relaxed)) return;
+
+  // counting sort of the edge ids by tail vertex; stable, so each
+  // adjacency list keeps insertion order
+  int E = from_.size();
+  offsets_.assign(v_ + 1, 0);
+  for (int e = 0; e < E; e++)
+    ++offsets_[from_[e] + 1];
+  for (int v = 0; v < v_; v++)
+    offsets_[v + 1] += offsets_[v];
+  vector<int> next(offsets_.cbegin(), offsets_.cend() - 1);
+  adj_.resize(E);
+  for (int e = 0; e < E; e++)
+    adj_[next[from_[e]]++] = e;
+
+  adj_stale_.store(false, std::memory_order_release);
+}
+
 /**
- * Adds the directed edge {@code e} to this edge-weighted digraph.
+ * Adds the directed edge v→w with the given {@code weight} to this
+ * edge-weighted digraph.
  *
- * @param  e the edge
- * @throws IllegalArgumentException unless endpoints of edge are between {@code 0}
- *         and {@code V-1}
+ * @param  v the tail vertex
+ * @param  w the head vertex
+ * @param  weight the weight of the edge
+ * @return the id of the new edge; ids are assigned 0, 1, 2, ... in insertion order
+ * @throws IllegalArgumentException unless both {@code 0 <= v < V} and {@code 0 <= w < V}
  */
-void EdgeWeightedDigraph::AddEdge(DirectedEdge* e) {
-  int v = e->from();
-  int w = e->to();
+int EdgeWeightedDigraph::AddEdge(int v, int w, double weight) {
   ValidateVertex(v);
   ValidateVertex(w);
-  adj_[v].push_back(e);
+  from_.push_back(v);
+  to_.push_back(w);
+  weight_.push_back(weight);
   ++indegree_[w];
-  ++e_;
+  adj_stale_.store(true, std::memory_order_relaxed);
+
+  return from_.size() - 1;
 }
 
 /**
- * Returns the directed edges incident from vertex {@code v}.
+ * Adds the directed edges {@code edges} to this edge-weighted digraph, in
+ * the same order and with the same ids as that many calls to
+ * {@code AddEdge} would.
+ *
+ * @param  edges the edges
+ * @param  threads the number of threads to use
+ * @return the id of the first new edge; the others follow consecutively
+ * @throws IllegalArgumentException unless the endpoints of every edge are
+ *         between {@code 0} and {@code V-1}; the digraph is then unchanged
+ */
+int EdgeWeightedDigraph::AddEdges(std::span<const DirectedEdge> edges, int threads) {
+  long long n = edges.size();
+  int first = E();
+  if (n > INT_MAX - first)
+    throw std::invalid_argument("too many edges in an EdgeWeightedDigraph");
+  unsigned V = v_;
+  long long bad = ParallelFindFirst(n, threads, [&](long long i) {
+    return (static_cast<unsigned>(edges[i].from()) >= V) |
+           (static_cast<unsigned>(edges[i].to()) >= V);
+  });
+  if (bad < n) {
+    ValidateVertex(edges[bad].from());
+    ValidateVertex(edges[bad].to());
+  }
+
+  from_.reserve(first + n);
+  to_.reserve(first + n);
+  weight_.reserve(first + n);
+  from_.resize(first + n);
+  to_.resize(first + n);
+  weight_.resize(first + n);
+
+  // one indegree histogram per chunk; fewer chunks than threads when the
+  // histograms would outweigh the edges
+  int chunks = std::clamp<long long>(n / std::max(v_, 1), 1, std::max(threads, 1));
+  vector<vector<int>> in(chunks, vector<int>(v_));
+  ParallelInvoke(chunks, [&](int c) {
+    for (long long i = n * c / chunks; i < n * (c + 1) / chunks; i++) {
+      const DirectedEdge& e = edges[i];
+      from_[first + i] = e.from();
+      to_[first + i] = e.to();
+      weight_[first + i] = e.weight();
+      ++in[c][e.to()];
+    }
+  });
+  ParallelFor(v_, threads, [&](long long begin, long long end) {
+    for (int c = 0; c < chunks; c++)
+      for (long long v = begin; v < end; v++)
+        indegree_[v] += in[c][v];
+  });
+  if (n > 0) adj_stale_.store(true, std::memory_order_relaxed);
+
+  return first;
+}
+
+/**
+ * Returns the ids of the directed edges incident from vertex {@code v}.
+ * The range is invalidated by the next call to {@code AddEdge}.
  *
  * @param  v the vertex
- * @return the directed edges incident from vertex {@code v} as an Iterable
+ * @return the ids of the directed edges incident from vertex {@code v},
+ *         in insertion order
  * @throws IllegalArgumentException unless {@code 0 <= v < V}
  */
-const vector<DirectedEdge *>& EdgeWeightedDigraph::Adj(int v) const {
-    ValidateVertex(v);
-    return adj_[v];
+std::span<const int> EdgeWeightedDigraph::Adj(int v) const {
+  ValidateVertex(v);
+  BuildAdjacency();
+  return { adj_.data() + offsets_[v], adj_.data() + offsets_[v + 1] };
+}
+
+/**
+ * Returns the edge with id {@code e}.
+ *
+ * @param  e the edge id
+ * @return the edge with id {@code e}
+ * @throws IllegalArgumentException unless {@code 0 <= e < E}
+ */
+DirectedEdge EdgeWeightedDigraph::edge(int e) const {
+  if (e < 0 || e >= E())
+    throw std::invalid_argument("edge " + std::to_string(e) + 
+                                " is not between 0 and " + std::to_string(E()-1));
+  return DirectedEdge(from_[e], to_[e], weight_[e]);
 }
 
 /**
@@ -186,8 +327,7 @@ const vector<DirectedEdge *>& EdgeWeightedDigraph::Adj(int v) const {
  * @throws IllegalArgumentException unless {@code 0 <= v < V}
  */
 int EdgeWeightedDigraph::outdegree(int v) const {
-  ValidateVertex(v);
-  return adj_[v].size();
+  return Adj(v).size();
 }
 
 /**
@@ -207,14 +347,17 @@ int EdgeWeightedDigraph::indegree(int v) const {
  * Returns all directed edges in this edge-weighted digraph.
  * To iterate over the edges in this edge-weighted digraph, use foreach notation:
  * {@code for (DirectedEdge e : G.edges())}.
+ * To visit every edge without copying, loop over the ids 0 through
+ * <em>E</em> - 1 instead.
  *
  * @return all edges in this edge-weighted digraph, as an iterable
  */
-vector<DirectedEdge *> EdgeWeightedDigraph::edges() const {
-  vector<DirectedEdge *> list;
+vector<DirectedEdge> EdgeWeightedDigraph::edges() const {
+  vector<DirectedEdge> list;
+  list.reserve(E());
   for (int v = 0; v < v_; v++)
-    for (DirectedEdge* e : Adj(v))
-      list.push_back(e);
+    for (int e : Adj(v))
+      list.emplace_back(from_[e], to_[e], weight_[e]);
 
   return list;
 } 
@@ -226,10 +369,10 @@ vector<DirectedEdge *> EdgeWeightedDigraph::edges() const {
  *         followed by the <em>V</em> adjacency lists of edges
  */
 string EdgeWeightedDigraph::ToString() const {
-  string s = std::to_string(v_) + " " + std::to_string(e_) + "\n";
+  string s = std::to_string(v_) + " " + std::to_string(E()) + "\n";
   for (int v = 0; v < v_; v++) {
     s += std::to_string(v) + ": ";
-    for (DirectedEdge* e : adj_[v]) s += e->ToString() + "  ";
+    for (int e : Adj(v)) s += edge(e).ToString() + "  ";
     s += "\n";
   }
 
@@ -243,6 +386,8 @@ string EdgeWeightedDigraph::ToString() const {
  * @param args the command-line arguments
  */
 #ifdef Debug
+#include <cstdio>
+using namespace algs4;
 int main(int args, char *argv[]) {
   fstream in(argv[1]);
   EdgeWeightedDigraph G(in);
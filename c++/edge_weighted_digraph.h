@@ -1,14 +1,18 @@
 #ifndef EDGE_WEIGHTED_DIGRAPH_H_
 #define EDGE_WEIGHTED_DIGRAPH_H_
 
+#include <cstdint>
 #include <vector>
-#include <random>
+#include <span>
 #include <fstream>
 #include <string>
+#include <atomic>
+#include <mutex>
 
-namespace algs4 {
+#include "directed_edge.h"
+#include "parallel.h"
 
-class DirectedEdge;
+namespace algs4 {
 
 class EdgeWeightedDigraph {
 public:
@@ -20,14 +24,16 @@ public:
    */
   EdgeWeightedDigraph(int V) noexcept;
   /**
-   * Initializes a random edge-weighted digraph with {@code V} vertices and <em>E</em> edges.
+   * Initializes a random edge-weighted digraph with {@code V} vertices and <em>E</em> edges,
+   * the Erdős–Rényi {@link GraphModel} with the given {@code seed}.
    *
    * @param  V the number of vertices
    * @param  E the number of edges
+   * @param  seed the seed; the same seed always gives the same digraph
    * @throws IllegalArgumentException if {@code V < 0}
    * @throws IllegalArgumentException if {@code E < 0}
    */
-  EdgeWeightedDigraph(int V, int E) noexcept;
+  EdgeWeightedDigraph(int V, int E, uint64_t seed = 0);
   /**
    * Initializes a new edge-weighted digraph that is a deep copy of {@code G}.
    *
@@ -46,6 +52,20 @@ public:
    * @throws IllegalArgumentException if the number of vertices or edges is negative
    */
   EdgeWeightedDigraph(std::fstream& in);
+  /**
+   * Initializes an edge-weighted digraph from its edge arrays: the edge with
+   * id <em>e</em> is {@code from[e]}→{@code to[e]} with weight {@code weight[e]}.
+   *
+   * @param  V the number of vertices
+   * @param  from the tail vertex of each edge
+   * @param  to the head vertex of each edge
+   * @param  weight the weight of each edge
+   * @throws IllegalArgumentException if {@code V < 0}
+   * @throws IllegalArgumentException if the three arrays differ in length
+   * @throws IllegalArgumentException if the endpoints of any edge are not in prescribed range
+   */
+  EdgeWeightedDigraph(int V, std::vector<int> from, std::vector<int> to,
+                      std::vector<double> weight);
   EdgeWeightedDigraph() = delete;
   EdgeWeightedDigraph &operator=(const EdgeWeightedDigraph& other) = delete;
   EdgeWeightedDigraph(EdgeWeightedDigraph&& other) = delete;
@@ -62,23 +82,84 @@ public:
    *
    * @return the number of edges in this edge-weighted digraph
    */
-  int E() const { return e_; }
+  int E() const { return static_cast<int>(from_.size()); }
   /**
    * Adds the directed edge {@code e} to this edge-weighted digraph.
    *
    * @param  e the edge
+   * @return the id of the new edge; ids are assigned 0, 1, 2, ... in insertion order
    * @throws IllegalArgumentException unless endpoints of edge are between {@code 0}
    *         and {@code V-1}
    */
-  void AddEdge(DirectedEdge* e);
+  int AddEdge(const DirectedEdge& e) { return AddEdge(e.from(), e.to(), e.weight()); }
+  /**
+   * Adds the directed edge v→w with the given {@code weight} to this
+   * edge-weighted digraph.
+   *
+   * @param  v the tail vertex
+   * @param  w the head vertex
+   * @param  weight the weight of the edge
+   * @return the id of the new edge; ids are assigned 0, 1, 2, ... in insertion order
+   * @throws IllegalArgumentException unless both {@code 0 <= v < V} and {@code 0 <= w < V}
+   */
+  int AddEdge(int v, int w, double weight);
+  /**
+   * Adds the directed edges {@code edges} to this edge-weighted digraph, in
+   * the same order and with the same ids as that many calls to
+   * {@code AddEdge} would. The endpoints are validated in one sweep before
+   * anything is added, the edge arrays grow once to their exact final size
+   * and are filled in parallel, and the indegrees are counted with a
+   * parallel histogram.
+   *
+   * @param  edges the edges
+   * @param  threads the number of threads to use
+   * @return the id of the first new edge; the others follow consecutively
+   * @throws IllegalArgumentException unless the endpoints of every edge are
+   *         between {@code 0} and {@code V-1}; the digraph is then unchanged
+   */
+  int AddEdges(std::span<const DirectedEdge> edges, int threads = DefaultThreads());
   /**
-   * Returns the directed edges incident from vertex {@code v}.
+   * Returns the ids of the directed edges incident from vertex {@code v}.
+   * The range is invalidated by the next call to {@code AddEdge}.
    *
    * @param  v the vertex
-   * @return the directed edges incident from vertex {@code v} as an Iterable
+   * @return the ids of the directed edges incident from vertex {@code v},
+   *         in insertion order
    * @throws IllegalArgumentException unless {@code 0 <= v < V}
    */
-  const std::vector<DirectedEdge *>& Adj(int v) const;
+  std::span<const int> Adj(int v) const;
+  /**
+   * Returns the tail vertex of the edge with id {@code e}.
+   * The id is not validated.
+   *
+   * @param  e the edge id, between 0 and <em>E</em> - 1
+   * @return the tail vertex of edge {@code e}
+   */
+  int from(int e) const { return from_[e]; }
+  /**
+   * Returns the head vertex of the edge with id {@code e}.
+   * The id is not validated.
+   *
+   * @param  e the edge id, between 0 and <em>E</em> - 1
+   * @return the head vertex of edge {@code e}
+   */
+  int to(int e) const { return to_[e]; }
+  /**
+   * Returns the weight of the edge with id {@code e}.
+   * The id is not validated.
+   *
+   * @param  e the edge id, between 0 and <em>E</em> - 1
+   * @return the weight of edge {@code e}
+   */
+  double weight(int e) const { return weight_[e]; }
+  /**
+   * Returns the edge with id {@code e}.
+   *
+   * @param  e the edge id
+   * @return the edge with id {@code e}
+   * @throws IllegalArgumentException unless {@code 0 <= e < E}
+   */
+  DirectedEdge edge(int e) const;
   /**
    * Returns the number of directed edges incident from vertex {@code v}.
    * This is known as the <em>outdegree</em> of vertex {@code v}.
@@ -101,10 +182,12 @@ public:
    * Returns all directed edges in this edge-weighted digraph.
    * To iterate over the edges in this edge-weighted digraph, use foreach notation:
    * {@code for (DirectedEdge e : G.edges())}.
+   * To visit every edge without copying, loop over the ids 0 through
+   * <em>E</em> - 1 instead.
    *
    * @return all edges in this edge-weighted digraph, as an iterable
    */
-  std::vector<DirectedEdge*> edges() const;
+  std::vector<DirectedEdge> edges() const;
   /**
    * Returns a string representation of this edge-weighted digraph.
    *
@@ -116,14 +199,21 @@ public:
 private:
   // throw an IllegalArgumentException unless {@code 0 <= v < V}
   void ValidateVertex(int v) const;
+  // rebuild offsets_ and adj_ if edges were added since the last build
+  void BuildAdjacency() const;
 
 private:
   int v_;                // number of vertices in this digraph
-  int e_;                      // number of edges in this digraph
-  std::vector<std::vector<DirectedEdge *>> adj_;    // adj[v] = adjacency list for vertex v
+  std::vector<int> from_;                 // from_[e] = tail vertex of edge e
+  std::vector<int> to_;                   // to_[e] = head vertex of edge e
+  std::vector<double> weight_;            // weight_[e] = weight of edge e
   std::vector<int> indegree_;             // indegree[v] = indegree of vertex v
-  std::random_device rd_;
-  std::mt19937 gen_;
+  // adjacency index: adj_[offsets_[v]..offsets_[v+1]) = ids of edges incident from v,
+  // rebuilt on demand after AddEdge by a stable counting sort on from_
+  mutable std::vector<int> offsets_;
+  mutable std::vector<int> adj_;
+  mutable std::atomic<bool> adj_stale_{false};
+  mutable std::mutex adj_mutex_;
 };
 }
 
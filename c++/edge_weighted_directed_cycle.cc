@@ -40,82 +40,35 @@
 #include "edge_weighted_directed_cycle.h"
 
 #include <cstdio>
-#include <cassert>
 
 #include "directed_edge.h"
+#include "edge_weighted_digraph.h"
 
 using std::vector;
 using std::stack;
 
 namespace algs4 {
-/**
- * Determines whether the edge-weighted digraph {@code G} has a directed cycle and,
- * if so, finds such a cycle.
- * @param G the edge-weighted digraph
- */
-EdgeWeightedDirectedCycle::EdgeWeightedDirectedCycle(const EdgeWeightedDigraph& G) noexcept {
-  marked_.resize(G.V());
-  on_stack_.resize(G.V());
-  edge_to_.resize(G.V());
-  for (int v = 0; v < G.V(); v++)
-    if (!marked_[v]) Dfs(G, v);
-
-  // check that digraph has a cycle
-  //  assert(Check());
-}
-
-// check that algorithm computes either the topological order or finds a directed cycle
-void EdgeWeightedDirectedCycle::Dfs(const EdgeWeightedDigraph& G, int v) {
-  on_stack_[v] = true;
-  marked_[v] = true;
-  for (DirectedEdge* e : G.Adj(v)) {
-    int w = e->to();
-
-    if (!cycle_.empty()) {
-      // short circuit if directed cycle found
-      return;
-    } else if (!marked_[w]) {
-      // found new vertex, so recur
-      edge_to_[w] = e;
-      Dfs(G, w);
-    } else if (on_stack_[w]) {
-      // trace back directed cycle
-      DirectedEdge* f = e;
-      while (f->from() != w) {
-        cycle_.push(f);
-        f = edge_to_[f->from()];
-      }
-      cycle_.push(f);
-
-      return;
-    }
-  }
-
-  on_stack_[v] = false;
-}
-
 // certify that digraph is either acyclic or has a directed cycle
 bool EdgeWeightedDirectedCycle::Check() const {
   // edge-weighted digraph is cyclic
   if (HasCycle()) {
     // verify cycle
-    DirectedEdge* first = nullptr, *last = nullptr;
-    stack<DirectedEdge *> the_cycle(cycle());
+    stack<DirectedEdge> the_cycle(cycle());
+    DirectedEdge first = the_cycle.top(), last = the_cycle.top();
+    the_cycle.pop();
     while (!the_cycle.empty()) {
-      if (!first) first = the_cycle.top();
-      if (last) {
-        if (last->to() != the_cycle.top()->from()) {
-          printf("cycle edges %s and %s not incident\n", 
-                 last->ToString().c_str(), the_cycle.top()->ToString().c_str());
-          return false;
-        }
+      if (last.to() != the_cycle.top().from()) {
+        printf("cycle edges %s and %s not incident\n", 
+               last.ToString().c_str(), the_cycle.top().ToString().c_str());
+        return false;
       }
       last = the_cycle.top();
+      the_cycle.pop();
     }
 
-    if (last->to() != first->from()) {
-      printf("cycle edges %s and %s not incident\n", last->ToString().c_str(),
-             first->ToString().c_str());
+    if (last.to() != first.from()) {
+      printf("cycle edges %s and %s not incident\n", last.ToString().c_str(),
+             first.ToString().c_str());
       return false;
     }
   }
@@ -156,7 +109,7 @@ int main(int argc, char *argv[]) {
       w = dis(gen);
     } while (v >= w);
     double weight = dis_real(gen);
-    G.addEdge(new DirectedEdge(v, w, weight));
+    G.AddEdge(v, w, weight);
   }
 
   // add F extra edges
@@ -164,7 +117,7 @@ int main(int argc, char *argv[]) {
     int v = dis(gen);
     int w = dis(gen);
     double weight = dis_real(gen);
-    G.addEdge(new DirectedEdge(v, w, weight));
+    G.AddEdge(v, w, weight);
   }
 
   printf("%s\n", G.ToString().c_str());
@@ -173,9 +126,10 @@ int main(int argc, char *argv[]) {
   EdgeWeightedDirectedCycle finder(G);
   if (finder.HasCycle()) {
     printf("Cycle: ");
-    stack<DirectedEdge *> the_cycle(finder.cycle());
+    stack<DirectedEdge> the_cycle(finder.cycle());
     while (!the_cycle.empty()) {
-      printf("%s ", the_cycle.top()->ToString().c_str());
+      printf("%s ", the_cycle.top().ToString().c_str());
+      the_cycle.pop();
     }
     printf("\n");
   }
@@ -30,7 +30,9 @@
 #include <vector>
 #include <stack>
 
-#include "edge_weighted_digraph.h"
+#include "depth_first_traversal.h"
+#include "directed_edge.h"
+#include "graph_concepts.h"
 
 namespace algs4 {
 class EdgeWeightedDirectedCycle {
@@ -40,7 +42,16 @@ public:
    * if so, finds such a cycle.
    * @param G the edge-weighted digraph
    */
-  EdgeWeightedDirectedCycle(const EdgeWeightedDigraph& G) noexcept;
+  template <WeightedDigraph Graph>
+  EdgeWeightedDirectedCycle(const Graph& G) :
+    marked_(G.V()), edge_to_(G.V(), -1), on_stack_(G.V()) {
+    DepthFirstTraversal<Graph> dfs(G);
+    for (int v = 0; v < G.V(); v++)
+      if (!marked_[v] && cycle_.empty()) Dfs(G, dfs, v);
+
+    // check that digraph has a cycle
+    //  assert(Check());
+  }
   EdgeWeightedDirectedCycle() = delete;
   EdgeWeightedDirectedCycle(const EdgeWeightedDirectedCycle& other) = default;
   EdgeWeightedDirectedCycle &operator=(const EdgeWeightedDirectedCycle& other) = default;
@@ -58,19 +69,45 @@ public:
    * @return a directed cycle (as an iterable) if the edge-weighted digraph
    *    has a directed cycle, and {@code null} otherwise
    */
-  std::stack<DirectedEdge *> cycle() const { return cycle_; }
+  std::stack<DirectedEdge> cycle() const { return cycle_; }
 
 
 private:
   // check that algorithm computes either the topological order or finds a directed cycle
-  void Dfs(const EdgeWeightedDigraph& G, int v);
+  template <WeightedDigraph Graph>
+  void Dfs(const Graph& G, DepthFirstTraversal<Graph>& dfs, int s) {
+    struct Visitor {
+      EdgeWeightedDirectedCycle& c;
+      const Graph& G;
+      void PreVisit(int v) { c.on_stack_[v] = true; }
+      void PostVisit(int v) { c.on_stack_[v] = false; }
+
+      // found new vertex, so descend
+      void TreeEdge(int, int w, int e) { c.edge_to_[w] = e; }
+
+      // trace back directed cycle
+      void NonTreeEdge(int, int w, int e) {
+        if (!c.on_stack_[w]) return;
+        int f = e;
+        while (G.from(f) != w) {
+          c.cycle_.push(DirectedEdgeOf(G, f));
+          f = c.edge_to_[G.from(f)];
+        }
+        c.cycle_.push(DirectedEdgeOf(G, f));
+      }
+
+      // short circuit if directed cycle found
+      bool Done() const { return !c.cycle_.empty(); }
+    };
+    dfs.Run(s, marked_, Visitor{*this, G});
+  }
   // certify that digraph is either acyclic or has a directed cycle
   bool Check() const;
 private:
   std::vector<bool> marked_;             // marked[v] = has vertex v been marked?
-  std::vector<DirectedEdge *> edge_to_;        // edgeTo[v] = previous edge on path to v
+  std::vector<int> edge_to_;             // edgeTo[v] = id of previous edge on path to v
   std::vector<bool> on_stack_;            // onStack[v] = is vertex on the stack?
-  std::stack<DirectedEdge *> cycle_;    // directed cycle (or null if no such cycle)
+  std::stack<DirectedEdge> cycle_;      // directed cycle (or null if no such cycle)
 };
 }
 
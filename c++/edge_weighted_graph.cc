@@ -1,13 +1,14 @@
 /******************************************************************************
  *  Compilation:  clang++ -c -O2 edge.cc -std=c++20
- *                clang++ -DDebug -O2 edge.o edge_weighted_graph.cc -std=c++20 -o edge_weighted_graph
+ *                clang++ -DDebug -O2 edge.o edge_weighted_graph.cc -std=c++20 -pthread -o edge_weighted_graph
  *  Execution:    ./edge_weighted_graph filename.txt
- *  Dependencies: edge.cc
+ *  Dependencies: edge.cc graph_generator.h
  *  Data files:   https://algs4.cs.princeton.edu/43mst/tinyEWG.txt
  *                https://algs4.cs.princeton.edu/43mst/mediumEWG.txt
  *                https://algs4.cs.princeton.edu/43mst/largeEWG.txt
  *
- *  An edge-weighted undirected graph, implemented using adjacency lists.
+ *  An edge-weighted undirected graph, implemented using an edge array
+ *  indexed by compressed sparse rows.
  *  Parallel edges and self-loops are permitted.
  *
  *  % ./edge_weighted_graph tinyEWG.txt
@@ -25,30 +26,40 @@
 
 #include "edge_weighted_graph.h"
 
-#include <cstdlib>
 #include <fstream>
 #include <exception>
+#include <utility>
 
 #include "edge.h"
+#include "graph_generator.h"
 
 using std::string;
 using std::to_string;
 using std::stoi;
 using std::stod;
-using std::list;
+using std::vector;
 using std::fstream;
 
 namespace algs4 {
-EdgeWeightedGraph::EdgeWeightedGraph(int V, int E) noexcept : EdgeWeightedGraph(V) {
-  for (int i = 0; i < E; i++) {
-    int v = random() % V;
-    int w = random() % V;
-    double weight = 0.01 * (random() % 101);
-    Edge* e = new Edge(v, w, weight);
-    AddEdge(e);
-  }
+namespace {
+// the edges of the Erdős–Rényi model with V vertices, E edges and the given seed
+vector<Edge> RandomEdges(int V, int E, uint64_t seed) {
+  GraphModel model = GraphModel::ErdosRenyi(V, E, seed);
+  vector<Edge> edges(E, Edge(0, 0, 0.0));
+  ParallelFor(E, DefaultThreads(), [&](long long begin, long long end) {
+    for (int e = begin; e < end; e++) {
+      auto [v, w] = model.Endpoints(e);
+      edges[e] = Edge(v, w, model.Weight(e));
+    }
+  });
+
+  return edges;
+}
 }
 
+EdgeWeightedGraph::EdgeWeightedGraph(int V, int E, uint64_t seed) :
+  EdgeWeightedGraph(V, RandomEdges(V, E, seed)) {}
+
 EdgeWeightedGraph::EdgeWeightedGraph(const string& filename) {
   fstream in(filename);
 
@@ -58,12 +69,14 @@ EdgeWeightedGraph::EdgeWeightedGraph(const string& filename) {
     if (line == "") throw std::out_of_range("input file content is invalid");
 
     V_ = stoi(line);
-    adj_.resize(V_);
+    degree_.resize(V_);
+    offsets_.resize(V_ + 1);
 
     std::getline(in, line);
     if (line == "") throw std::out_of_range("input file content is invalid");
     int E = stoi(line);
     if (E < 0) throw std::invalid_argument("Number of edges must be non-negative");
+    edges_.reserve(E);
 
     for (int i = 0; i < E; i++) {
       std::getline(in, line);
@@ -75,21 +88,36 @@ EdgeWeightedGraph::EdgeWeightedGraph(const string& filename) {
       ValidateVertex(v);
       ValidateVertex(w);
       double weight = stod(line.substr(next_pos + 1));
-      Edge* e = new Edge(v, w, weight);
-      AddEdge(e);
+      AddEdge(Edge(v, w, weight));
     }
     break;
   }
 }
 
+EdgeWeightedGraph::EdgeWeightedGraph(int V, vector<Edge> edges) : 
+  V_(V), edges_(std::move(edges)) {
+  if (V_ < 0) throw std::invalid_argument("Number of vertices must be non-negative");
+
+  degree_.resize(V_);
+  offsets_.resize(V_ + 1);
+  for (const Edge& e : edges_) {
+    int v = e.Either(), w = e.other(v);
+    ValidateVertex(v);
+    ValidateVertex(w);
+    ++degree_[v];
+    ++degree_[w];
+  }
+  adj_stale_ = true;
+  BuildAdjacency();
+}
+
 EdgeWeightedGraph::EdgeWeightedGraph(const EdgeWeightedGraph& G) noexcept : 
   EdgeWeightedGraph(G.V()) {
-  E_ = G.E();
-  for (int v = 0; v < G.V(); v++) {
-    for_each (G.adj_[v].cbegin(), G.adj_[v].cend(), [&](auto& item) {
-      adj_[v].push_back(item);
-        });
-  }
+  G.BuildAdjacency();
+  edges_ = G.edges_;
+  degree_ = G.degree_;
+  offsets_ = G.offsets_;
+  adj_ = G.adj_;
 }
 
 void EdgeWeightedGraph::ValidateVertex(int v) const {
@@ -98,42 +126,53 @@ void EdgeWeightedGraph::ValidateVertex(int v) const {
                                 " is not between 0 and " + to_string(V_-1));
 }
 
-void EdgeWeightedGraph::AddEdge(Edge* e) {
-  int v = e->Either();
-  int w = e->other(v);
+int EdgeWeightedGraph::AddEdge(const Edge& e) {
+  int v = e.Either();
+  int w = e.other(v);
   ValidateVertex(v);
   ValidateVertex(w);
-  adj_[v].push_back(e);
-  adj_[w].push_back(e);
-  E_++;
+  edges_.push_back(e);
+  ++degree_[v];
+  ++degree_[w];
+  adj_stale_.store(true, std::memory_order_relaxed);
+
+  return edges_.size() - 1;
 }
 
-list<Edge *> EdgeWeightedGraph::Edges() const {
-  list<Edge *> res;
-  for (int v = 0; v < V_; v++) {
-    int selfLoops = 0;
-    for (Edge* e : adj(v)) {
-      if (e->other(v) > v) {
-        res.push_back(e);
-      }
-      // add only one copy of each self loop (self loops will be consecutive)
-      else if (e->other(v) == v) {
-        if (selfLoops % 2 == 0) res.push_back(e);
-        selfLoops++;
-      }
-    }
+void EdgeWeightedGraph::BuildAdjacency() const {
+  if (!adj_stale_.load(std::memory_order_acquire)) return;
+  std::lock_guard<std::mutex> lock(adj_mutex_);
+  if (!adj_stale_.load(std::memory_order_relaxed)) return;
+
+  // each edge v-w gets a slot in both lists (a self-loop gets two in one),
+  // scattered in edge id order so that every list keeps insertion order
+  offsets_.assign(V_ + 1, 0);
+  for (int v = 0; v < V_; v++)
+    offsets_[v + 1] = offsets_[v] + degree_[v];
+  vector<int> next(offsets_.cbegin(), offsets_.cend() - 1);
+  adj_.resize(offsets_[V_]);
+  for (int e = 0; e < E(); e++) {
+    int v = edges_[e].Either(), w = edges_[e].other(v);
+    adj_[next[v]++] = { w, e };
+    adj_[next[w]++] = { v, e };
   }
 
-  return res;
+  adj_stale_.store(false, std::memory_order_release);
+}
+
+std::span<const EdgeWeightedGraph::Incident> EdgeWeightedGraph::adj(int v) const {
+  ValidateVertex(v);
+  BuildAdjacency();
+  return { adj_.data() + offsets_[v], adj_.data() + offsets_[v + 1] };
 }
 
 string EdgeWeightedGraph::ToString() const {
-  string res = to_string(V_) + " " + to_string(E_) + NEWLINE;
+  string res = to_string(V_) + " " + to_string(E()) + NEWLINE;
 
   for (int v = 0; v < V_; v++) {
     res += to_string(v) + ": ";
-    for (Edge* e : adj_[v])
-      res += e->ToString() + "  ";
+    for (const Incident& slot : adj(v))
+      res += edges_[slot.edge].ToString() + "  ";
     res += NEWLINE;
   }
 
@@ -1,9 +1,14 @@
 #ifndef EDGE_WEIGHTED_GRAPH_H_
 #define EDGE_WEIGHTED_GRAPH_H_
 
-#include <list>
+#include <cstdint>
 #include <vector>
+#include <span>
 #include <string>
+#include <atomic>
+#include <mutex>
+
+#include "edge.h"
 
 /**
  *  The {@code EdgeWeightedGraph} class represents an edge-weighted
@@ -18,11 +23,16 @@
  *  adjacency list of <em>v</em> twice and contributes two to the degree
  *  of <em>v</em>.
  *  <p>
- *  This implementation uses an <em>adjacency-lists representation</em>, which
- *  is a vertex-indexed array of {@link Bag} objects.
+ *  This implementation stores each edge once, in an array indexed by a
+ *  stable edge id, and indexes the edges by endpoint in compressed-sparse-row
+ *  form: the adjacency list of <em>v</em> is a contiguous range of
+ *  (other endpoint, edge id) slots, so following an edge needs no pointer
+ *  chase. The index is rebuilt by a counting sort the first time it is
+ *  needed after edges were added, which takes &Theta;(<em>E</em> + <em>V</em>)
+ *  time.
  *  It uses &Theta;(<em>E</em> + <em>V</em>) space, where <em>E</em> is
  *  the number of edges and <em>V</em> is the number of vertices.
- *  All instance methods take &Theta;(1) time. (Though, iterating over
+ *  All other instance methods take &Theta;(1) time. (Though, iterating over
  *  the edges returned by {@link #adj(int)} takes time proportional
  *  to the degree of the vertex.)
  *  Constructing an empty edge-weighted graph with <em>V</em> vertices takes
@@ -39,11 +49,18 @@
  */
 namespace algs4 {
 
-class Edge;
-
 class EdgeWeightedGraph {
 public:
-  static constexpr char* NEWLINE = "\n";
+  static constexpr const char* NEWLINE = "\n";
+
+  /**
+   * An entry in the adjacency list of a vertex <em>v</em>: the endpoint of
+   * the edge other than <em>v</em>, and the id of the edge.
+   */
+  struct Incident {
+    int other;
+    int edge;
+  };
 
   /**
    * Initializes an empty edge-weighted graph with {@code V} vertices and 0 edges.
@@ -51,17 +68,19 @@ public:
    * @param  V the number of vertices
    * @throws IllegalArgumentException if {@code V < 0}
    */
-  EdgeWeightedGraph(int V) noexcept :V_(V), adj_(V) {}
+  EdgeWeightedGraph(int V) noexcept :V_(V), degree_(V), offsets_(V + 1) {}
 
   /**
-   * Initializes a random edge-weighted graph with {@code V} vertices and <em>E</em> edges.
+   * Initializes a random edge-weighted graph with {@code V} vertices and <em>E</em> edges,
+   * the Erdős–Rényi {@link GraphModel} with the given {@code seed}.
    *
    * @param  V the number of vertices
    * @param  E the number of edges
+   * @param  seed the seed; the same seed always gives the same graph
    * @throws IllegalArgumentException if {@code V < 0}
    * @throws IllegalArgumentException if {@code E < 0}
    */
-  EdgeWeightedGraph(int V, int E) noexcept;
+  EdgeWeightedGraph(int V, int E, uint64_t seed = 0);
 
   /**
    * Initializes an edge-weighted graph from an input stream.
@@ -77,6 +96,17 @@ public:
    */
   EdgeWeightedGraph(const std::string& filename);
 
+  /**
+   * Initializes an edge-weighted graph from its edge array; the edge with
+   * id <em>e</em> is {@code edges[e]}.
+   *
+   * @param  V the number of vertices
+   * @param  edges the edges
+   * @throws IllegalArgumentException if {@code V < 0}
+   * @throws IllegalArgumentException if the endpoints of any edge are not in prescribed range
+   */
+  EdgeWeightedGraph(int V, std::vector<Edge> edges);
+
   /**
    * Initializes a new edge-weighted graph that is a deep copy of {@code G}.
    *
@@ -100,7 +130,7 @@ public:
    *
    * @return the number of edges in this edge-weighted graph
    */
-  int E() const { return E_; }
+  int E() const { return static_cast<int>(edges_.size()); }
 
   // throw an IllegalArgumentException unless {@code 0 <= v < V}
   void ValidateVertex(int v) const;
@@ -109,21 +139,29 @@ public:
    * Adds the undirected edge {@code e} to this edge-weighted graph.
    *
    * @param  e the edge
+   * @return the id of the new edge; ids are assigned 0, 1, 2, ... in insertion order
    * @throws IllegalArgumentException unless both endpoints are between {@code 0} and {@code V-1}
    */
-  void AddEdge(Edge* e);
+  int AddEdge(const Edge& e);
 
   /**
-   * Returns the edges incident on vertex {@code v}.
+   * Returns the edges incident on vertex {@code v}, as (other endpoint,
+   * edge id) slots. The range is invalidated by the next call to {@code AddEdge}.
    *
    * @param  v the vertex
-   * @return the edges incident on vertex {@code v} as an Iterable
+   * @return the edges incident on vertex {@code v}, in insertion order
    * @throws IllegalArgumentException unless {@code 0 <= v < V}
    */
-  std::list<Edge *>& adj(int v) const {
-    ValidateVertex(v);
-    return const_cast<std::list<Edge *>&>(adj_[v]);
-  }
+  std::span<const Incident> adj(int v) const;
+
+  /**
+   * Returns the edge with id {@code e}.
+   * The id is not validated.
+   *
+   * @param  e the edge id, between 0 and <em>E</em> - 1
+   * @return the edge with id {@code e}
+   */
+  const Edge& edge(int e) const { return edges_[e]; }
 
   /**
    * Returns the degree of vertex {@code v}.
@@ -134,17 +172,18 @@ public:
    */
   int degree(int v) const {
     ValidateVertex(v);
-    return adj_[v].size();
+    return degree_[v];
   }
 
   /**
-   * Returns all edges in this edge-weighted graph.
+   * Returns all edges in this edge-weighted graph, indexed by edge id.
    * To iterate over the edges in this edge-weighted graph, use foreach notation:
-   * {@code for (Edge e : G.edges())}.
+   * {@code for (const Edge& e : G.Edges())}.
+   * The range is invalidated by the next call to {@code AddEdge}.
    *
-   * @return all edges in this edge-weighted graph, as an iterable
+   * @return all edges in this edge-weighted graph, as a contiguous range
    */
-  std::list<Edge *> Edges() const;
+  std::span<const Edge> Edges() const { return edges_; }
 
   /**
    * Returns a string representation of the edge-weighted graph.
@@ -155,10 +194,20 @@ public:
    */
   std::string ToString() const;
 
+private:
+  // rebuild offsets_ and adj_ if edges were added since the last build
+  void BuildAdjacency() const;
+
 private:
   int V_;
-  int E_{0};
-  std::vector<std::list<Edge *>> adj_;
+  std::vector<Edge> edges_;              // edges_[e] = edge with id e
+  std::vector<int> degree_;              // degree_[v] = degree of vertex v
+  // adjacency index: adj_[offsets_[v]..offsets_[v+1]) = edges incident on v,
+  // rebuilt on demand after AddEdge by a stable counting sort
+  mutable std::vector<int> offsets_;
+  mutable std::vector<Incident> adj_;
+  mutable std::atomic<bool> adj_stale_{false};
+  mutable std::mutex adj_mutex_;
 };
 }
 
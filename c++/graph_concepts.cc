@@ -0,0 +1,253 @@
+/******************************************************************************
+ *  Compilation:  clang++ -c -DNDEBUG -O2 digraph.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 compact_digraph.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 compressed_digraph.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 mapped_file.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 symbol_digraph.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 binary_graph.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 directed_edge.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 edge_weighted_digraph.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 edge.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 edge_weighted_graph.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 depth_first_order.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 topological_sort.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 kosaraju_sharir_scc.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 directed_dfs.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 tarjan_scc.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 transitive_closure.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 prim_mst.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 kruskal.cc -std=c++20
+ *                clang++ -DDebug -DNDEBUG -O2 graph_concepts.cc digraph.o compact_digraph.o compressed_digraph.o mapped_file.o symbol_digraph.o binary_graph.o directed_edge.o edge_weighted_digraph.o edge.o edge_weighted_graph.o depth_first_order.o topological_sort.o kosaraju_sharir_scc.o directed_dfs.o tarjan_scc.o transitive_closure.o prim_mst.o kruskal.o -std=c++20 -pthread -o graph_concepts
+ *  Execution:    ./graph_concepts rows cols
+ *  Dependencies: graph_concepts.h and the graph and algorithm headers
+ *
+ *  Checks which graph representations model which graph concepts, then
+ *  runs the graph algorithms on implicit grid graphs, whose adjacency lists
+ *  are computed on the fly and never stored, and on the same grids stored
+ *  as an EdgeWeightedDigraph and an EdgeWeightedGraph.
+ *
+ *  % ./graph_concepts 500 500
+ *  500 x 500 grid: 250000 vertices, 499000 edges
+ *                         implicit ms    stored ms
+ *  DijkstraSP                    31.3         41.6
+ *  AcyclicSP                      8.2         18.6
+ *  Topological                    4.6         10.4
+ *  KosarajuSharirSCC              7.6          5.9
+ *  PrimMST                       41.9         66.9
+ *  KruskalMST                   488.0        496.2
+ *  results agree
+ *
+ ******************************************************************************/
+
+#include "graph_concepts.h"
+
+#include "binary_graph.h"
+#include "compact_digraph.h"
+#include "compressed_digraph.h"
+#include "digraph.h"
+#include "edge_weighted_digraph.h"
+#include "edge_weighted_graph.h"
+
+namespace algs4 {
+static_assert(AdjacencyDigraph<Digraph>);
+static_assert(AdjacencyDigraph<CompactDigraph>);
+static_assert(AdjacencyDigraph<CompressedDigraph>);
+static_assert(AdjacencyDigraph<BinaryGraph>);
+static_assert(WeightedDigraph<EdgeWeightedDigraph>);
+static_assert(!AdjacencyDigraph<EdgeWeightedDigraph>);
+static_assert(DirectedGraph<EdgeWeightedDigraph>);
+static_assert(WeightedGraph<EdgeWeightedGraph>);
+static_assert(!DirectedGraph<EdgeWeightedGraph>);
+static_assert(!WeightedGraph<EdgeWeightedDigraph>);
+}
+
+/**
+ * Unit tests the graph concepts.
+ *
+ * @param args the command-line arguments
+ */
+#ifdef Debug
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <string>
+
+#include "acyclic_sp.h"
+#include "dijkstra_sp.h"
+#include "kosaraju_sharir_scc.h"
+#include "kruskal.h"
+#include "prim_mst.h"
+#include "topological_sort.h"
+
+using namespace algs4;
+using std::vector;
+
+namespace {
+// at most two vertices, without storage behind them
+class Pair {
+public:
+  void push_back(int w) { w_[n_++] = w; }
+  const int* begin() const { return w_; }
+  const int* end() const { return w_ + n_; }
+private:
+  int w_[2];
+  int n_{0};
+};
+
+// a rows x cols grid whose vertex r * cols + c has an edge to its right and
+// lower neighbors, so that it is a DAG; the edges to the right come first,
+// in vertex order, and each weight is a fixed function of the edge id
+class GridDigraph {
+public:
+  GridDigraph(int rows, int cols) : rows_(rows), cols_(cols), across_(rows * (cols - 1)) {}
+  int V() const { return rows_ * cols_; }
+  int E() const { return across_ + (rows_ - 1) * cols_; }
+  Pair Adj(int v) const {
+    Pair edges;
+    int r = v / cols_, c = v % cols_;
+    if (c + 1 < cols_) edges.push_back(r * (cols_ - 1) + c);
+    if (r + 1 < rows_) edges.push_back(across_ + v);
+    return edges;
+  }
+  int from(int e) const {
+    return e < across_ ? e / (cols_ - 1) * cols_ + e % (cols_ - 1) : e - across_;
+  }
+  int to(int e) const { return e < across_ ? from(e) + 1 : e - across_ + cols_; }
+  double weight(int e) const { return 1 + static_cast<long long>(e) * 7919 % 1000 / 1000.0; }
+
+private:
+  int rows_;
+  int cols_;
+  int across_;   // number of edges to the right
+};
+
+// the same grid as an undirected graph, with the same edge ids; adj()
+// also lists the edges to the left and upper neighbors
+class GridGraph {
+public:
+  struct Incident {
+    int other;
+    int edge;
+  };
+  class Incidents {
+  public:
+    void push_back(Incident i) { items_[n_++] = i; }
+    const Incident* begin() const { return items_; }
+    const Incident* end() const { return items_ + n_; }
+  private:
+    Incident items_[4];
+    int n_{0};
+  };
+
+  GridGraph(int rows, int cols) : grid_(rows, cols), cols_(cols), across_(rows * (cols - 1)) {}
+  int V() const { return grid_.V(); }
+  int E() const { return grid_.E(); }
+  Incidents adj(int v) const {
+    Incidents incidents;
+    for (int e : grid_.Adj(v)) incidents.push_back({grid_.to(e), e});
+    int r = v / cols_, c = v % cols_;
+    if (c > 0) incidents.push_back({v - 1, r * (cols_ - 1) + c - 1});
+    if (r > 0) incidents.push_back({v - cols_, across_ + v - cols_});
+    return incidents;
+  }
+  Edge edge(int e) const { return Edge(grid_.from(e), grid_.to(e), grid_.weight(e)); }
+
+private:
+  GridDigraph grid_;
+  int cols_;
+  int across_;   // number of edges to the right
+};
+
+static_assert(WeightedDigraph<GridDigraph>);
+static_assert(WeightedGraph<GridGraph>);
+
+// milliseconds taken by f
+double Time(const std::function<void()>& f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+}
+
+int main(int argc, char *argv[]) {
+  int rows = std::stoi(argv[1]), cols = std::stoi(argv[2]);
+  GridDigraph implicit(rows, cols);
+  GridGraph undirected(rows, cols);
+
+  // the same grids, stored, with the same edge ids
+  EdgeWeightedDigraph stored(implicit.V());
+  EdgeWeightedGraph stored_undirected(implicit.V());
+  for (int e = 0; e < implicit.E(); e++) {
+    stored.AddEdge(implicit.from(e), implicit.to(e), implicit.weight(e));
+    stored_undirected.AddEdge(undirected.edge(e));
+  }
+  printf("%d x %d grid: %d vertices, %d edges\n", rows, cols, stored.V(), stored.E());
+
+  bool agree = true;
+  auto expect = [&](bool ok, const char* what) {
+    if (!ok) printf("%s differ\n", what);
+    agree = agree && ok;
+  };
+
+  printf("                       implicit ms    stored ms\n");
+  {
+    vector<double> da, db;
+    printf("DijkstraSP            %12.1f %12.1f\n",
+           Time([&] {
+             DijkstraSP sp(implicit, 0);
+             for (int v = 0; v < implicit.V(); v++) da.push_back(sp.distTo(v));
+           }),
+           Time([&] {
+             DijkstraSP sp(stored, 0);
+             for (int v = 0; v < stored.V(); v++) db.push_back(sp.distTo(v));
+           }));
+    expect(da == db, "DijkstraSP distances");
+  }
+  {
+    vector<double> da, db;
+    printf("AcyclicSP             %12.1f %12.1f\n",
+           Time([&] {
+             AcyclicSP sp(implicit, 0);
+             for (int v = 0; v < implicit.V(); v++) da.push_back(sp.dist_to(v));
+           }),
+           Time([&] {
+             AcyclicSP sp(stored, 0);
+             for (int v = 0; v < stored.V(); v++) db.push_back(sp.dist_to(v));
+           }));
+    expect(da == db, "AcyclicSP distances");
+  }
+  {
+    bool a = false, b = false;
+    printf("Topological           %12.1f %12.1f\n",
+           Time([&] { a = Topological(implicit).HasOrder(); }),
+           Time([&] { b = Topological(stored).HasOrder(); }));
+    expect(a && b, "Topological orders");
+  }
+  {
+    int a = 0, b = 0;
+    printf("KosarajuSharirSCC     %12.1f %12.1f\n",
+           Time([&] { a = KosarajuSharirSCC(implicit).count(); }),
+           Time([&] { b = KosarajuSharirSCC(stored).count(); }));
+    expect(a == implicit.V() && b == implicit.V(), "strong components");
+  }
+  {
+    double a = 0, b = 0;
+    printf("PrimMST               %12.1f %12.1f\n",
+           Time([&] { a = PrimMST(undirected).weight(); }),
+           Time([&] { b = PrimMST(stored_undirected).weight(); }));
+    expect(std::llround(a * 1e6) == std::llround(b * 1e6), "PrimMST weights");
+  }
+  {
+    double a = 0, b = 0;
+    printf("KruskalMST            %12.1f %12.1f\n",
+           Time([&] { a = KruskalMST(undirected).weight(); }),
+           Time([&] { b = KruskalMST(stored_undirected).weight(); }));
+    expect(std::llround(a * 1e6) == std::llround(b * 1e6), "KruskalMST weights");
+  }
+  if (agree) printf("results agree\n");
+
+  return agree ? 0 : 1;
+}
+#endif
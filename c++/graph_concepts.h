@@ -0,0 +1,137 @@
+#ifndef GRAPH_CONCEPTS_H_
+#define GRAPH_CONCEPTS_H_
+
+#include <concepts>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include "directed_edge.h"
+#include "edge.h"
+
+/**
+ *  Compile-time interfaces of the graph representations, so that an
+ *  algorithm is written once, as a template, and instantiated for each
+ *  representation with its adjacency loop inlined.
+ *  <p>
+ *  {@code AdjacencyDigraph}: {@code V()} and {@code Adj(v)}, a range of the
+ *  vertices adjacent from <em>v</em>. {@link Digraph}, {@link CompactDigraph},
+ *  {@link CompressedDigraph} and {@link BinaryGraph} are adjacency
+ *  digraphs, and so is any implicit graph that computes its neighbors
+ *  on the fly.
+ *  <p>
+ *  {@code WeightedDigraph}: {@code V()}, {@code E()}, {@code Adj(v)}, a range
+ *  of the ids of the edges incident from <em>v</em>, and {@code from(e)},
+ *  {@code to(e)} and {@code weight(e)} for an edge id <em>e</em>, as in
+ *  {@link EdgeWeightedDigraph}. Edge ids need not be dense, so algorithms
+ *  reach the edges through {@code Adj(v)} rather than by counting up to
+ *  {@code E()}.
+ *  <p>
+ *  {@code DirectedGraph}: either of the above. Algorithms that only follow
+ *  edges take a {@code DirectedGraph} and visit the heads of the edges
+ *  leaving <em>v</em> with {@code Heads(G, v)}. {@code DirectedEdgeOf(G, e)}
+ *  assembles the {@link DirectedEdge} with id <em>e</em> of a weighted digraph.
+ *  <p>
+ *  {@code WeightedGraph}: an undirected edge-weighted graph as in
+ *  {@link EdgeWeightedGraph}: {@code V()}, {@code E()}, {@code adj(v)}, a
+ *  range of entries with the other endpoint {@code other} and the edge id
+ *  {@code edge} of each edge incident on <em>v</em>, and {@code edge(e)},
+ *  the {@link Edge} with id <em>e</em>. {@code EdgesOf(G)} collects them all.
+ *  <p>
+ *  The accessors are called once per vertex or edge visited, so they should
+ *  be cheap, not validate their argument and not be virtual.
+ */
+
+namespace algs4 {
+
+/**
+ * The type of the range {@code G.Adj(v)} for a graph of type {@code G}.
+ */
+template <typename G>
+using AdjRange = decltype(std::declval<const G&>().Adj(0));
+
+/**
+ * The type of the range {@code G.adj(v)} for an undirected graph of type {@code G}.
+ */
+template <typename G>
+using IncidentRange = decltype(std::declval<const G&>().adj(0));
+
+template <typename G>
+concept WeightedDigraph = requires(const G& g, int v, int e) {
+  { g.V() } -> std::convertible_to<int>;
+  { g.E() } -> std::convertible_to<int>;
+  { g.Adj(v) } -> std::ranges::input_range;
+  { g.from(e) } -> std::convertible_to<int>;
+  { g.to(e) } -> std::convertible_to<int>;
+  { g.weight(e) } -> std::convertible_to<double>;
+} && std::convertible_to<std::ranges::range_reference_t<AdjRange<G>>, int>;
+
+template <typename G>
+concept AdjacencyDigraph = requires(const G& g, int v) {
+  { g.V() } -> std::convertible_to<int>;
+  { g.Adj(v) } -> std::ranges::input_range;
+} && std::convertible_to<std::ranges::range_reference_t<AdjRange<G>>, int> &&
+    !WeightedDigraph<G>;
+
+template <typename G>
+concept DirectedGraph = AdjacencyDigraph<G> || WeightedDigraph<G>;
+
+template <typename G>
+concept WeightedGraph = requires(const G& g, int v, int e) {
+  { g.V() } -> std::convertible_to<int>;
+  { g.E() } -> std::convertible_to<int>;
+  { g.adj(v) } -> std::ranges::input_range;
+  { g.edge(e) } -> std::convertible_to<Edge>;
+} && requires(std::ranges::range_reference_t<IncidentRange<G>> incident) {
+  { incident.other } -> std::convertible_to<int>;
+  { incident.edge } -> std::convertible_to<int>;
+};
+
+/**
+ * Returns the vertices adjacent from vertex {@code v} in the digraph
+ * {@code G}: {@code G.Adj(v)} itself for an adjacency digraph, and the head
+ * of each edge in {@code G.Adj(v)} for a weighted digraph.
+ *
+ * @param  G the digraph
+ * @param  v the vertex
+ * @return the vertices adjacent from vertex {@code v}, as an iterable
+ */
+template <DirectedGraph Graph>
+decltype(auto) Heads(const Graph& G, int v) {
+  if constexpr (WeightedDigraph<Graph>)
+    return G.Adj(v) | std::views::transform([&G](int e) -> int { return G.to(e); });
+  else
+    return G.Adj(v);
+}
+
+/**
+ * Returns the edge with id {@code e} of the weighted digraph {@code G}.
+ * The id is not validated.
+ *
+ * @param  G the weighted digraph
+ * @param  e the edge id, between 0 and <em>E</em> - 1
+ * @return the edge with id {@code e}
+ */
+template <WeightedDigraph Graph>
+DirectedEdge DirectedEdgeOf(const Graph& G, int e) {
+  return DirectedEdge(G.from(e), G.to(e), G.weight(e));
+}
+
+/**
+ * Returns all edges of the weighted graph {@code G}, indexed by edge id.
+ *
+ * @param  G the weighted graph
+ * @return the <em>E</em> edges of {@code G}
+ */
+template <WeightedGraph Graph>
+std::vector<Edge> EdgesOf(const Graph& G) {
+  std::vector<Edge> edges;
+  edges.reserve(G.E());
+  for (int e = 0; e < G.E(); e++)
+    edges.push_back(G.edge(e));
+
+  return edges;
+}
+}
+
+#endif  // GRAPH_CONCEPTS_H_
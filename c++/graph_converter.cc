@@ -0,0 +1,129 @@
+/******************************************************************************
+ *  Compilation:  clang++ -c -O2 digraph.cc -std=c++20
+ *                clang++ -c -O2 compact_digraph.cc -std=c++20
+ *                clang++ -c -O2 directed_edge.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_digraph.cc -std=c++20
+ *                clang++ -c -O2 edge.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_graph.cc -std=c++20
+ *                clang++ -c -O2 symbol_digraph.cc -std=c++20
+ *                clang++ -c -O2 mapped_file.cc -std=c++20
+ *                clang++ -c -O2 graph_loader.cc -std=c++20
+ *                clang++ -c -O2 binary_graph.cc -std=c++20
+ *                clang++ -O2 graph_converter.cc binary_graph.o graph_loader.o mapped_file.o symbol_digraph.o edge_weighted_graph.o edge.o edge_weighted_digraph.o directed_edge.o compact_digraph.o digraph.o -std=c++20 -pthread -o graph_converter
+ *  Execution:    ./graph_converter digraph|ewd|ewg|symbol input.txt output.bin [delimiter]
+ *  Dependencies: binary_graph.h graph_loader.h symbol_digraph.h
+ *  Data files:   https://algs4.cs.princeton.edu/42digraph/tinyDG.txt
+ *                https://algs4.cs.princeton.edu/44sp/tinyEWD.txt
+ *                https://algs4.cs.princeton.edu/43mst/tinyEWG.txt
+ *                https://algs4.cs.princeton.edu/42digraph/routes.txt
+ *
+ *  Converts a graph in the algs4 text format into a binary graph container:
+ *  a digraph, an edge-weighted digraph, an edge-weighted graph, or a symbol
+ *  digraph with its vertex names (fields separated by the delimiter,
+ *  a space by default). Then opens the container and checks it against
+ *  the text input.
+ *
+ *  % ./graph_converter ewd tinyEWD.txt tinyEWD.bin
+ *  tinyEWD.bin: 8 vertices, 15 edges, weights
+ *
+ *  % ./graph_converter symbol routes.txt routes.bin " "
+ *  routes.bin: 10 vertices, 18 edges, names
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "binary_graph.h"
+#include "compact_digraph.h"
+#include "digraph.h"
+#include "edge.h"
+#include "edge_weighted_digraph.h"
+#include "edge_weighted_graph.h"
+#include "graph_loader.h"
+#include "symbol_digraph.h"
+
+using std::string;
+using std::vector;
+using namespace algs4;
+
+// the edges of G with their endpoints in increasing order, sorted, one per line;
+// the same for any two graphs with the same edges
+string SortedEdges(const EdgeWeightedGraph& G) {
+  vector<string> lines;
+  for (const Edge& e : G.Edges()) {
+    int v = e.Either(), w = e.other(v);
+    lines.push_back(Edge(std::min(v, w), std::max(v, w), e.weight()).ToString());
+  }
+  std::sort(lines.begin(), lines.end());
+  string s;
+  for (const string& line : lines) s += line + "\n";
+
+  return s;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc < 4) {
+    fprintf(stderr, "usage: %s digraph|ewd|ewg|symbol input.txt output.bin [delimiter]\n",
+            argv[0]);
+    return 2;
+  }
+  string kind = argv[1];
+  string input = argv[2];
+  string output = argv[3];
+
+  try {
+    string expected, actual;
+    if (kind == "digraph") {
+      CompactDigraph G = LoadDigraph(input);
+      WriteBinaryGraph(output, G);
+      expected = G.ToString();
+      actual = BinaryGraph(output).ToCompactDigraph().ToString();
+    } else if (kind == "ewd") {
+      EdgeWeightedDigraph G = LoadEdgeWeightedDigraph(input);
+      WriteBinaryGraph(output, G);
+      expected = G.ToString();
+      actual = BinaryGraph(output).ToEdgeWeightedDigraph().ToString();
+    } else if (kind == "ewg") {
+      EdgeWeightedGraph G = LoadEdgeWeightedGraph(input);
+      WriteBinaryGraph(output, G);
+      EdgeWeightedGraph H = BinaryGraph(output).ToEdgeWeightedGraph();
+      expected = SortedEdges(G);
+      actual = SortedEdges(H);
+    } else if (kind == "symbol") {
+      SymbolDigraph sg(input, argc > 4 ? argv[4] : " ");
+      WriteBinaryGraph(output, sg);
+      BinaryGraph G(output);
+      for (int v = 0; v < G.V(); v++) {
+        expected += string(sg.NameOf(v)) + ":";
+        actual += string(G.Name(v)) + ":";
+        for (int w : sg.digraph()->Adj(v)) expected += " " + string(sg.NameOf(w));
+        for (int w : G.Adj(v)) actual += " " + string(G.Name(w));
+        if (G.Index(sg.NameOf(v)) != v) actual += " (not found by name)";
+        expected += "\n";
+        actual += "\n";
+      }
+    } else {
+      fprintf(stderr, "unknown graph kind %s\n", kind.c_str());
+      return 2;
+    }
+
+    BinaryGraph G(output);
+    G.Validate();
+    if (expected != actual) {
+      fprintf(stderr, "%s does not read back as %s\n", output.c_str(), input.c_str());
+      return 1;
+    }
+    printf("%s: %d vertices, %d edges%s%s%s\n", output.c_str(), G.V(), G.E(),
+           G.IsWeighted() ? ", weights" : "", G.HasNames() ? ", names" : "",
+           G.IsUndirected() ? ", undirected" : "");
+  } catch (const std::exception& e) {
+    fprintf(stderr, "%s: %s\n", input.c_str(), e.what());
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,310 @@
+#ifndef GRAPH_GENERATOR_H_
+#define GRAPH_GENERATOR_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "compact_digraph.h"
+#include "edge_weighted_digraph.h"
+#include "edge_weighted_graph.h"
+#include "parallel.h"
+
+/**
+ *  Deterministic generators of large random graphs, for benchmarks that
+ *  should not depend on multi-gigabyte data files.
+ *  <p>
+ *  A {@code GraphModel} describes a random graph by its number of vertices
+ *  <em>V</em>, its number of edges <em>E</em> and a 64-bit seed. Edge
+ *  <em>e</em> is drawn from its own stream of random numbers, a hash of the
+ *  seed and <em>e</em> (SplitMix64), so {@code Endpoints(e)} and
+ *  {@code Weight(e)} are pure functions of the model and <em>e</em>: any
+ *  range of edges can be generated independently of the others, in any
+ *  order and by any number of threads, and the same model always gives the
+ *  same graph. Four models are supported:
+ *  <ul>
+ *  <li> {@code ErdosRenyi(V, E, seed)}: both endpoints of each edge are
+ *       uniform over the <em>V</em> vertices.
+ *  <li> {@code RMat(scale, E, seed, a, b, c)}: the recursive matrix model of
+ *       Chakrabarti, Zhan and Faloutsos, on 2<sup>scale</sup> vertices.
+ *       Each edge descends {@code scale} levels of the adjacency matrix,
+ *       choosing the upper left, upper right, lower left or lower right
+ *       quadrant with probability <em>a</em>, <em>b</em>, <em>c</em> and
+ *       1 - <em>a</em> - <em>b</em> - <em>c</em>. The defaults are those of
+ *       the Graph500 benchmark; the hubs get the smallest ids.
+ *  <li> {@code Grid(rows, cols, seed)}: the rows x cols grid in which
+ *       vertex <em>r</em> * cols + <em>c</em> has an edge to its right and
+ *       to its lower neighbor, so that the digraph is acyclic. The edges to
+ *       the right come first, in vertex order; only the weights are random.
+ *  <li> {@code PowerLaw(V, E, exponent, seed)}: the Chung-Lu model, in
+ *       which both endpoints of each edge are drawn with probability
+ *       proportional to (<em>i</em> + 1)<sup>-1 / (exponent - 1)</sup> for
+ *       vertex <em>i</em>, so that the expected degrees follow a power law
+ *       with the given exponent. The hubs get the smallest ids.
+ *  </ul>
+ *  Self-loops and parallel edges are permitted. The weight of each edge is
+ *  a multiple of 0.01 between 0.00 and 0.99.
+ *  <p>
+ *  {@code GenerateDigraph}, {@code GenerateEdgeWeightedDigraph} and
+ *  {@code GenerateEdgeWeightedGraph} build the graph in parallel, with the
+ *  edge of id <em>e</em> in position <em>e</em>. The digraph is written
+ *  straight into compressed sparse row form, without an intermediate edge
+ *  list: a first pass counts the outdegrees of each block of edge ids and a
+ *  second pass generates the edges again and scatters them into place. The
+ *  result does not depend on the number of threads.
+ */
+
+namespace algs4 {
+
+class GraphModel {
+public:
+  enum Kind { kErdosRenyi, kRMat, kGrid, kPowerLaw };
+
+  /**
+   * Returns the Erdős–Rényi model with {@code V} vertices and {@code E} edges.
+   *
+   * @param  V the number of vertices
+   * @param  E the number of edges
+   * @param  seed the seed
+   * @return the model
+   * @throws IllegalArgumentException if {@code V < 0} or {@code E < 0}
+   * @throws IllegalArgumentException if {@code V == 0} and {@code E > 0}
+   */
+  static GraphModel ErdosRenyi(int V, int E, uint64_t seed) {
+    return GraphModel(kErdosRenyi, V, E, seed);
+  }
+  /**
+   * Returns the R-MAT model with 2<sup>{@code scale}</sup> vertices and
+   * {@code E} edges.
+   *
+   * @param  scale the base-2 logarithm of the number of vertices
+   * @param  E the number of edges
+   * @param  seed the seed
+   * @param  a the probability of the upper left quadrant
+   * @param  b the probability of the upper right quadrant
+   * @param  c the probability of the lower left quadrant
+   * @return the model
+   * @throws IllegalArgumentException unless {@code 0 <= scale <= 30}
+   * @throws IllegalArgumentException if {@code E < 0}
+   * @throws IllegalArgumentException unless the probabilities are nonnegative
+   *         and sum to at most 1
+   */
+  static GraphModel RMat(int scale, int E, uint64_t seed,
+                         double a = 0.57, double b = 0.19, double c = 0.19) {
+    if (scale < 0 || scale > 30)
+      throw std::invalid_argument("scale " + std::to_string(scale) + " is not between 0 and 30");
+    if (a < 0 || b < 0 || c < 0 || a + b + c > 1)
+      throw std::invalid_argument("quadrant probabilities must be nonnegative and sum to at most 1");
+    GraphModel model(kRMat, 1 << scale, E, seed);
+    model.scale_ = scale;
+    model.a_ = Threshold(a);
+    model.ab_ = Threshold(a + b);
+    model.abc_ = Threshold(a + b + c);
+    return model;
+  }
+  /**
+   * Returns the model of the {@code rows} x {@code cols} grid.
+   *
+   * @param  rows the number of rows
+   * @param  cols the number of columns
+   * @param  seed the seed of the weights
+   * @return the model
+   * @throws IllegalArgumentException unless {@code rows >= 1} and {@code cols >= 1}
+   * @throws IllegalArgumentException if the grid has more than 2<sup>31</sup> - 1
+   *         vertices or edges
+   */
+  static GraphModel Grid(int rows, int cols, uint64_t seed) {
+    if (rows < 1 || cols < 1)
+      throw std::invalid_argument("a grid needs at least one row and one column");
+    long long V = static_cast<long long>(rows) * cols;
+    long long E = static_cast<long long>(rows) * (cols - 1) + static_cast<long long>(rows - 1) * cols;
+    if (E > INT32_MAX || V > INT32_MAX)
+      throw std::invalid_argument("a " + std::to_string(rows) + " x " + std::to_string(cols) +
+                                  " grid is too large");
+    GraphModel model(kGrid, static_cast<int>(V), static_cast<int>(E), seed);
+    model.cols_ = cols;
+    model.across_ = rows * (cols - 1);
+    return model;
+  }
+  /**
+   * Returns the Chung-Lu model with {@code V} vertices, {@code E} edges and
+   * expected degrees that follow a power law with exponent {@code exponent}.
+   *
+   * @param  V the number of vertices
+   * @param  E the number of edges
+   * @param  exponent the exponent of the power law, typically between 2 and 3
+   * @param  seed the seed
+   * @return the model
+   * @throws IllegalArgumentException if {@code V < 0} or {@code E < 0}
+   * @throws IllegalArgumentException if {@code V == 0} and {@code E > 0}
+   * @throws IllegalArgumentException unless {@code exponent > 1}
+   */
+  static GraphModel PowerLaw(int V, int E, double exponent, uint64_t seed) {
+    if (!(exponent > 1))
+      throw std::invalid_argument("the exponent of a power law must be greater than 1");
+    GraphModel model(kPowerLaw, V, E, seed);
+    // vertex i has weight (i + 1)^-alpha; Draw() inverts the integral of the
+    // weights, which takes constant time and no memory
+    double alpha = 1 / (exponent - 1);
+    model.beta_ = 1 - alpha;
+    model.span_ = model.beta_ == 0 ? std::log(V + 1.0) : std::pow(V + 1.0, model.beta_) - 1;
+    return model;
+  }
+
+  /**
+   * Returns the kind of this model.
+   *
+   * @return the kind of this model
+   */
+  Kind kind() const { return kind_; }
+  /**
+   * Returns the number of vertices of the graphs of this model.
+   *
+   * @return the number of vertices
+   */
+  int V() const { return v_; }
+  /**
+   * Returns the number of edges of the graphs of this model.
+   *
+   * @return the number of edges
+   */
+  int E() const { return e_; }
+  /**
+   * Returns the tail and head of the edge with id {@code e}.
+   * The id is not validated.
+   *
+   * @param  e the edge id, between 0 and <em>E</em> - 1
+   * @return the tail and head vertex of edge {@code e}
+   */
+  std::pair<int, int> Endpoints(int e) const {
+    Random random(Mix(seed_ + static_cast<uint64_t>(e)));
+    switch (kind_) {
+    case kErdosRenyi:
+      return {random.Uniform(v_), random.Uniform(v_)};
+    case kRMat: {
+      // each level takes 32 random bits and picks quadrant 0, 1, 2 or 3
+      // without a branch; bit 1 of the quadrant is the row, bit 0 the column
+      int v = 0, w = 0;
+      uint64_t bits = 0;
+      for (int level = 0; level < scale_; level++) {
+        bits = (level & 1) ? bits >> 32 : random.Next();
+        uint64_t r = bits & 0xffffffff;
+        int quadrant = (r >= a_) + (r >= ab_) + (r >= abc_);
+        v = (v << 1) | (quadrant >> 1);
+        w = (w << 1) | (quadrant & 1);
+      }
+      return {v, w};
+    }
+    case kGrid:
+      if (e < across_) {
+        int v = e / (cols_ - 1) * cols_ + e % (cols_ - 1);
+        return {v, v + 1};
+      }
+      return {e - across_, e - across_ + cols_};
+    case kPowerLaw:
+      return {Draw(random.Unit()), Draw(random.Unit())};
+    }
+    return {0, 0};
+  }
+  /**
+   * Returns the weight of the edge with id {@code e}.
+   * The id is not validated.
+   *
+   * @param  e the edge id, between 0 and <em>E</em> - 1
+   * @return the weight of edge {@code e}
+   */
+  double Weight(int e) const {
+    return 0.01 * Random(Mix(weight_seed_ + static_cast<uint64_t>(e))).Uniform(100);
+  }
+
+private:
+  // a SplitMix64 stream: the state advances by a fixed odd constant and
+  // each output is a bijective hash of the state
+  class Random {
+  public:
+    explicit Random(uint64_t state) : state_(state) {}
+    uint64_t Next() { return Mix(state_ += 0x9e3779b97f4a7c15); }
+    // uniform over [0, n), by the multiply-shift method
+    int Uniform(int n) { return static_cast<int>((Next() >> 32) * static_cast<uint64_t>(n) >> 32); }
+    // uniform over [0, 1)
+    double Unit() { return static_cast<double>(Next() >> 11) * 0x1.0p-53; }
+
+  private:
+    uint64_t state_;
+  };
+
+  // the probability p as a threshold on 32 random bits
+  static uint64_t Threshold(double p) {
+    return static_cast<uint64_t>(std::min(p, 1.0) * 4294967296.0);
+  }
+  // the SplitMix64 finalizer
+  static uint64_t Mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+  }
+
+  GraphModel(Kind kind, int V, int E, uint64_t seed) :
+    kind_(kind), v_(V), e_(E), seed_(Mix(seed)), weight_seed_(Mix(~seed)) {
+    if (V < 0) throw std::invalid_argument("number of vertices must be nonnegative");
+    if (E < 0) throw std::invalid_argument("number of edges must be nonnegative");
+    if (V == 0 && E > 0) throw std::invalid_argument("a graph without vertices has no edges");
+  }
+
+  // the vertex of the power law whose cumulative weight is the fraction u of the total
+  int Draw(double u) const {
+    double x = beta_ == 0 ? std::exp(u * span_) : std::pow(1 + u * span_, 1 / beta_);
+    return std::min(static_cast<int>(x) - 1, v_ - 1);
+  }
+
+private:
+  Kind kind_;
+  int v_;                  // number of vertices
+  int e_;                  // number of edges
+  uint64_t seed_;          // hash of the seed, for the endpoints
+  uint64_t weight_seed_;   // another hash of the seed, for the weights
+  int scale_{0};           // R-MAT: base-2 logarithm of V
+  uint64_t a_{0};          // R-MAT: a, a + b and a + b + c as thresholds on 32 bits
+  uint64_t ab_{0};
+  uint64_t abc_{0};
+  int cols_{0};            // grid: number of columns
+  int across_{0};          // grid: number of edges to the right
+  double beta_{0};         // power law: 1 - 1 / (exponent - 1)
+  double span_{0};         // power law: (V + 1)^beta - 1, or log(V + 1) if beta is 0
+};
+
+/**
+ * Generates a digraph of the model {@code model}.
+ *
+ * @param  model the model
+ * @param  threads the number of threads to generate with
+ * @return the digraph, in compressed sparse row form
+ */
+CompactDigraph GenerateDigraph(const GraphModel& model, int threads = DefaultThreads());
+
+/**
+ * Generates an edge-weighted digraph of the model {@code model}.
+ *
+ * @param  model the model
+ * @param  threads the number of threads to generate with
+ * @return the edge-weighted digraph
+ */
+EdgeWeightedDigraph GenerateEdgeWeightedDigraph(const GraphModel& model,
+                                                int threads = DefaultThreads());
+
+/**
+ * Generates an edge-weighted graph of the model {@code model}, ignoring
+ * the direction of its edges.
+ *
+ * @param  model the model
+ * @param  threads the number of threads to generate with
+ * @return the edge-weighted graph
+ */
+EdgeWeightedGraph GenerateEdgeWeightedGraph(const GraphModel& model,
+                                            int threads = DefaultThreads());
+}
+
+#endif  // GRAPH_GENERATOR_H_
@@ -0,0 +1,352 @@
+/******************************************************************************
+ *  Compilation:  clang++ -c -O2 digraph.cc -std=c++20
+ *                clang++ -c -O2 compact_digraph.cc -std=c++20
+ *                clang++ -c -O2 directed_edge.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_digraph.cc -std=c++20
+ *                clang++ -c -O2 edge.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_graph.cc -std=c++20
+ *                clang++ -c -O2 mapped_file.cc -std=c++20
+ *                clang++ -DDebug -O2 graph_loader.cc digraph.o compact_digraph.o directed_edge.o edge_weighted_digraph.o edge.o edge_weighted_graph.o mapped_file.o -std=c++20 -pthread -o graph_loader
+ *  Execution:    ./graph_loader digraph|ewd|ewg filename.txt [threads]
+ *  Dependencies: compact_digraph.cc edge_weighted_digraph.cc edge_weighted_graph.cc
+ *                mapped_file.cc parallel.h digraph.cc
+ *  Data files:   https://algs4.cs.princeton.edu/42digraph/largeDG.txt
+ *                https://algs4.cs.princeton.edu/44sp/largeEWD.txt
+ *                https://algs4.cs.princeton.edu/43mst/largeEWG.txt
+ *
+ *  Loads a graph in the algs4 text format with the parallel loader and with
+ *  the stream constructor, checks that both give the same graph, and
+ *  reports the time each took.
+ *
+ *  % ./graph_loader digraph largeDG.txt 1
+ *  1000000 vertices, 7500000 edges
+ *  stream constructor:   3.303 s
+ *  parallel loader:      1.057 s (1 threads)
+ *  graphs are identical
+ *
+ ******************************************************************************/
+
+#include "graph_loader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <exception>
+#include <utility>
+#include <vector>
+
+#include "edge.h"
+#include "mapped_file.h"
+
+using std::vector;
+using std::string;
+
+namespace algs4 {
+namespace {
+
+// chunks smaller than this are not worth a thread of their own
+constexpr long long kMinChunkBytes = 1 << 16;
+
+// the header of a graph file, and its edge lines split into line-aligned chunks
+struct EdgeText {
+  int V;                         // number of vertices
+  int E;                         // number of edges
+  const char* base;              // first byte of the file, for error positions
+  vector<const char*> bounds;    // chunk c is [bounds[c], bounds[c+1])
+
+  int chunks() const { return static_cast<int>(bounds.size()) - 1; }
+};
+
+bool IsSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+// parse one number at p, skipping leading whitespace; false if there is none
+template <typename T>
+bool ParseNumber(const char*& p, const char* end, T& value) {
+  while (p < end && IsSpace(*p)) ++p;
+  auto [last, error] = std::from_chars(p, end, value);
+  if (error != std::errc() || (last < end && !IsSpace(*last))) return false;
+  p = last;
+  return true;
+}
+
+// throw an IllegalArgumentException unless {@code 0 <= v < V}
+void ValidateVertex(int v, int V) {
+  if (v < 0 || v >= V)
+    throw std::invalid_argument("vertex " + std::to_string(v) +
+                                " is not between 0 and " + std::to_string(V-1));
+}
+
+// read the header and split the edge lines into at most {@code chunks} chunks
+EdgeText Split(const MappedFile& file, int chunks) {
+  const char* p = file.data();
+  const char* end = p + file.size();
+  EdgeText text { 0, 0, p, {} };
+  if (!ParseNumber(p, end, text.V))
+    throw std::invalid_argument("input file content is invalid");
+  if (text.V < 0)
+    throw std::invalid_argument("number of vertices must be nonnegative");
+  if (!ParseNumber(p, end, text.E))
+    throw std::invalid_argument("input file content is invalid");
+  if (text.E < 0)
+    throw std::invalid_argument("number of edges must be nonnegative");
+
+  // the edges start on the line after the number of edges
+  while (p < end && *p != '\n') ++p;
+  if (p < end) ++p;
+
+  chunks = static_cast<int>(std::clamp<long long>((end - p) / kMinChunkBytes, 1, chunks));
+  text.bounds.push_back(p);
+  for (int c = 1; c < chunks; c++) {
+    const char* q = std::max(p + (end - p) * c / chunks, text.bounds.back());
+    while (q < end && *q != '\n') ++q;
+    if (q < end) ++q;
+    text.bounds.push_back(q);
+  }
+  text.bounds.push_back(end);
+
+  return text;
+}
+
+// parse at most {@code limit} edges of chunk c, calling visit(v, w, weight)
+// on each in order; returns the number of edges parsed
+template <bool Weighted, typename Visit>
+int ParseChunk(const EdgeText& text, int c, int limit, Visit&& visit) {
+  const char* p = text.bounds[c];
+  const char* end = text.bounds[c + 1];
+  int n = 0;
+  while (n < limit) {
+    while (p < end && IsSpace(*p)) ++p;
+    if (p == end) break;
+
+    const char* edge = p;
+    int v, w;
+    double weight = 0.0;
+    if (!ParseNumber(p, end, v) || !ParseNumber(p, end, w) ||
+        (Weighted && !ParseNumber(p, end, weight)))
+      throw std::invalid_argument("malformed edge at byte " + std::to_string(edge - text.base));
+    ValidateVertex(v, text.V);
+    ValidateVertex(w, text.V);
+    visit(v, w, weight);
+    n++;
+  }
+
+  return n;
+}
+
+// the number of edges to take from each chunk: all of them, in order, until E are taken
+vector<int> Quotas(const EdgeText& text, const vector<int>& counts) {
+  vector<int> quotas(counts.size());
+  int remaining = text.E;
+  for (size_t c = 0; c < counts.size(); c++) {
+    quotas[c] = std::min(counts[c], remaining);
+    remaining -= quotas[c];
+  }
+  if (remaining > 0)
+    throw std::invalid_argument("expected " + std::to_string(text.E) + " edges but found " +
+                                std::to_string(text.E - remaining));
+
+  return quotas;
+}
+
+// parse every chunk once to count its edges, then once more to hand each
+// edge to fill(e, v, w, weight), where e is its position in the file
+template <bool Weighted, typename Fill>
+void ParseEdges(const EdgeText& text, Fill&& fill) {
+  vector<int> counts(text.chunks());
+  ParallelInvoke(text.chunks(), [&](int c) {
+    counts[c] = ParseChunk<Weighted>(text, c, text.E, [](int, int, double) {});
+  });
+  vector<int> quotas = Quotas(text, counts);
+
+  vector<int> start(text.chunks());
+  for (int c = 1; c < text.chunks(); c++)
+    start[c] = start[c - 1] + quotas[c - 1];
+  ParallelInvoke(text.chunks(), [&](int c) {
+    int e = start[c];
+    ParseChunk<Weighted>(text, c, quotas[c], [&](int v, int w, double weight) {
+      fill(e++, v, w, weight);
+    });
+  });
+}
+}
+
+/**
+ * Loads a digraph from the text file {@code filename}.
+ *
+ * @param  filename the name of the file
+ * @param  threads the number of threads to parse with
+ * @return the digraph, in compressed sparse row form
+ * @throws std::runtime_error if the file cannot be read
+ * @throws IllegalArgumentException if the number of vertices or edges is negative
+ * @throws IllegalArgumentException if the endpoints of any edge are not in prescribed range
+ * @throws IllegalArgumentException if the file is in the wrong format
+ */
+CompactDigraph LoadDigraph(const string& filename, int threads) {
+  MappedFile file(filename);
+  // each chunk keeps an outdegree histogram of V counters; limit the chunks
+  // so that all histograms together are no larger than the edge array
+  EdgeText probe = Split(file, 1);
+  long long average_degree = probe.E / std::max(probe.V, 1);
+  EdgeText text = Split(file, static_cast<int>(std::clamp<long long>(average_degree, 1, threads)));
+  int V = text.V;
+
+  // count pass: the edges of each chunk and their outdegree histogram
+  vector<int> counts(text.chunks());
+  vector<vector<int>> outdegree(text.chunks());
+  ParallelInvoke(text.chunks(), [&](int c) {
+    outdegree[c].assign(V, 0);
+    counts[c] = ParseChunk<false>(text, c, text.E, [&](int v, int, double) {
+      ++outdegree[c][v];
+    });
+  });
+
+  // drop the edges past the first E from the histograms
+  vector<int> quotas = Quotas(text, counts);
+  for (int c = 0; c < text.chunks(); c++) {
+    if (quotas[c] == counts[c]) continue;
+    outdegree[c].assign(V, 0);
+    ParseChunk<false>(text, c, quotas[c], [&](int v, int, double) { ++outdegree[c][v]; });
+  }
+
+  // row offsets, and the first slot of each chunk within each row, so that
+  // the edges of a row keep the order of the file
+  vector<int> offsets(V + 1);
+  for (int v = 0; v < V; v++) {
+    int next = offsets[v];
+    for (vector<int>& histogram : outdegree) {
+      int count = histogram[v];
+      histogram[v] = next;
+      next += count;
+    }
+    offsets[v + 1] = next;
+  }
+
+  // fill pass: scatter each edge straight into the targets array
+  vector<int> targets(text.E);
+  ParallelInvoke(text.chunks(), [&](int c) {
+    vector<int>& next = outdegree[c];
+    ParseChunk<false>(text, c, quotas[c], [&](int v, int w, double) {
+      targets[next[v]++] = w;
+    });
+  });
+
+  return CompactDigraph(V, std::move(offsets), std::move(targets));
+}
+
+/**
+ * Loads an edge-weighted digraph from the text file {@code filename}.
+ *
+ * @param  filename the name of the file
+ * @param  threads the number of threads to parse with
+ * @return the edge-weighted digraph
+ * @throws std::runtime_error if the file cannot be read
+ * @throws IllegalArgumentException if the number of vertices or edges is negative
+ * @throws IllegalArgumentException if the endpoints of any edge are not in prescribed range
+ * @throws IllegalArgumentException if the file is in the wrong format
+ */
+EdgeWeightedDigraph LoadEdgeWeightedDigraph(const string& filename, int threads) {
+  MappedFile file(filename);
+  EdgeText text = Split(file, threads);
+  vector<int> from(text.E), to(text.E);
+  vector<double> weights(text.E);
+  ParseEdges<true>(text, [&](int e, int v, int w, double weight) {
+    from[e] = v;
+    to[e] = w;
+    weights[e] = weight;
+  });
+
+  return EdgeWeightedDigraph(text.V, std::move(from), std::move(to), std::move(weights));
+}
+
+/**
+ * Loads an edge-weighted graph from the text file {@code filename}.
+ *
+ * @param  filename the name of the file
+ * @param  threads the number of threads to parse with
+ * @return the edge-weighted graph
+ * @throws std::runtime_error if the file cannot be read
+ * @throws IllegalArgumentException if the number of vertices or edges is negative
+ * @throws IllegalArgumentException if the endpoints of any edge are not in prescribed range
+ * @throws IllegalArgumentException if the file is in the wrong format
+ */
+EdgeWeightedGraph LoadEdgeWeightedGraph(const string& filename, int threads) {
+  MappedFile file(filename);
+  EdgeText text = Split(file, threads);
+  vector<Edge> edges(text.E, Edge(0, 0, 0.0));
+  ParseEdges<true>(text, [&](int e, int v, int w, double weight) {
+    edges[e] = Edge(v, w, weight);
+  });
+
+  return EdgeWeightedGraph(text.V, std::move(edges));
+}
+}
+
+/**
+ * Unit tests the graph loaders.
+ *
+ * @param args the command-line arguments
+ */
+#ifdef Debug
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include "digraph.h"
+using namespace algs4;
+using Clock = std::chrono::steady_clock;
+
+double SecondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+int main(int argc, char *argv[]) {
+  string kind = argv[1];
+  string filename = argv[2];
+  int threads = argc > 3 ? std::stoi(argv[3]) : DefaultThreads();
+
+  string expected, actual;
+  double stream_time, loader_time;
+  if (kind == "digraph") {
+    Clock::time_point start = Clock::now();
+    std::fstream in(filename);
+    Digraph G(in);
+    stream_time = SecondsSince(start);
+    expected = G.Freeze().ToString();
+
+    start = Clock::now();
+    CompactDigraph H = LoadDigraph(filename, threads);
+    loader_time = SecondsSince(start);
+    actual = H.ToString();
+    printf("%d vertices, %d edges\n", H.V(), H.E());
+  } else if (kind == "ewd") {
+    Clock::time_point start = Clock::now();
+    std::fstream in(filename);
+    EdgeWeightedDigraph G(in);
+    stream_time = SecondsSince(start);
+    expected = G.ToString();
+
+    start = Clock::now();
+    EdgeWeightedDigraph H = LoadEdgeWeightedDigraph(filename, threads);
+    loader_time = SecondsSince(start);
+    actual = H.ToString();
+    printf("%d vertices, %d edges\n", H.V(), H.E());
+  } else {
+    Clock::time_point start = Clock::now();
+    EdgeWeightedGraph G(filename);
+    stream_time = SecondsSince(start);
+    expected = G.ToString();
+
+    start = Clock::now();
+    EdgeWeightedGraph H = LoadEdgeWeightedGraph(filename, threads);
+    loader_time = SecondsSince(start);
+    actual = H.ToString();
+    printf("%d vertices, %d edges\n", H.V(), H.E());
+  }
+
+  printf("stream constructor: %7.3f s\n", stream_time);
+  printf("parallel loader:    %7.3f s (%d threads)\n", loader_time, threads);
+  printf("graphs are %s\n", expected == actual ? "identical" : "different");
+
+  return expected == actual ? 0 : 1;
+}
+#endif
@@ -0,0 +1,74 @@
+#ifndef GRAPH_LOADER_H_
+#define GRAPH_LOADER_H_
+
+#include <string>
+
+#include "compact_digraph.h"
+#include "edge_weighted_digraph.h"
+#include "edge_weighted_graph.h"
+#include "parallel.h"
+
+/**
+ *  Fast loaders for the algs4 text graph format: the number of vertices
+ *  <em>V</em>, followed by the number of edges <em>E</em>, followed by
+ *  <em>E</em> edges, one per line, each a pair of vertices optionally
+ *  followed by a weight, with entries separated by whitespace.
+ *  <p>
+ *  The file is memory-mapped and its edge lines are split into line-aligned
+ *  chunks that are parsed in parallel with {@code std::from_chars}. A first
+ *  pass counts the edges of each chunk (and, for a digraph, the outdegree
+ *  of each vertex); a second pass parses the chunks again and writes every
+ *  edge straight into its final position. The result is identical to
+ *  reading the same file with the {@code std::fstream} constructors: edges
+ *  keep the order of the file, and the same conditions are rejected with
+ *  {@code std::invalid_argument}.
+ *  <p>
+ *  Only the first <em>E</em> edges are used; anything after them must
+ *  still be well-formed.
+ */
+
+namespace algs4 {
+
+/**
+ * Loads a digraph from the text file {@code filename}.
+ *
+ * @param  filename the name of the file
+ * @param  threads the number of threads to parse with
+ * @return the digraph, in compressed sparse row form
+ * @throws std::runtime_error if the file cannot be read
+ * @throws IllegalArgumentException if the number of vertices or edges is negative
+ * @throws IllegalArgumentException if the endpoints of any edge are not in prescribed range
+ * @throws IllegalArgumentException if the file is in the wrong format
+ */
+CompactDigraph LoadDigraph(const std::string& filename, int threads = DefaultThreads());
+
+/**
+ * Loads an edge-weighted digraph from the text file {@code filename}.
+ *
+ * @param  filename the name of the file
+ * @param  threads the number of threads to parse with
+ * @return the edge-weighted digraph
+ * @throws std::runtime_error if the file cannot be read
+ * @throws IllegalArgumentException if the number of vertices or edges is negative
+ * @throws IllegalArgumentException if the endpoints of any edge are not in prescribed range
+ * @throws IllegalArgumentException if the file is in the wrong format
+ */
+EdgeWeightedDigraph LoadEdgeWeightedDigraph(const std::string& filename,
+                                            int threads = DefaultThreads());
+
+/**
+ * Loads an edge-weighted graph from the text file {@code filename}.
+ *
+ * @param  filename the name of the file
+ * @param  threads the number of threads to parse with
+ * @return the edge-weighted graph
+ * @throws std::runtime_error if the file cannot be read
+ * @throws IllegalArgumentException if the number of vertices or edges is negative
+ * @throws IllegalArgumentException if the endpoints of any edge are not in prescribed range
+ * @throws IllegalArgumentException if the file is in the wrong format
+ */
+EdgeWeightedGraph LoadEdgeWeightedGraph(const std::string& filename,
+                                        int threads = DefaultThreads());
+}
+
+#endif  // GRAPH_LOADER_H_
@@ -0,0 +1,158 @@
+/**
+ *  The {@code IncrementalTopological} class represents a directed acyclic
+ *  graph (DAG) that grows one edge at a time, together with a topological
+ *  order of its vertices that is kept up to date as the edges arrive.
+ *  The <em>addEdge</em> operation inserts an edge unless it would close a
+ *  directed cycle, in which case it rejects the edge and the <em>cycle</em>
+ *  operation returns the cycle, in the format of {@link DirectedCycle};
+ *  the <em>rank</em> and <em>order</em> operations return the order.
+ *  <p>
+ *  This implementation uses the algorithm of Pearce and Kelly
+ *  ("A Dynamic Topological Sort Algorithm for Directed Acyclic Graphs",
+ *  JEA 2006). An edge v&rarr;w with v before w leaves the order as it is.
+ *  Otherwise, only the vertices whose positions lie between those of w and
+ *  v can move: a depth-first search forward from w and one backward from v,
+ *  both confined to that window, find the vertices that must move (and a
+ *  cycle, if the forward search reaches v), and the two sets swap places
+ *  within the positions they already held, each keeping its relative order.
+ *  <p>
+ *  The <em>addEdge</em> operation takes time proportional to the number of
+ *  vertices <em>K</em> that move and the edges incident on them, plus
+ *  <em>K</em> log <em>K</em> to sort them, rather than to <em>V</em> +
+ *  <em>E</em>: most insertions into a large DAG move few vertices, or none.
+ *  The <em>rank</em> operation takes constant time; the <em>order</em>
+ *  operation takes time proportional to <em>V</em>.
+ *  It uses &Theta;(<em>V</em> + <em>E</em>) space.
+ *  <p>
+ *  The class is an adjacency digraph, so the searches of this library run on
+ *  it directly.
+ *  <p>
+ *  For additional documentation,
+ *  see <a href="https://algs4.cs.princeton.edu/42digraph">Section 4.2</a> of
+ *  <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
+ */
+
+#ifndef INCREMENTAL_TOPOLOGICAL_H_
+#define INCREMENTAL_TOPOLOGICAL_H_
+
+#include <stack>
+#include <vector>
+
+#include "search_workspace.h"
+
+namespace algs4 {
+
+class Digraph;
+
+class IncrementalTopological {
+public:
+  /**
+   * Initializes an empty DAG with {@code V} vertices, in the topological
+   * order 0, 1, ..., {@code V} - 1.
+   *
+   * @param  V the number of vertices
+   * @throws IllegalArgumentException if {@code V < 0}
+   */
+  IncrementalTopological(int V);
+  /**
+   * Initializes a DAG with the vertices and edges of the digraph {@code G},
+   * in the topological order that {@link Topological} finds.
+   *
+   * @param  G the digraph
+   * @throws IllegalArgumentException if {@code G} has a directed cycle
+   */
+  IncrementalTopological(const Digraph& G);
+  IncrementalTopological() = delete;
+  IncrementalTopological(const IncrementalTopological& other) = default;
+  IncrementalTopological &operator=(const IncrementalTopological& other) = default;
+  IncrementalTopological(IncrementalTopological&& other) = default;
+  IncrementalTopological &operator=(IncrementalTopological&& other) = default;
+
+  /**
+   * Returns the number of vertices in this DAG.
+   *
+   * @return the number of vertices in this DAG
+   */
+  int V() const { return static_cast<int>(adj_.size()); }
+  /**
+   * Returns the number of edges in this DAG.
+   *
+   * @return the number of edges in this DAG
+   */
+  int E() const { return e_; }
+  /**
+   * Returns the vertices adjacent from vertex {@code v} in this DAG.
+   * Does not validate {@code v}, as the graph searches call it per vertex.
+   *
+   * @param  v the vertex
+   * @return the vertices adjacent from vertex {@code v} in this DAG
+   */
+  const std::vector<int>& Adj(int v) const { return adj_[v]; }
+
+  /**
+   * Adds the directed edge v&rarr;w to this DAG, unless the DAG has a
+   * directed path from w to v, so that the edge would close a directed cycle.
+   *
+   * @param  v the tail vertex
+   * @param  w the head vertex
+   * @return {@code true} if the edge was added; {@code false} if it was
+   *         rejected, in which case {@code cycle()} returns the cycle it closes
+   * @throws IllegalArgumentException unless both {@code 0 <= v < V} and {@code 0 <= w < V}
+   */
+  bool AddEdge(int v, int w);
+  /**
+   * Returns the directed cycle that the last rejected edge v&rarr;w would
+   * have closed, as {@link DirectedCycle} does: v, w, the vertices of a
+   * path from w to v, and v again, from the top of the stack down.
+   * Empty if no edge has been rejected.
+   *
+   * @return the cycle closed by the last rejected edge
+   */
+  std::stack<int> cycle() const { return cycle_; }
+  /**
+   * Returns the rank of vertex {@code v} in the topological order.
+   *
+   * @param  v the vertex
+   * @return the position of vertex {@code v} in the topological order
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   */
+  int rank(int v) const;
+  /**
+   * Returns the vertices in topological order.
+   *
+   * @return the vertices in topological order
+   */
+  std::vector<int> order() const { return vertex_; }
+
+private:
+  // mark the vertices reachable from w through vertices ranked below upper,
+  // in forward_; return false if the search reaches the vertex ranked upper
+  bool SearchForward(int w, int upper);
+  // mark the vertices that reach v through vertices ranked above lower,
+  // in backward_
+  void SearchBackward(int v, int lower);
+  // give the vertices of backward_ and then those of forward_ the ranks
+  // they hold between them
+  void Reorder();
+  // throw an IllegalArgumentException unless {@code 0 <= v < V}
+  void ValidateVertex(int v) const;
+
+private:
+  std::vector<std::vector<int>> adj_;   // adj_[v] = vertices adjacent from v
+  std::vector<std::vector<int>> radj_;  // radj_[w] = vertices adjacent to w
+  int e_{0};                            // number of edges
+  std::vector<int> rank_;               // rank_[v] = position of v in the order
+  std::vector<int> vertex_;             // vertex_[i] = vertex at position i
+  std::stack<int> cycle_;               // cycle closed by the last rejected edge
+
+  // per-insertion scratch, kept between insertions
+  EpochMarks marked_;                   // marked_[v] = has a search reached v?
+  std::vector<int> edge_to_;            // edge_to_[x] = previous vertex on path from w to x
+  std::vector<int> forward_;            // vertices reached from w
+  std::vector<int> backward_;           // vertices reaching v
+  std::vector<int> stack_;              // the depth-first search stack
+  std::vector<int> ranks_;              // the ranks the moved vertices held
+};
+}
+
+#endif  // INCREMENTAL_TOPOLOGICAL_H_
@@ -3,7 +3,10 @@
 
 #include <vector>
 #include <exception>
+#include <stdexcept>
 #include <cassert>
+#include <functional>
+#include <utility>
 #include <string>
 
 namespace algs4 {
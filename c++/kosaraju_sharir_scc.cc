@@ -1,9 +1,14 @@
 /******************************************************************************
  *  Compilation:  clang++ -c -O2 digraph.cc -std=c++20
+ *                clang++ -c -O2 compact_digraph.cc -std=c++20
+ *                clang++ -c -O2 compressed_digraph.cc -std=c++20
  *                clang++ -c -O2 depth_first_order.cc -std=c++20
- *                clang++ -DDebug -O2 kosaraju_sharir_scc.cc digraph.o depth_first_order.o -std=c++20 -o kosaraju_sharir_scc
+ *                clang++ -c -O2 tarjan_scc.cc -std=c++20
+ *                clang++ -c -O2 transitive_closure.cc -std=c++20
+ *                clang++ -DDebug -O2 kosaraju_sharir_scc.cc digraph.o compact_digraph.o compressed_digraph.o depth_first_order.o tarjan_scc.o transitive_closure.o -std=c++20 -pthread -o kosaraju_sharir_scc
  *  Execution:    ./kosaraju_sharir_scc filename.txt
- *  Dependencies: digraph.cc depth_first_order.cc
+ *  Dependencies: digraph.cc compact_digraph.cc depth_first_order.cc
+ *                compressed_digraph.cc
  *  Data files:   https://algs4.cs.princeton.edu/42digraph/tinyDG.txt
  *                https://algs4.cs.princeton.edu/42digraph/mediumDG.txt
  *                https://algs4.cs.princeton.edu/42digraph/largeDG.txt
@@ -70,26 +75,14 @@
 #include <string>
 #include <queue>
 
+#include "digraph.h"
 #include "transitive_closure.h"
 
 using std::to_string;
 using std::vector;
 using std::queue;
 
-KosarajuSharirSCC::KosarajuSharirSCC(const Digraph& G) noexcept : marked_(G.V()), 
-                                                                  id_(G.V()) {
-  // compute reverse postorder of reverse graph
-  DepthFirstOrder dfs(*G.Reverse());
-
-  // run DFS on G, using reverse postorder to guide calculation
-  for (int v : dfs.reversePost()) {
-    if (!marked_[v]) {
-      Dfs(G, v);
-      count_++;
-    }
-  }
-}
-
+namespace algs4 {
 bool KosarajuSharirSCC::StronglyConnected(int v, int w) const {
   ValidateVertex(v);
   ValidateVertex(w);
@@ -101,14 +94,6 @@ int KosarajuSharirSCC::id(int v) const {
   return id_[v];
 }
 
-void KosarajuSharirSCC::Dfs(Digraph G, int v) {
-  marked_[v] = true;
-  id_[v] = count_;
-  for (int w : G.Adj(v)) {
-    if (!marked_[w]) Dfs(G, w);
-  }
-}
-
 bool KosarajuSharirSCC::Check(const Digraph& G) const {
   TransitiveClosure tc(G);
   for (int v = 0; v < G.V(); v++) {
@@ -127,6 +112,7 @@ void KosarajuSharirSCC::ValidateVertex(int v) const {
     throw std::invalid_argument("vertex " + to_string(v) + 
                                 " is not between 0 and " + to_string(V-1));
 }
+}
 
 /**
  * Unit tests the {@code KosarajuSharirSCC} data type.
@@ -136,6 +122,7 @@ void KosarajuSharirSCC::ValidateVertex(int v) const {
 #ifdef Debug
 #include <iostream>
 #include <cstdlib>
+using namespace algs4;
 int main(int argc, char *argv[]) {
   std::fstream in(argv[1]);
   if (!in.is_open()) {
@@ -144,7 +131,7 @@ int main(int argc, char *argv[]) {
   }
 
   Digraph G(in);
-  KosarajuSharirSCC scc(G);
+  KosarajuSharirSCC scc(G.Freeze());
 
   // number of connected components
   int m = scc.count();
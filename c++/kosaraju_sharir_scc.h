@@ -33,16 +33,41 @@
 
 #include <vector>
 
-#include "digraph.h"
+#include "compact_digraph.h"
 #include "depth_first_order.h"
+#include "depth_first_traversal.h"
+#include "graph_concepts.h"
+
+namespace algs4 {
+
+class Digraph;
 
 class KosarajuSharirSCC {
 public:
   /**
-   * Computes the strong components of the digraph {@code G}.
+   * Computes the strong components of the digraph {@code G}, which may be
+   * any adjacency digraph or edge-weighted digraph.
    * @param G the digraph
    */
-  KosarajuSharirSCC(const Digraph& G) noexcept;
+  template <DirectedGraph Graph>
+  KosarajuSharirSCC(const Graph& G) : marked_(G.V()), id_(G.V()) {
+    // compute reverse postorder of reverse graph: a representation that
+    // reverses itself by value keeps its own format, any other is reversed to CSR
+    std::vector<int> order;
+    if constexpr (requires { { G.Reverse() } -> DirectedGraph; })
+      order = DepthFirstOrder(G.Reverse()).ReversePost();
+    else
+      order = DepthFirstOrder(ReverseOf(G)).ReversePost();
+
+    // run DFS on G, using reverse postorder to guide calculation
+    DepthFirstTraversal<Graph> dfs(G);
+    for (int v : order) {
+      if (!marked_[v]) {
+        Dfs(dfs, v);
+        count_++;
+      }
+    }
+  }
   KosarajuSharirSCC() = delete;
   KosarajuSharirSCC(const KosarajuSharirSCC& other) = default;
   KosarajuSharirSCC &operator=(const KosarajuSharirSCC& other) = default;
@@ -75,7 +100,15 @@ public:
   int id(int v) const;
 private:
   // DFS on graph G
-  void Dfs(Digraph G, int v);
+  template <typename Traversal>
+  void Dfs(Traversal& dfs, int s) {
+    struct Visitor {
+      std::vector<int>& id;
+      int count;
+      void PreVisit(int v) { id[v] = count; }
+    };
+    dfs.Run(s, marked_, Visitor{id_, count_});
+  }
 
   // does the id_[] array contain the strongly connected components?
   bool Check(const Digraph& G) const;
@@ -88,5 +121,6 @@ private:
   std::vector<int> id_;             // id_[v] = id_ of strong component containing v
   int count_{0};            // number of strongly-connected components
 };
+}
 
 #endif  /* KOSARAJU_SHARIR_SCC_H_ */
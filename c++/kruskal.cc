@@ -37,57 +37,55 @@
 
 #include "kruskal.h"
 
+#include <algorithm>
 #include <vector>
 #include <cassert>
 #include <cmath>
 #include <iostream>
 
 #include "edge.h"
+#include "edge_weighted_graph.h"
 #include "quick_union_uf.h"
 
 using std::vector;
 using std::queue;
 using std::sort;
-using std::list;
 using std::cerr;
 using std::endl;
 
 namespace algs4 {
-KruskalMST::KruskalMST(const EdgeWeightedGraph& G) noexcept {
-  // create array of edges, sorted by weight
-  vector<Edge *> edges(G.E());
-  int t{0};
-  for (Edge* e: G.Edges())
-    edges[t++] = e;
-  sort(edges.begin(), edges.end(), [](const Edge* left, const Edge* right) {
-    return left->weight() < right->weight();
+void KruskalMST::Run(int V, vector<Edge>& edges) {
+  sort(edges.begin(), edges.end(), [](const Edge& left, const Edge& right) {
+    return left.weight() < right.weight();
   });
 
   // run greedy algorithm
-  QuickUnionUF<int> uf(G.V());
-  for (int i = 0; i < G.E() && edges_.size() < G.V() - 1; ++i) {
-    Edge* e = edges[i];
-    int v = e->Either();
-    int w = e->other(v);
+  // an MST has V - 1 edges, and a graph with no vertices has none
+  size_t mst_edges = V > 0 ? static_cast<size_t>(V) - 1 : 0;
+  QuickUnionUF<int> uf(V);
+  for (size_t i = 0; i < edges.size() && edges_.size() < mst_edges; ++i) {
+    const Edge& e = edges[i];
+    int v = e.Either();
+    int w = e.other(v);
 
     // v-w does not create a cycle
     if (uf.Find(v) != uf.Find(w)) {
       uf.UnionWith(v, w);     // merge v and w components
       edges_.push(e);     // add edge e to mst
-      weight_ += e->weight();
+      weight_ += e.weight();
     }
   }
 
   // check optimality conditions
-  assert(Check(G));
+  assert(Check(V, edges));
 }
 
-bool KruskalMST::Check(const EdgeWeightedGraph& G) const {
+bool KruskalMST::Check(int V, const vector<Edge>& all) const {
   // check total weight
   double total = 0.0;
-  queue<Edge *> all_edges{edges()};
+  queue<Edge> all_edges{edges()};
   while (!all_edges.empty()) {
-    total += all_edges.front()->weight();
+    total += all_edges.front().weight();
     all_edges.pop();
   }
   if (fabs(total - weight()) > FLOATING_POINT_EPSILON) {
@@ -97,10 +95,10 @@ bool KruskalMST::Check(const EdgeWeightedGraph& G) const {
   }
 
   // check that it is acyclic
-  QuickUnionUF<int> uf(G.V());
-  queue<Edge *> all_edges2{edges()};
+  QuickUnionUF<int> uf(V);
+  queue<Edge> all_edges2{edges()};
   while (!all_edges2.empty()) {
-    int v = all_edges2.front()->Either(), w = all_edges2.front()->other(v);
+    int v = all_edges2.front().Either(), w = all_edges2.front().other(v);
     if (uf.Find(v) == uf.Find(w)) {
       cerr << "Not a forest" << endl;
       return false;
@@ -110,8 +108,8 @@ bool KruskalMST::Check(const EdgeWeightedGraph& G) const {
   }
 
   // check that it is a spanning forest
-  for (Edge* f : G.Edges()) {
-    int v = f->Either(), w = f->other(v);
+  for (const Edge& f : all) {
+    int v = f.Either(), w = f.other(v);
     if (uf.Find(v) != uf.Find(w)) {
       cerr << "Not a spanning forest" << endl;
       return false;
@@ -119,25 +117,24 @@ bool KruskalMST::Check(const EdgeWeightedGraph& G) const {
   }
 
   // check that it is a minimal spanning forest (cut optimality conditions)
-  queue<Edge *> all_edges3{edges()};
-  while (!all_edges3.empty()) {
+  queue<Edge> all_edges3{edges()};
+  for (int i = 0; !all_edges3.empty(); i++) {
 
     // all edges in MST except e
-    uf = QuickUnionUF<int>(G.V());
-    queue<Edge *> all_edges4{edges_};
-    while (!all_edges4.empty()) {
-      int x = all_edges4.front()->Either(), y = all_edges4.front()->other(x);
-      if (all_edges4.front() != all_edges3.front()) uf.UnionWith(x, y);
+    uf = QuickUnionUF<int>(V);
+    queue<Edge> all_edges4{edges_};
+    for (int j = 0; !all_edges4.empty(); j++) {
+      int x = all_edges4.front().Either(), y = all_edges4.front().other(x);
+      if (j != i) uf.UnionWith(x, y);
       all_edges4.pop();
     }
 
     // check that e is min weight edge in crossing cut
-    for (Edge* f : G.Edges()) {
-      if (!f) continue;
-      int x = f->Either(), y = f->other(x);
+    for (const Edge& f : all) {
+      int x = f.Either(), y = f.other(x);
       if (uf.Find(x) != uf.Find(y)) {
-        if (f->weight() < all_edges3.front()->weight()) {
-          cerr << "Edge " << f->ToString() 
+        if (f.weight() < all_edges3.front().weight()) {
+          cerr << "Edge " << f.ToString() 
                << " violates cut optimality conditions" << endl;
           return false;
         }
@@ -163,9 +160,9 @@ using namespace algs4;
 int main(int args, char *argv[]) {
   EdgeWeightedGraph G(argv[1]);
   KruskalMST mst(G);
-  queue<Edge *> all_edges{mst.edges()};
+  queue<Edge> all_edges{mst.edges()};
   while (!all_edges.empty()) {
-    std::cout << all_edges.front()->ToString() << std::endl;
+    std::cout << all_edges.front().ToString() << std::endl;
     all_edges.pop();
   }
   std::cout << mst.weight() << std::endl;
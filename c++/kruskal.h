@@ -2,12 +2,12 @@
 #define KRUSKAL_H_
 
 #include <queue>
+#include <vector>
 
-#include "edge_weighted_graph.h"
+#include "edge.h"
+#include "graph_concepts.h"
 
 namespace algs4 {
-
-class Edge;
 /**
  *  The {@code KruskalMST} class represents a data type for computing a
  *  <em>minimum spanning tree</em> in an edge-weighted graph.
@@ -48,7 +48,12 @@ public:
    * Compute a minimum spanning tree (or forest) of an edge-weighted graph.
    * @param G the edge-weighted graph
    */
-  KruskalMST(const EdgeWeightedGraph& G) noexcept;
+  template <WeightedGraph Graph>
+  KruskalMST(const Graph& G) {
+    // create array of edges, sorted by weight in Run()
+    std::vector<Edge> edges = EdgesOf(G);
+    Run(G.V(), edges);
+  }
   KruskalMST() = delete;
   KruskalMST(const KruskalMST& other) = default;
   KruskalMST &operator=(const KruskalMST& other) = default;
@@ -60,7 +65,7 @@ public:
    * @return the edges in a minimum spanning tree (or forest) as
    *    an iterable of edges
    */
-  const std::queue<Edge *>& edges() const { return edges_; }
+  const std::queue<Edge>& edges() const { return edges_; }
 
   /**
    * Returns the sum of the edge weights in a minimum spanning tree (or forest).
@@ -68,12 +73,16 @@ public:
    */
   double weight() const { return weight_; }
 private:
-  // check optimality conditions (takes time proportional to E V lg* V)
-  bool Check(const EdgeWeightedGraph& G) const;
+  // sort the edges of a graph on V vertices by weight and run the greedy algorithm
+  void Run(int V, std::vector<Edge>& edges);
+
+  // check optimality conditions of a graph on V vertices with the edges
+  // all (takes time proportional to E V lg* V)
+  bool Check(int V, const std::vector<Edge>& all) const;
 
 private:
-  double weight_;                        // weight of MST
-  std::queue<Edge *> edges_;  // edges in MST
+  double weight_{0.0};                   // weight of MST
+  std::queue<Edge> edges_;    // edges in MST
 };
 }
 
@@ -1,6 +1,7 @@
 /******************************************************************************
  *  Compilation:  clang++ -c -O2 edge.cc -std=c++20
- *                clang++ -DDebug -O2 edge.o lazy_prim_mst.cc -std=c++20 -o lazy_prim_mst
+ *                clang++ -c -O2 edge_weighted_graph.cc -std=c++20
+ *                clang++ -DDebug -O2 edge.o lazy_prim_mst.cc edge_weighted_graph.o -std=c++20 -o lazy_prim_mst
  *  Execution:    ./lazy_prim_mst filename.txt
  *  Dependencies: edge.cc
  *  Data files:   https://algs4.cs.princeton.edu/43mst/tinyEWG.txt
@@ -41,10 +42,11 @@
 
 #include "lazy_prim_mst.h"
 
-#include <cassert>
+#include <cmath>
 #include <iostream>
 
-#include "quick_union_uf.h" 
+#include "edge_weighted_graph.h"
+#include "quick_union_uf.h"
 
 using std::queue;
 using std::vector;
@@ -52,42 +54,12 @@ using std::cerr;
 using std::endl;
 
 namespace algs4 {
-LazyPrimMST::LazyPrimMST(const EdgeWeightedGraph& G) noexcept : marked_(G.V()) {
-  for (int v = 0; v < G.V(); v++)     // run Prim from all vertices to
-    if (!marked_[v]) Prim(G, v);     // get a minimum spanning forest
-
-  // check optimality conditions
-  assert(Check(G));
-}
-
-    // run Prim's algorithm
-void LazyPrimMST::Prim(const EdgeWeightedGraph& G, int s) {
-  Scan(G, s);
-  while (!pq_.IsEmpty()) {                        // better to stop when mst has V-1 edges
-    Edge* e = pq_.DelMin();                      // smallest edge on pq
-    int v = e->Either(), w = e->other(v);        // two endpoints
-    assert(marked_[v] || marked_[w]);
-    if (marked_[v] && marked_[w]) continue;      // lazy, both v and w already scanned
-    edges_.push(e);                            // add e to MST
-    weight_ += e->weight();
-    if (!marked_[v]) Scan(G, v);               // v becomes part of tree
-    if (!marked_[w]) Scan(G, w);               // w becomes part of tree
-  }
-}
-
-void LazyPrimMST::Scan(const EdgeWeightedGraph& G, int v) {
-  assert(!marked_[v]);
-  marked_[v] = true;
-  for (Edge* e : G.adj(v))
-    if (!marked_[e->other(v)]) pq_.Insert(e);
-}
-
-bool LazyPrimMST::Check(const EdgeWeightedGraph& G) {
+bool LazyPrimMST::Check(int V, const vector<Edge>& all) {
   // check weight
   double totalWeight = 0.0;
-  queue<Edge *> theEdges{edges()};
+  queue<Edge> theEdges{edges()};
   while (!theEdges.empty()) {
-    totalWeight += theEdges.front()->weight();
+    totalWeight += theEdges.front().weight();
     theEdges.pop();
   }
   if (fabs(totalWeight - weight()) > FLOATING_POINT_EPSILON) {
@@ -97,10 +69,10 @@ bool LazyPrimMST::Check(const EdgeWeightedGraph& G) {
   }
 
   // check that it is acyclic
-  QuickUnionUF<int> uf(G.V());
-  queue<Edge *> theEdges2{edges()};
+  QuickUnionUF<int> uf(V);
+  queue<Edge> theEdges2{edges()};
   while (!theEdges2.empty()) {
-    int v = theEdges2.front()->Either(), w = theEdges2.front()->other(v);
+    int v = theEdges2.front().Either(), w = theEdges2.front().other(v);
     if (uf.Find(v) == uf.Find(w)) {
       cerr << "Not a forest" << endl;
       return false;
@@ -110,8 +82,8 @@ bool LazyPrimMST::Check(const EdgeWeightedGraph& G) {
   }
 
   // check that it is a spanning forest
-  for (Edge* e : G.Edges()) {
-    int v = e->Either(), w = e->other(v);
+  for (const Edge& e : all) {
+    int v = e.Either(), w = e.other(v);
     if (uf.Find(v) != uf.Find(w)) {
       cerr << "Not a spanning forest" << endl;
       return false;
@@ -119,30 +91,27 @@ bool LazyPrimMST::Check(const EdgeWeightedGraph& G) {
   }
 
   // check that it is a minimal spanning forest (cut optimality conditions)
-  queue<Edge *> theEdges3{edges()};
-  while (!theEdges3.empty()) {
-    Edge* e = theEdges3.front();
+  queue<Edge> theEdges3{edges()};
+  for (int i = 0; !theEdges3.empty(); i++) {
+    Edge e = theEdges3.front();
     theEdges3.pop();
 
     // all edges in MST except e
-    uf = QuickUnionUF<int>(G.V());
-    queue<Edge *> theEdges4{edges()};
-    while (!theEdges4.empty()) {
-      Edge* f = theEdges4.front();
+    uf = QuickUnionUF<int>(V);
+    queue<Edge> theEdges4{edges()};
+    for (int j = 0; !theEdges4.empty(); j++) {
+      const Edge& f = theEdges4.front();
+      int x = f.Either(), y = f.other(x);
+      if (j != i) uf.UnionWith(x, y);
       theEdges4.pop();
-      int x = f->Either(), y = f->other(x);
-      if (f != e) uf.UnionWith(x, y);
     }
 
     // check that e is min weight edge in crossing cut
-    queue<Edge *> theEdges5{edges()};
-    while (!theEdges5.empty()) {
-      Edge* f = theEdges5.front();
-      theEdges5.pop();
-      int x = f->Either(), y = f->other(x);
+    for (const Edge& f : all) {
+      int x = f.Either(), y = f.other(x);
       if (uf.Find(x) != uf.Find(y)) {
-        if (f->weight() < e->weight()) {
-          cerr << "Edge " << f << " violates cut optimality conditions" << endl;
+        if (f.weight() < e.weight()) {
+          cerr << "Edge " << f.ToString() << " violates cut optimality conditions" << endl;
           return false;
         }
       }
@@ -166,9 +135,9 @@ using namespace algs4;
 int main(int args, char *argv[]) {
   EdgeWeightedGraph G(argv[1]);
   LazyPrimMST mst(G);
-  queue<Edge *> current{mst.edges()};
+  queue<Edge> current{mst.edges()};
   while (!current.empty()) {
-    std::cout << current.front()->ToString() << endl;
+    std::cout << current.front().ToString() << endl;
     current.pop();
   }
 
@@ -1,21 +1,17 @@
 #ifndef LAZY_PRIM_MST_H_
 #define LAZY_PRIM_MST_H_
 
+#include <cassert>
+#include <functional>
 #include <queue>
+#include <utility>
 #include <vector>
 
 #include "edge.h"
-#include "edge_weighted_graph.h"
+#include "graph_concepts.h"
 #include "heap_priority_queue.h"
 
 namespace algs4 {
-class EdgeCompare {
-public:
-  bool operator() (Edge* left, Edge* right) const {
-    return left->weight() > right->weight();
-  }
-};
-
 /**
  *  The {@code LazyPrimMST} class represents a data type for computing a
  *  <em>minimum spanning tree</em> in an edge-weighted graph.
@@ -53,7 +49,14 @@ public:
    * Compute a minimum spanning tree (or forest) of an edge-weighted graph.
    * @param G the edge-weighted graph
    */
-  LazyPrimMST(const EdgeWeightedGraph& G) noexcept;
+  template <WeightedGraph Graph>
+  LazyPrimMST(const Graph& G) : marked_(G.V()), pq_(G.E(), std::greater<Entry>()) {
+    for (int v = 0; v < G.V(); v++)     // run Prim from all vertices to
+      if (!marked_[v]) Prim(G, v);     // get a minimum spanning forest
+
+    // check optimality conditions
+    assert(Check(G.V(), EdgesOf(G)));
+  }
   LazyPrimMST() = delete;
   LazyPrimMST(const LazyPrimMST& other) = delete;
   LazyPrimMST &operator=(const LazyPrimMST& other) = delete;
@@ -65,7 +68,7 @@ public:
    * @return the edges in a minimum spanning tree (or forest) as
    *    an iterable of edges
    */
-  std::queue<Edge *>& edges() { return edges_;}
+  const std::queue<Edge>& edges() const { return edges_; }
 
   /**
    * Returns the sum of the edge weights in a minimum spanning tree (or forest).
@@ -74,20 +77,43 @@ public:
   double weight() const { return weight_; }
 
 private:
+  // an edge on the priority queue: its weight, then its id to break ties
+  using Entry = std::pair<double, int>;
+
   // run Prim's algorithm
-  void Prim(const EdgeWeightedGraph& G, int s);
+  template <WeightedGraph Graph>
+  void Prim(const Graph& G, int s) {
+    Scan(G, s);
+    while (!pq_.IsEmpty()) {                        // better to stop when mst has V-1 edges
+      Edge e = G.edge(pq_.DelMin().second);        // smallest edge on pq
+      int v = e.Either(), w = e.other(v);          // two endpoints
+      assert(marked_[v] || marked_[w]);
+      if (marked_[v] && marked_[w]) continue;      // lazy, both v and w already scanned
+      edges_.push(e);                            // add e to MST
+      weight_ += e.weight();
+      if (!marked_[v]) Scan(G, v);               // v becomes part of tree
+      if (!marked_[w]) Scan(G, w);               // w becomes part of tree
+    }
+  }
 
   // add all edges e incident to v onto pq if the other endpoint has not yet been scanned
-  void Scan(const EdgeWeightedGraph& G, int v);
+  template <WeightedGraph Graph>
+  void Scan(const Graph& G, int v) {
+    assert(!marked_[v]);
+    marked_[v] = true;
+    for (const auto& slot : G.adj(v))
+      if (!marked_[slot.other]) pq_.Insert(Entry(G.edge(slot.edge).weight(), slot.edge));
+  }
 
-  // check optimality conditions (takes time proportional to E V lg* V)
-  bool Check(const EdgeWeightedGraph& G);
+  // check optimality conditions of a graph on V vertices with the edges
+  // all (takes time proportional to E V lg* V)
+  bool Check(int V, const std::vector<Edge>& all);
 
 private:
-  double weight_;       // total weight of MST
-  std::queue<Edge *> edges_;     // edges in the MST
+  double weight_{0.0};  // total weight of MST
+  std::queue<Edge> edges_;       // edges in the MST
   std::vector<bool> marked_;    // marked[v] = true iff v on tree
-  HeapPriorityQueue<Edge *, EdgeCompare> pq_;      // edges with one endpoint in tree
+  HeapPriorityQueue<Entry> pq_;      // edges with one endpoint in tree
 };
 }
 
@@ -0,0 +1,107 @@
+/******************************************************************************
+ *  Compilation:  clang++ -DDebug -O2 mapped_file.cc -std=c++20 -o mapped_file
+ *  Execution:    ./mapped_file filename.txt
+ *  Dependencies: 
+ *
+ *  A read-only memory mapping of a file.
+ *
+ *  % ./mapped_file tinyDG.txt
+ *  tinyDG.txt: 138 bytes, 24 lines
+ *
+ ******************************************************************************/
+
+#include "mapped_file.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using std::string;
+
+namespace algs4 {
+/**
+ * Maps the file {@code filename} into memory, read-only.
+ *
+ * @param  filename the name of the file
+ * @throws std::runtime_error if the file cannot be opened or mapped
+ */
+MappedFile::MappedFile(const string& filename) : data_(nullptr), size_(0) {
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("failed to open " + filename + ": " + std::strerror(errno));
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    int error = errno;
+    ::close(fd);
+    throw std::runtime_error("failed to stat " + filename + ": " + std::strerror(error));
+  }
+
+  size_ = st.st_size;
+  if (size_ > 0) {
+    void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      int error = errno;
+      ::close(fd);
+      throw std::runtime_error("failed to map " + filename + ": " + std::strerror(error));
+    }
+    // the file is read front to back, usually by several threads at once
+    // madvise takes one advice value per call, not a set of flags
+    ::madvise(addr, size_, MADV_SEQUENTIAL);
+    ::madvise(addr, size_, MADV_WILLNEED);
+    data_ = static_cast<const char*>(addr);
+  }
+
+  // the mapping stays valid after the descriptor is closed
+  ::close(fd);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept : 
+  data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+MappedFile &MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    Unmap();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+
+  return *this;
+}
+
+MappedFile::~MappedFile() {
+  Unmap();
+}
+
+// unmap the file, if mapped
+void MappedFile::Unmap() noexcept {
+  if (data_) ::munmap(const_cast<char*>(data_), size_);
+  data_ = nullptr;
+  size_ = 0;
+}
+}
+
+/**
+ * Unit tests the {@code MappedFile} data type.
+ *
+ * @param args the command-line arguments
+ */
+#ifdef Debug
+#include <cstdio>
+#include <algorithm>
+using namespace algs4;
+int main(int argc, char *argv[]) {
+  MappedFile file(argv[1]);
+  std::string_view text = file.view();
+  printf("%s: %zu bytes, %zu lines\n", argv[1], file.size(),
+         static_cast<size_t>(std::count(text.cbegin(), text.cend(), '\n')));
+
+  return 0;
+}
+#endif
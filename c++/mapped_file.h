@@ -0,0 +1,63 @@
+#ifndef MAPPED_FILE_H_
+#define MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ *  The {@code MappedFile} class represents a read-only memory mapping of a
+ *  whole file. The mapping is released when the object is destroyed.
+ *  An empty file is represented by an empty view.
+ *  <p>
+ *  The file must not be modified while it is mapped.
+ */
+
+namespace algs4 {
+
+class MappedFile {
+public:
+  /**
+   * Maps the file {@code filename} into memory, read-only.
+   *
+   * @param  filename the name of the file
+   * @throws std::runtime_error if the file cannot be opened or mapped
+   */
+  explicit MappedFile(const std::string& filename);
+  MappedFile() = delete;
+  MappedFile(const MappedFile& other) = delete;
+  MappedFile &operator=(const MappedFile& other) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile &operator=(MappedFile&& other) noexcept;
+  ~MappedFile();
+
+  /**
+   * Returns the first byte of the mapping.
+   *
+   * @return the first byte of the file, or {@code nullptr} if the file is empty
+   */
+  const char* data() const { return data_; }
+  /**
+   * Returns the size of the file.
+   *
+   * @return the number of bytes in the file
+   */
+  size_t size() const { return size_; }
+  /**
+   * Returns the contents of the file.
+   *
+   * @return the contents of the file, as a view into the mapping
+   */
+  std::string_view view() const { return { data_, size_ }; }
+
+private:
+  // unmap the file, if mapped
+  void Unmap() noexcept;
+
+private:
+  const char* data_;           // first byte of the mapping
+  size_t size_;                // length of the mapping in bytes
+};
+}
+
+#endif  // MAPPED_FILE_H_
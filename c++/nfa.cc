@@ -1,9 +1,9 @@
 /******************************************************************************
  *  Compilation:  clang++ -c -O2 digraph.cc -std=c++20
- *                clang++ -c -O2 directed_dfs.cc -std=c++20
- *                clang++ -DDebug -O2 nfa.cc digraph.o directed_dfs.o -std=c++20 -o nfa
+ *                clang++ -DDebug -O2 nfa.cc digraph.o -std=c++20 -o nfa
  *  Execution:    ./nfa regexp text
- *  Dependencies: digraph.h directed_dfs.h
+ *                ./nfa regexp text1 text2 ...
+ *  Dependencies: digraph.h bit_parallel_bfs.h
  *
  *  % ./nfa "(A*B|AC)D" AAAABD
  *  true
@@ -17,6 +17,11 @@
  *  % ./nfa "(a|(bc)*d)*" abcbcbcdaaaabcbcdaaaddd
  *  true
  *
+ *  % ./nfa "(A*B|AC)D" AAAABD AAAAC ACD
+ *  AAAABD 1
+ *  AAAAC 0
+ *  ACD 1
+ *
  *  Remarks
  *  -----------
  *  The following features are not supported:
@@ -29,18 +34,19 @@
 
 #include "nfa.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
-#include <list>
+#include <cstdint>
 #include <vector>
 #include <stack>
 #include <exception>
 
-#include "directed_dfs.h"
+#include "bit_parallel_bfs.h"
 
 using std::string;
 using std::vector;
 using std::stack;
-using std::list;
 
 namespace algs4 {
 NFA::NFA(const string& regexp) noexcept : graph_(regexp.size() + 1), 
@@ -79,41 +85,65 @@ NFA::NFA(const string& regexp) noexcept : graph_(regexp.size() + 1),
 }
 
 bool NFA::Recognizes(const string& txt) const {
-  DirectedDFS dfs(graph_, 0);
-  list<int> pc;
-  for (int v = 0; v < graph_.V(); v++)
-    if (dfs.Marked(v)) pc.push_back(v);
-
-  // Compute possible NFA states for txt[i+1]
-  for (int i = 0; i < txt.length(); i++) {
-    if (txt[i] == '*' || txt[i] == '|' || txt[i] == '(' || txt[i] == ')')
-      throw std::invalid_argument("text contains the metacharacter '" + string(1, txt[i]) + "'");
-
-    vector<int> match;
-    for (int v : pc) {
-      if (v == m_) continue;
-      if ((regexp_[v] == txt[i]) || regexp_[v] == '.')
-        match.push_back(v+1);
-    }
-    if (match.empty()) continue;
+  return RecognizesAll({txt})[0];
+}
 
-    dfs = DirectedDFS(graph_, match);
-    pc = list<int>();
-    for (int v = 0; v < graph_.V(); v++)
-      if (dfs.Marked(v)) pc.push_back(v);
+vector<bool> NFA::RecognizesAll(const vector<string>& texts) const {
+  constexpr int kLanes = BitParallelBFS<Digraph>::kLanes;
+  for (const string& txt : texts)
+    for (char c : txt)
+      if (c == '*' || c == '|' || c == '(' || c == ')')
+        throw std::invalid_argument("text contains the metacharacter '" + string(1, c) + "'");
+
+  vector<bool> recognized(texts.size());
+  BitParallelBFS<Digraph> bfs(graph_);
+  vector<uint64_t> seeds(m_ + 1);
+  for (size_t first = 0; first < texts.size(); first += kLanes) {
+    int lanes = std::min<size_t>(kLanes, texts.size() - first);
+    uint64_t all = lanes == kLanes ? ~uint64_t{0} : (uint64_t{1} << lanes) - 1;
+    size_t n = 0;
+    for (int i = 0; i < lanes; i++)
+      n = std::max(n, texts[first + i].length());
+
+    // lane i holds the possible NFA states for texts[first + i]
+    std::fill(seeds.begin(), seeds.end(), 0);
+    seeds[0] = all;
+    bfs.RunLanes(seeds);
+
+    // Compute possible NFA states for txt[i+1]
+    for (size_t i = 0; i < n; i++) {
+      // the lanes whose text has the character c at position i
+      std::array<uint64_t, 256> reading{};
+      uint64_t active = 0;
+      for (int lane = 0; lane < lanes; lane++) {
+        const string& txt = texts[first + lane];
+        if (i >= txt.length()) continue;
+        reading[static_cast<unsigned char>(txt[i])] |= uint64_t{1} << lane;
+        active |= uint64_t{1} << lane;
+      }
 
-    // optimization if no states reachable
-    if (pc.size() == 0) return false;
-  }
+      uint64_t matched = 0;
+      for (int v = 0; v < m_; v++) {
+        uint64_t match = bfs.Reached(v) & (regexp_[v] == '.' ? active :
+                                           reading[static_cast<unsigned char>(regexp_[v])]);
+        seeds[v + 1] = match;
+        matched |= match;
+      }
+      seeds[0] = 0;
+      // a lane without a match keeps its states
+      for (int v = 0; v <= m_; v++)
+        seeds[v] |= bfs.Reached(v) & all & ~matched;
+      bfs.RunLanes(seeds);
+    }
 
-  // check for accept state
-  for (int v : pc)
-    if (v == m_) return true;
-  return false;
+    // check for accept state
+    for (int i = 0; i < lanes; i++)
+      recognized[first + i] = bfs.Marked(i, m_);
+  }
+  return recognized;
 }
 }
 
-
 /**
  * Unit tests the {@code NFA} data type.
  *
@@ -126,9 +156,17 @@ using std::cout;
 using std::endl;
 int main(int argc, char *argv[]) {
   string regexp = "(" + string(argv[1]) + ")";
-  string txt = argv[2];
   NFA nfa(regexp);
-  cout << nfa.Recognizes(txt) << endl;
+  if (argc == 3) {
+    cout << nfa.Recognizes(argv[2]) << endl;
+    return 0;
+  }
+
+  // several texts, simulated together
+  vector<string> texts(argv + 2, argv + argc);
+  vector<bool> recognized = nfa.RecognizesAll(texts);
+  for (size_t i = 0; i < texts.size(); i++)
+    cout << texts[i] << ' ' << recognized[i] << endl;
 
   return 0;
 }
@@ -2,6 +2,7 @@
 #define NFA_H_
 
 #include <string>
+#include <vector>
 
 #include "digraph.h"
 
@@ -24,6 +25,10 @@
  *  is the number of characters in the regular expression.
  *  The <em>recognizes</em> method takes time proportional to <em>m n</em>,
  *  where <em>n</em> is the number of characters in the text.
+ *  {@code RecognizesAll} simulates the NFA on up to 64 texts at once with
+ *  {@link BitParallelBFS}, each text a lane of the same search of the
+ *  epsilon transitions, in time proportional to <em>m n</em> per batch,
+ *  where <em>n</em> is the length of the longest text of the batch.
  *  <p>
  *  For additional documentation,
  *  see <a href="https://algs4.cs.princeton.edu/54regexp">Section 5.4</a> of
@@ -56,6 +61,16 @@ public:
      *         {@code false} otherwise
      */
   bool Recognizes(const std::string& txt) const;
+
+    /**
+     * Returns, for each text, true if it is matched by the regular expression.
+     *
+     * @param  texts the texts
+     * @return {@code recognized[i]} is {@code true} if {@code texts[i]} is
+     *         matched by the regular expression, {@code false} otherwise
+     * @throws IllegalArgumentException if a text contains a metacharacter
+     */
+  std::vector<bool> RecognizesAll(const std::vector<std::string>& texts) const;
 private:
   Digraph graph_;     // digraph of epsilon transitions
   std::string regexp_;     // regular expression
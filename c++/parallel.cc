@@ -0,0 +1,45 @@
+/******************************************************************************
+ *  Compilation:  clang++ -DDebug -O2 parallel.cc -std=c++20 -pthread -o parallel
+ *  Execution:    ./parallel n threads
+ *  Dependencies: 
+ *
+ *  Fork-join helpers used by the parallel graph algorithms.
+ *
+ *  % ./parallel 1000000 8
+ *  sum of 0..999999 with 8 threads = 499999500000
+ *  first multiple of 7919 from 500000 = 506816
+ *
+ ******************************************************************************/
+
+#include "parallel.h"
+
+/**
+ * Unit tests the parallel helpers.
+ *
+ * @param args the command-line arguments
+ */
+#ifdef Debug
+#include <cstdio>
+#include <string>
+#include <atomic>
+using namespace algs4;
+int main(int argc, char *argv[]) {
+  long long n = std::stoll(argv[1]);
+  int threads = argc > 2 ? std::stoi(argv[2]) : DefaultThreads();
+
+  std::atomic<long long> sum{0};
+  ParallelFor(n, threads, [&](long long begin, long long end) {
+    long long block = 0;
+    for (long long i = begin; i < end; i++) block += i;
+    sum += block;
+  });
+  printf("sum of 0..%lld with %d threads = %lld\n", n - 1, threads, sum.load());
+
+  long long first = ParallelFindFirst(n, threads, [&](long long i) {
+    return i >= n / 2 && i % 7919 == 0;
+  });
+  printf("first multiple of 7919 from %lld = %lld\n", n / 2, first);
+
+  return 0;
+}
+#endif
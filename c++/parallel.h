@@ -0,0 +1,126 @@
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+
+/**
+ *  Small fork-join helpers shared by the parallel graph algorithms.
+ *  <p>
+ *  {@code ParallelInvoke(threads, f)} runs {@code f(t)} for every thread
+ *  number <em>t</em> between 0 and {@code threads} - 1, the calling thread
+ *  running <em>t</em> = 0, and returns once all of them have finished.
+ *  {@code ParallelFor(n, threads, f)} splits the range [0, <em>n</em>) into
+ *  one contiguous block per thread and runs {@code f(begin, end)} on each.
+ *  The block of thread <em>t</em> precedes the block of thread <em>t</em> + 1,
+ *  so per-thread results can be concatenated in thread order to obtain a
+ *  deterministic result. {@code ParallelFindFirst(n, threads, bad)} returns
+ *  the smallest <em>i</em> for which {@code bad(i)} holds, as a bulk
+ *  validation sweep.
+ *  <p>
+ *  If a task throws, the exception of the lowest-numbered failing thread is
+ *  rethrown in the calling thread after all threads have been joined.
+ */
+
+namespace algs4 {
+
+/**
+ * Returns the number of threads the parallel algorithms use by default:
+ * the hardware concurrency, and at least 1.
+ *
+ * @return the default number of threads
+ */
+inline int DefaultThreads() {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * Runs {@code f(t)} for {@code t} = 0, 1, ..., {@code threads} - 1 in parallel.
+ *
+ * @param threads the number of threads; values below 1 are treated as 1
+ * @param f the task, called once with each thread number
+ */
+template <typename F>
+void ParallelInvoke(int threads, F&& f) {
+  threads = std::max(threads, 1);
+  if (threads == 1) {
+    f(0);
+    return;
+  }
+
+  std::vector<std::exception_ptr> errors(threads);
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (int t = 1; t < threads; t++) {
+    workers.emplace_back([&f, &errors, t] {
+      try {
+        f(t);
+      } catch (...) {
+        errors[t] = std::current_exception();
+      }
+    });
+  }
+  try {
+    f(0);
+  } catch (...) {
+    errors[0] = std::current_exception();
+  }
+  for (std::thread& worker : workers)
+    worker.join();
+
+  for (std::exception_ptr& error : errors)
+    if (error) std::rethrow_exception(error);
+}
+
+/**
+ * Splits [0, {@code n}) into {@code threads} contiguous blocks of nearly
+ * equal size and runs {@code f(begin, end)} on each block in parallel.
+ *
+ * @param n the size of the range
+ * @param threads the number of threads; values below 1 are treated as 1
+ * @param f the task, called once per block with its half-open bounds
+ */
+template <typename F>
+void ParallelFor(long long n, int threads, F&& f) {
+  threads = static_cast<int>(std::clamp<long long>(n, 1, std::max(threads, 1)));
+  ParallelInvoke(threads, [&](int t) {
+    long long begin = n * t / threads;
+    long long end = n * (t + 1) / threads;
+    if (begin < end) f(begin, end);
+  });
+}
+
+/**
+ * Returns the smallest {@code i} in [0, {@code n}) for which {@code bad(i)}
+ * is true. Each block is first swept without branches, OR-ing the results of
+ * {@code bad}, so that the common case of no match vectorizes; only a block
+ * containing a match is scanned again to locate it.
+ *
+ * @param n the size of the range
+ * @param threads the number of threads; values below 1 are treated as 1
+ * @param bad the predicate, which must be cheap and free of side effects
+ * @return the smallest {@code i} with {@code bad(i)}, or {@code n} if there is none
+ */
+template <typename F>
+long long ParallelFindFirst(long long n, int threads, F&& bad) {
+  std::atomic<long long> first{n};
+  ParallelFor(n, threads, [&](long long begin, long long end) {
+    bool any = false;
+    for (long long i = begin; i < end; i++)
+      any |= static_cast<bool>(bad(i));
+    if (!any) return;
+
+    long long i = begin;
+    while (!bad(i)) i++;
+    long long seen = first.load(std::memory_order_relaxed);
+    while (i < seen && !first.compare_exchange_weak(seen, i, std::memory_order_relaxed)) {}
+  });
+
+  return first.load(std::memory_order_relaxed);
+}
+}
+
+#endif  // PARALLEL_H_
@@ -0,0 +1,214 @@
+/******************************************************************************
+ *  Compilation:  clang++ -c -O2 digraph.cc -std=c++20
+ *                clang++ -c -O2 compact_digraph.cc -std=c++20
+ *                clang++ -c -O2 tarjan_scc.cc -std=c++20
+ *                clang++ -c -O2 directed_edge.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_digraph.cc -std=c++20
+ *                clang++ -c -O2 edge.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_graph.cc -std=c++20
+ *                clang++ -c -O2 graph_generator.cc -std=c++20
+ *                clang++ -DDebug -O2 parallel_scc.cc digraph.o compact_digraph.o tarjan_scc.o directed_edge.o edge_weighted_digraph.o edge.o edge_weighted_graph.o graph_generator.o -std=c++20 -pthread -o parallel_scc
+ *  Execution:    ./parallel_scc filename.txt
+ *                ./parallel_scc scale E seed max-threads
+ *  Dependencies: digraph.cc compact_digraph.cc tarjan_scc.cc parallel.h
+ *                graph_generator.h
+ *  Data files:   https://algs4.cs.princeton.edu/42digraph/tinyDG.txt
+ *                https://algs4.cs.princeton.edu/42digraph/mediumDG.txt
+ *
+ *  Compute the strongly-connected components of a digraph with several
+ *  threads, by trimming, forward-backward search and coloring. With a file,
+ *  prints the components; otherwise compares the running times on an R-MAT
+ *  digraph and on a chain of large components for 1, 2, 4, ... threads
+ *  against TarjanSCC. (The sample run is from a single-core machine.)
+ *
+ *  % ./parallel_scc tinyDG.txt
+ *  5 strong components
+ *  0 2 3 4 5
+ *  1
+ *  6 8
+ *  7
+ *  9 10 11 12
+ *
+ *  % ./parallel_scc 20 16000000 1 4
+ *  rmat: 1048576 vertices, 16000000 edges
+ *  TarjanSCC           364.9 ms, 609370 strong components
+ *  threads        ms   speedup  trimmed    giant  rounds
+ *        1     923.1      0.40   609369   439207       0
+ *        2     934.0      0.39   609369   439207       0
+ *        4     978.8      0.37   609369   439207       0
+ *  blocks: 1048576 vertices, 4194304 edges
+ *  TarjanSCC           118.3 ms, 63656 strong components
+ *  threads        ms   speedup  trimmed    giant  rounds
+ *        1     607.5      0.19    24561      970       1
+ *        2     611.4      0.19    24561      970       1
+ *        4     616.7      0.19    24561      970       1
+ *  components agree with TarjanSCC for every number of threads
+ *
+ ******************************************************************************/
+
+#include "parallel_scc.h"
+
+#include <stdexcept>
+#include <string>
+
+using std::to_string;
+
+namespace algs4 {
+bool ParallelSCC::StronglyConnected(int v, int w) const {
+  ValidateVertex(v);
+  ValidateVertex(w);
+  return id_[v] == id_[w];
+}
+
+int ParallelSCC::id(int v) const {
+  ValidateVertex(v);
+  return id_[v];
+}
+
+void ParallelSCC::Number() {
+  // id_[v] is a vertex of the component of v until v is renumbered, which
+  // happens after every smaller vertex has been
+  int V = id_.size();
+  std::vector<int> number(V, -1);
+  count_ = 0;
+  for (int v = 0; v < V; v++) {
+    int& n = number[id_[v]];
+    if (n < 0) n = count_++;
+    id_[v] = n;
+  }
+}
+
+void ParallelSCC::ValidateVertex(int v) const {
+  int V = id_.size();
+  if (v < 0 || v >= V)
+    throw std::invalid_argument("vertex " + to_string(v) +
+                                " is not between 0 and " + to_string(V-1));
+}
+}
+
+/**
+ * Unit tests the {@code ParallelSCC} data type.
+ *
+ * @param args the command-line arguments
+ */
+#ifdef Debug
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <queue>
+
+#include "digraph.h"
+#include "graph_generator.h"
+
+using namespace algs4;
+using std::vector;
+using Clock = std::chrono::steady_clock;
+
+double MillisSince(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// do the two numberings define the same partition?
+template <typename A, typename B>
+bool SamePartition(const A& a, const B& b, int V) {
+  if (a.count() != b.count()) return false;
+  vector<int> to_b(a.count(), -1);
+  for (int v = 0; v < V; v++) {
+    int& c = to_b[a.id(v)];
+    if (c == -1) c = b.id(v);
+    if (c != b.id(v)) return false;
+  }
+  return true;
+}
+
+// times TarjanSCC and then ParallelSCC with 1, 2, 4, ... threads on G, and
+// checks that they all find the same components, numbered the same way
+bool Benchmark(const CompactDigraph& G, int max_threads) {
+  Clock::time_point start = Clock::now();
+  TarjanSCC tarjan(G);
+  double sequential_time = MillisSince(start);
+  printf("TarjanSCC         %7.1f ms, %d strong components\n", sequential_time, tarjan.count());
+
+  printf("threads        ms   speedup  trimmed    giant  rounds\n");
+  bool agree = true;
+  vector<int> ids;
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    start = Clock::now();
+    ParallelSCC scc(G, threads);
+    double time = MillisSince(start);
+    printf("%7d %9.1f %9.2f %8d %8d %7d\n", threads, time, sequential_time / time,
+           scc.trimmed(), scc.giant(), scc.rounds());
+    agree = agree && SamePartition(scc, tarjan, G.V());
+    vector<int> numbering(G.V());
+    for (int v = 0; v < G.V(); v++)
+      numbering[v] = scc.id(v);
+    if (threads == 1) ids = std::move(numbering);
+    else agree = agree && numbering == ids;
+  }
+  return agree;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc == 2) {
+    std::fstream in(argv[1]);
+    if (!in.is_open()) {
+      std::cout << "failed to open " << argv[1] << '\n';
+      return 1;
+    }
+    Digraph G(in);
+    ParallelSCC scc(G);
+
+    // number of connected components
+    int m = scc.count();
+    std::cout << m << " strong components" << std::endl;
+
+    // compute list of vertices in each strong component
+    vector<std::queue<int>> components(m);
+    for (int v = 0; v < G.V(); v++) {
+      components[scc.id(v)].push(v);
+    }
+
+    // print results
+    for (int i = 0; i < m; i++) {
+      while (!components[i].empty()) {
+        std::cout << components[i].front() << " ";
+        components[i].pop();
+      }
+      std::cout << std::endl;
+    }
+    return SamePartition(scc, TarjanSCC(G), G.V()) ? 0 : 1;
+  }
+
+  int scale = std::stoi(argv[1]);
+  int E = std::stoi(argv[2]);
+  uint64_t seed = std::stoull(argv[3]);
+  int max_threads = std::stoi(argv[4]);
+  CompactDigraph rmat = GenerateDigraph(GraphModel::RMat(scale, E, seed), max_threads);
+  printf("rmat: %d vertices, %d edges\n", rmat.V(), rmat.E());
+  bool agree = Benchmark(rmat, max_threads);
+
+  // blocks of 1024 vertices, each vertex with 3 random edges within its
+  // block and 1 into the next block: a chain of large components, most of
+  // which are left to coloring
+  int V = rmat.V();
+  GraphModel model = GraphModel::ErdosRenyi(1024, 4 * V, seed);
+  vector<int> offsets(V + 1), targets(4 * V);
+  for (int v = 0; v < V; v++) {
+    offsets[v + 1] = 4 * (v + 1);
+    int block = v / 1024 * 1024;
+    for (int i = 0; i < 4; i++) {
+      int w = block + model.Endpoints(4 * v + i).second;
+      if (i == 3) w = std::min(w + 1024, V - 1);
+      targets[4 * v + i] = std::min(w, V - 1);
+    }
+  }
+  CompactDigraph chain(V, std::move(offsets), std::move(targets));
+  printf("blocks: %d vertices, %d edges\n", chain.V(), chain.E());
+  agree = Benchmark(chain, max_threads) && agree;
+  printf("components %s with TarjanSCC for every number of threads\n",
+         agree ? "agree" : "do not agree");
+
+  return agree ? 0 : 1;
+}
+#endif
@@ -0,0 +1,417 @@
+#ifndef PARALLEL_SCC_H_
+#define PARALLEL_SCC_H_
+
+/**
+ *  The {@code ParallelSCC} class represents a data type for
+ *  determining the strong components in a digraph with several threads.
+ *  The <em>id</em> operation determines in which strong component
+ *  a given vertex lies; the <em>areStronglyConnected</em> operation
+ *  determines whether two vertices are in the same strong component;
+ *  and the <em>count</em> operation determines the number of strong
+ *  components.
+ *  <p>
+ *  The components are the same as those of {@link KosarajuSharirSCC} and
+ *  {@link TarjanSCC}, but they are numbered in order of their smallest
+ *  vertex, so that the identifiers do not depend on the number of threads.
+ *  <p>
+ *  This implementation follows the Multistep method of Slota, Rajamanickam
+ *  and Madduri. Each step removes the components it finds; the vertices not
+ *  yet assigned to a component are called <em>active</em>.
+ *  <ul>
+ *  <li> Trimming: an active vertex with no active predecessor or no active
+ *       successor is a component by itself. Removing it may expose others,
+ *       so trimming continues, one frontier at a time, until none is left.
+ *  <li> Forward-backward: the component of the active vertex with the
+ *       largest product of indegree and outdegree, usually the giant
+ *       component, is the intersection of the vertices it reaches by a
+ *       forward and by a backward breadth-first search.
+ *  <li> Coloring: every active vertex takes the largest vertex id that
+ *       reaches it, by propagating ids forward until nothing changes. Each
+ *       vertex that keeps its own id is the root of a component, which is
+ *       found by a backward search through the vertices of its color. The
+ *       round repeats, after a new trimming, on the vertices left.
+ *  <li> Once fewer than 2<sup>16</sup> vertices are active, a sequential
+ *       {@link TarjanSCC} on the subgraph they induce finishes the job.
+ *  </ul>
+ *  Every frontier is processed in parallel, with the vertices claimed by
+ *  atomic compare-and-swap. The constructor takes
+ *  O(<em>V</em> + <em>E</em>) time per coloring round and
+ *  O(<em>V</em> + <em>E</em>) extra space for the reverse of the digraph.
+ *  Each instance method takes &Theta;(1) time.
+ *  <p>
+ *  For additional documentation, see
+ *  <a href="https://algs4.cs.princeton.edu/42digraph">Section 4.2</a> of
+ *  <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include "graph_concepts.h"
+#include "parallel.h"
+#include "tarjan_scc.h"
+
+namespace algs4 {
+
+class ParallelSCC {
+public:
+  /**
+   * Computes the strong components of the digraph {@code G}, which may be
+   * any adjacency digraph or edge-weighted digraph.
+   * @param G the digraph
+   * @param threads the number of threads
+   */
+  template <DirectedGraph Graph>
+  ParallelSCC(const Graph& G, int threads = DefaultThreads()) : id_(G.V(), -1) {
+    Solver<Graph> solver(G, id_, threads);
+    solver.Solve();
+    trimmed_ = solver.trimmed;
+    giant_ = solver.giant;
+    rounds_ = solver.rounds;
+    Number();
+  }
+  ParallelSCC() = delete;
+  ParallelSCC(const ParallelSCC& other) = default;
+  ParallelSCC &operator=(const ParallelSCC& other) = default;
+  ParallelSCC(ParallelSCC&& other) = default;
+  ParallelSCC &operator=(ParallelSCC&& other) = default;
+
+  /**
+   * Returns the number of strong components.
+   * @return the number of strong components
+   */
+  int count() const { return count_; }
+
+  /**
+   * Are vertices {@code v} and {@code w} in the same strong component?
+   * @param  v one vertex
+   * @param  w the other vertex
+   * @return {@code true} if vertices {@code v} and {@code w} are in the same
+   *         strong component, and {@code false} otherwise
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   * @throws IllegalArgumentException unless {@code 0 <= w < V}
+   */
+  bool StronglyConnected(int v, int w) const;
+
+  /**
+   * Returns the component id of the strong component containing vertex {@code v}.
+   * @param  v the vertex
+   * @return the component id of the strong component containing vertex {@code v}
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   */
+  int id(int v) const;
+
+  /**
+   * Returns the number of vertices removed by trimming.
+   * @return the number of vertices removed by trimming
+   */
+  int trimmed() const { return trimmed_; }
+  /**
+   * Returns the size of the component found by the forward-backward search.
+   * @return the size of the component found by the forward-backward search
+   */
+  int giant() const { return giant_; }
+  /**
+   * Returns the number of coloring rounds.
+   * @return the number of coloring rounds
+   */
+  int rounds() const { return rounds_; }
+
+private:
+  // below this many active vertices, the sequential algorithm finishes
+  static constexpr int kSerialCutoff = 1 << 16;
+  // a frontier gets one thread per this many vertices, up to all of them
+  static constexpr int kGrain = 1024;
+
+  // the state of the computation: id[v] is -1 while v is active, and then a
+  // vertex of its component
+  template <DirectedGraph Graph>
+  struct Solver {
+    Solver(const Graph& G, std::vector<int>& id, int threads) :
+      G(G), V(G.V()), id(id), threads(std::max(threads, 1)) {}
+
+    static int Load(int& x) {
+      return std::atomic_ref<int>(x).load(std::memory_order_relaxed);
+    }
+    bool Active(int v) const { return Load(id[v]) < 0; }
+    // assigns the active vertex v to the component of vertex root
+    bool Claim(int v, int root) {
+      int expected = -1;
+      return std::atomic_ref<int>(id[v]).compare_exchange_strong(
+          expected, root, std::memory_order_relaxed);
+    }
+
+    // runs visit(begin, end, found) on a block of [0, n) per thread and
+    // returns the vertices found, in thread order
+    template <typename F>
+    std::vector<int> Collect(long long n, F&& visit) {
+      int blocks = static_cast<int>(std::clamp<long long>(n / kGrain, 1, threads));
+      std::vector<std::vector<int>> found(blocks);
+      ParallelInvoke(blocks, [&](int t) {
+        visit(n * t / blocks, n * (t + 1) / blocks, found[t]);
+      });
+      if (blocks == 1) return std::move(found[0]);
+      std::vector<int> all;
+      for (const std::vector<int>& part : found)
+        all.insert(all.end(), part.begin(), part.end());
+      return all;
+    }
+
+    // the reverse digraph in compressed sparse row form, each list in
+    // increasing order; built as in GenerateDigraph, from a histogram of
+    // the heads of each block of tails, with the histograms together no
+    // larger than the edge array
+    void Transpose() {
+      long long E = 0;
+      if constexpr (requires { { G.E() } -> std::convertible_to<long long>; }) {
+        E = G.E();
+      } else {
+        for (int v = 0; v < V; v++)
+          E += std::ranges::distance(Heads(G, v));
+      }
+      int blocks = static_cast<int>(std::clamp<long long>(E / std::max(V, 1), 1, threads));
+      auto first = [&](int c) { return static_cast<int>(1LL * V * c / blocks); };
+
+      std::vector<std::vector<int>> indegree(blocks);
+      ParallelInvoke(blocks, [&](int c) {
+        std::vector<int>& histogram = indegree[c];
+        histogram.assign(V, 0);
+        for (int v = first(c); v < first(c + 1); v++)
+          for (int w : Heads(G, v))
+            ++histogram[w];
+      });
+      roffsets.assign(V + 1, 0);
+      for (int w = 0; w < V; w++) {
+        int next = roffsets[w];
+        for (std::vector<int>& histogram : indegree) {
+          int count = histogram[w];
+          histogram[w] = next;
+          next += count;
+        }
+        roffsets[w + 1] = next;
+      }
+      rtargets.resize(roffsets[V]);
+      ParallelInvoke(blocks, [&](int c) {
+        std::vector<int>& next = indegree[c];
+        for (int v = first(c); v < first(c + 1); v++)
+          for (int w : Heads(G, v))
+            rtargets[next[w]++] = v;
+      });
+    }
+    std::span<const int> Tails(int v) const {
+      return std::span<const int>(rtargets).subspan(roffsets[v], roffsets[v + 1] - roffsets[v]);
+    }
+
+    void Solve() {
+      Transpose();
+      indegree.resize(V);
+      outdegree.resize(V);
+      active = V;
+      Trim();
+      if (active > 0) ForwardBackward();
+      while (active > kSerialCutoff) {
+        Color();
+        Trim();
+      }
+      if (active > 0) Finish();
+    }
+
+    void Trim() {
+      std::vector<int> frontier = Collect(V, [&](int begin, int end, std::vector<int>& found) {
+        for (int v = begin; v < end; v++) {
+          if (!Active(v)) continue;
+          int in = 0, out = 0;
+          for (int w : Heads(G, v))
+            out += Active(w);
+          for (int u : Tails(v))
+            in += Active(u);
+          indegree[v] = in;
+          outdegree[v] = out;
+          if (in == 0 || out == 0) found.push_back(v);
+        }
+      });
+      for (int v : frontier)
+        id[v] = v;
+
+      auto decrement = [](int& degree) {
+        return std::atomic_ref<int>(degree).fetch_sub(1, std::memory_order_relaxed) == 1;
+      };
+      while (!frontier.empty()) {
+        trimmed += frontier.size();
+        active -= frontier.size();
+        frontier = Collect(frontier.size(), [&](int begin, int end, std::vector<int>& found) {
+          for (int i = begin; i < end; i++) {
+            int v = frontier[i];
+            for (int w : Heads(G, v))
+              if (Active(w) && decrement(indegree[w]) && Claim(w, w)) found.push_back(w);
+            for (int u : Tails(v))
+              if (Active(u) && decrement(outdegree[u]) && Claim(u, u)) found.push_back(u);
+          }
+        });
+      }
+    }
+
+    // marks with bit the active vertices reachable from s, following
+    // successors if forward and predecessors otherwise
+    void Search(int s, unsigned char bit, bool forward) {
+      reached[s] |= bit;
+      std::vector<int> frontier{s};
+      while (!frontier.empty()) {
+        frontier = Collect(frontier.size(), [&](int begin, int end, std::vector<int>& found) {
+          auto visit = [&](int w) {
+            if (!Active(w)) return;
+            std::atomic_ref<unsigned char> mark(reached[w]);
+            if (mark.load(std::memory_order_relaxed) & bit) return;
+            if (!(mark.fetch_or(bit, std::memory_order_relaxed) & bit))
+              found.push_back(w);
+          };
+          for (int i = begin; i < end; i++) {
+            if (forward) {
+              for (int w : Heads(G, frontier[i])) visit(w);
+            } else {
+              for (int w : Tails(frontier[i])) visit(w);
+            }
+          }
+        });
+      }
+    }
+
+    void ForwardBackward() {
+      // the pivot: the largest product of degrees, the smallest vertex on ties
+      std::vector<int> best(threads, -1);
+      auto better = [&](int v, int w) {
+        if (w < 0) return true;
+        long long a = 1LL * indegree[v] * outdegree[v], b = 1LL * indegree[w] * outdegree[w];
+        return a > b || (a == b && v < w);
+      };
+      ParallelInvoke(threads, [&](int t) {
+        for (int v = 1LL * V * t / threads; v < 1LL * V * (t + 1) / threads; v++)
+          if (Active(v) && better(v, best[t])) best[t] = v;
+      });
+      int pivot = -1;
+      for (int v : best)
+        if (v >= 0 && better(v, pivot)) pivot = v;
+
+      reached.assign(V, 0);
+      Search(pivot, 1, true);
+      Search(pivot, 2, false);
+      std::vector<int> component = Collect(V, [&](int begin, int end, std::vector<int>& found) {
+        for (int v = begin; v < end; v++)
+          if (reached[v] == 3) found.push_back(v);
+      });
+      for (int v : component)
+        id[v] = pivot;
+      giant = component.size();
+      active -= component.size();
+      reached.clear();
+      reached.shrink_to_fit();
+    }
+
+    void Color() {
+      rounds++;
+      color.resize(V);
+      queued.assign(V, 0);
+      std::vector<int> frontier = Collect(V, [&](int begin, int end, std::vector<int>& found) {
+        for (int v = begin; v < end; v++) {
+          color[v] = v;
+          if (Active(v)) found.push_back(v);
+        }
+      });
+
+      // propagate the largest color forward until nothing changes
+      while (!frontier.empty()) {
+        frontier = Collect(frontier.size(), [&](int begin, int end, std::vector<int>& found) {
+          for (int i = begin; i < end; i++) {
+            int v = frontier[i];
+            int c = Load(color[v]);
+            for (int w : Heads(G, v)) {
+              if (!Active(w)) continue;
+              std::atomic_ref<int> target(color[w]);
+              int old = target.load(std::memory_order_relaxed);
+              while (old < c && !target.compare_exchange_weak(old, c, std::memory_order_relaxed)) {}
+              if (old >= c) continue;
+              if (!std::atomic_ref<unsigned char>(queued[w]).exchange(1, std::memory_order_relaxed))
+                found.push_back(w);
+            }
+          }
+        });
+        ParallelFor(frontier.size(), threads, [&](long long begin, long long end) {
+          for (long long i = begin; i < end; i++)
+            queued[frontier[i]] = 0;
+        });
+      }
+
+      // the component of each root is the part of its color that reaches it
+      frontier = Collect(V, [&](int begin, int end, std::vector<int>& found) {
+        for (int v = begin; v < end; v++)
+          if (Active(v) && color[v] == v) found.push_back(v);
+      });
+      for (int v : frontier)
+        id[v] = v;
+      while (!frontier.empty()) {
+        active -= frontier.size();
+        frontier = Collect(frontier.size(), [&](int begin, int end, std::vector<int>& found) {
+          for (int i = begin; i < end; i++) {
+            int w = frontier[i], c = color[w];
+            for (int u : Tails(w))
+              if (color[u] == c && Active(u) && Claim(u, c)) found.push_back(u);
+          }
+        });
+      }
+    }
+
+    // the strong components of the subgraph induced by the active vertices
+    void Finish() {
+      struct Remainder {
+        const Solver& solver;
+        int V() const { return solver.V; }
+        auto Adj(int v) const {
+          bool keep = solver.Active(v);
+          return Heads(solver.G, v) |
+                 std::views::filter([&s = solver, keep](int w) { return keep && s.Active(w); });
+        }
+      };
+      TarjanSCC scc(Remainder{*this});
+      std::vector<int> root(scc.count(), -1);
+      for (int v = 0; v < V; v++) {
+        if (!Active(v)) continue;
+        int& r = root[scc.id(v)];
+        if (r < 0) r = v;
+        id[v] = r;
+      }
+      active = 0;
+    }
+
+    const Graph& G;
+    int V;
+    std::vector<int>& id;
+    int threads;
+    int active = 0;
+    int trimmed = 0;
+    int giant = 0;
+    int rounds = 0;
+    std::vector<int> roffsets, rtargets;    // the reverse digraph
+    std::vector<int> indegree, outdegree;   // active neighbors, while trimming
+    std::vector<unsigned char> reached;     // bit 1 forward, bit 2 backward
+    std::vector<int> color;
+    std::vector<unsigned char> queued;      // queued[v] = is v in the next frontier?
+  };
+
+  // renumber the components in order of their smallest vertex
+  void Number();
+  // throw an IllegalArgumentException unless {@code 0 <= v < V}
+  void ValidateVertex(int v) const;
+
+private:
+  std::vector<int> id_;     // id_[v] = id of strong component containing v
+  int count_{0};            // number of strongly-connected components
+  int trimmed_{0};
+  int giant_{0};
+  int rounds_{0};
+};
+}
+
+#endif  // PARALLEL_SCC_H_
@@ -39,10 +39,11 @@
 
 #include "prim_mst.h"
 
-#include <limits>
+#include <cmath>
 #include <iostream>
 
 #include "edge.h"
+#include "edge_weighted_graph.h"
 #include "quick_union_uf.h"
 
 using std::vector;
@@ -50,58 +51,19 @@ using std::cerr;
 using std::endl;
 
 namespace algs4 {
-PrimMST::PrimMST(const EdgeWeightedGraph& G) noexcept : edgeTo_(G.V()), distTo_(G.V()), 
-                                                        marked_(G.V()), 
-                                                        pq_(G.V(), std::greater<double>()) {
-  for (int v = 0; v < G.V(); v++)
-    distTo_[v] = std::numeric_limits<double>::max();
-
-  for (int v = 0; v < G.V(); v++)      // run from each vertex to find
-    if (!marked_[v]) prim(G, v);      // minimum spanning forest
-
-  // check optimality conditions
-  assert(Check(G));
-}
-
-void PrimMST::prim(const EdgeWeightedGraph& G, int s) {
-  distTo_[s] = 0.0;
-  pq_.Insert(s, distTo_[s]);
-  while (!pq_.isEmpty()) {
-    int v = pq_.DelMin();
-    Scan(G, v);
-  }
-}
-
-void PrimMST::Scan(const EdgeWeightedGraph& G, int v) {
-  marked_[v] = true;
-  for (auto it = G.adj(v).begin(); it != G.adj(v).end(); ++it) {
-    int w = (*it)->other(v);
-    if (marked_[w]) continue;         // v-w is obsolete edge
-    if ((*it)->weight() < distTo_[w]) {
-      distTo_[w] = (*it)->weight();
-      edgeTo_[w] = *it;
-      if (pq_.Contains(w)) pq_.DecreaseKey(w, distTo_[w]);
-      else                pq_.Insert(w, distTo_[w]);
-    }
-  }
-}
-
 double PrimMST::weight() const {
   double weight = 0.0;
-  for (Edge* e : edges()) {
-    if (!e) continue;
-    weight += e->weight();
-  }
+  for (const Edge& e : edges())
+    weight += e.weight();
 
   return weight;
 }
 
-bool PrimMST::Check(const EdgeWeightedGraph& G) const {
+bool PrimMST::Check(int V, const vector<Edge>& all) const {
   // check weight
   double totalWeight = 0.0;
-  for (Edge* e : edges()) {
-    if (e) totalWeight += e->weight();
-  }
+  for (const Edge& e : edges())
+    totalWeight += e.weight();
   if (fabs(totalWeight - weight()) > FLOATING_POINT_EPSILON) {
     cerr << "Weight of edges does not equal weight(): " << totalWeight << " vs. " 
          << weight() << endl;
@@ -109,10 +71,9 @@ bool PrimMST::Check(const EdgeWeightedGraph& G) const {
   }
 
   // check that it is acyclic
-  QuickUnionUF<int> uf(G.V());
-  for (Edge* e : edges()) {
-    if (!e) continue;
-    int v = e->Either(), w = e->other(v);
+  QuickUnionUF<int> uf(V);
+  for (const Edge& e : edges()) {
+    int v = e.Either(), w = e.other(v);
     if (uf.Find(v) == uf.Find(w)) {
       cerr << "Not a forest" << endl;
       return false;
@@ -121,9 +82,8 @@ bool PrimMST::Check(const EdgeWeightedGraph& G) const {
   }
 
   // check that it is a spanning forest
-  for (Edge* e : G.Edges()) {
-    if (!e) continue;
-    int v = e->Either(), w = e->other(v);
+  for (const Edge& e : all) {
+    int v = e.Either(), w = e.other(v);
     if (uf.Find(v) != uf.Find(w)) {
       cerr << "Not a spanning forest" << endl;
       return false;
@@ -131,22 +91,20 @@ bool PrimMST::Check(const EdgeWeightedGraph& G) const {
   }
 
   // check that it is a minimal spanning forest (cut optimality conditions)
-  for (Edge* e : edges()) {
-    if (!e) continue;
+  for (const Edge& e : edges()) {
     // all edges in MST except e
-    uf = QuickUnionUF<int>(G.V());
-    for (Edge* f : edges()) {
-      if (!f) continue;
-      int x = f->Either(), y = f->other(x);
-      if (f != e) uf.UnionWith(x, y);
+    uf = QuickUnionUF<int>(V);
+    for (const Edge& f : edges()) {
+      int x = f.Either(), y = f.other(x);
+      if (&f != &e) uf.UnionWith(x, y);
     }
 
     // check that e is min weight edge in crossing cut
-    for (Edge* f : G.Edges()) {
-      int x = f->Either(), y = f->other(x);
+    for (const Edge& f : all) {
+      int x = f.Either(), y = f.other(x);
       if (uf.Find(x) != uf.Find(y)) {
-        if (f->weight() < e->weight()) {
-          cerr << "Edge " << f->ToString() 
+        if (f.weight() < e.weight()) {
+          cerr << "Edge " << f.ToString() 
                << " violates cut optimality conditions" << endl;
           return false;
         }
@@ -172,10 +130,8 @@ using namespace algs4;
 int main(int args, char *argv[]) {
   EdgeWeightedGraph G(argv[1]);
   PrimMST mst(G);
-  for (Edge* e : mst.edges()) {
-    if (!e) continue;
-    std::cout << e->ToString() << endl;
-  }
+  for (const Edge& e : mst.edges())
+    std::cout << e.ToString() << endl;
   std::cout << mst.weight() << endl;
 
   return 0;
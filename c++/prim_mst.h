@@ -1,10 +1,13 @@
 #ifndef PRIM_MST_H_
 #define PRIM_MST_H_
 
+#include <cassert>
+#include <limits>
 #include <vector>
 
+#include "edge.h"
+#include "graph_concepts.h"
 #include "index_min_priority_queue.h"
-#include "edge_weighted_graph.h"
 
 /**
  *  The {@code PrimMST} class represents a data type for computing a
@@ -50,7 +53,19 @@ public:
    * Compute a minimum spanning tree (or forest) of an edge-weighted graph.
    * @param G the edge-weighted graph
    */
-  PrimMST(const EdgeWeightedGraph& G) noexcept;
+  template <WeightedGraph Graph>
+  PrimMST(const Graph& G) :
+    edgeTo_(G.V(), -1), distTo_(G.V(), std::numeric_limits<double>::max()),
+    marked_(G.V()), pq_(G.V(), std::greater<double>()) {
+    for (int v = 0; v < G.V(); v++)      // run from each vertex to find
+      if (!marked_[v]) prim(G, v);      // minimum spanning forest
+
+    for (int e : edgeTo_)
+      if (e != -1) edges_.push_back(G.edge(e));
+
+    // check optimality conditions
+    assert(Check(G.V(), EdgesOf(G)));
+  }
   PrimMST() = delete;
   PrimMST(const PrimMST& other) = default;
   PrimMST &operator=(const PrimMST& other) = default;
@@ -62,7 +77,7 @@ public:
    * @return the edges in a minimum spanning tree (or forest) as
    *    an iterable of edges
    */
-  const std::vector<Edge *>& edges() const { return edgeTo_; }
+  const std::vector<Edge>& edges() const { return edges_; }
 
   /**
    * Returns the sum of the edge weights in a minimum spanning tree (or forest).
@@ -72,19 +87,43 @@ public:
 
 private:
   // run Prim's algorithm in graph G, starting from vertex s
-  void prim(const EdgeWeightedGraph& G, int s);
+  template <WeightedGraph Graph>
+  void prim(const Graph& G, int s) {
+    distTo_[s] = 0.0;
+    pq_.Insert(s, distTo_[s]);
+    while (!pq_.IsEmpty()) {
+      int v = pq_.DelMin();
+      Scan(G, v);
+    }
+  }
 
   // scan vertex v
-  void Scan(const EdgeWeightedGraph& G, int v);
+  template <WeightedGraph Graph>
+  void Scan(const Graph& G, int v) {
+    marked_[v] = true;
+    for (const auto& slot : G.adj(v)) {
+      int w = slot.other;
+      if (marked_[w]) continue;         // v-w is obsolete edge
+      double weight = G.edge(slot.edge).weight();
+      if (weight < distTo_[w]) {
+        distTo_[w] = weight;
+        edgeTo_[w] = slot.edge;
+        if (pq_.Contains(w)) pq_.DecreaseKey(w, distTo_[w]);
+        else                pq_.Insert(w, distTo_[w]);
+      }
+    }
+  }
 
-  // check optimality conditions (takes time proportional to E V lg* V)
-  bool Check(const EdgeWeightedGraph& G) const;
+  // check optimality conditions of a graph on V vertices with the edges
+  // all (takes time proportional to E V lg* V)
+  bool Check(int V, const std::vector<Edge>& all) const;
 
 private:
-  std::vector<Edge *> edgeTo_;        // edgeTo_[v] = shortest edge from tree vertex to non-tree vertex
+  std::vector<int> edgeTo_;           // edgeTo_[v] = id of shortest edge from tree vertex to non-tree vertex, or -1
   std::vector<double> distTo_;      // distTo_[v] = weight of shortest such edge
   std::vector<bool> marked_;     // marked_[v] = true if v on tree, false otherwise
   IndexMinPriorityQueue<double> pq_;
+  std::vector<Edge> edges_;       // edges in the MST
 };
 }
 
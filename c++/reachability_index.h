@@ -0,0 +1,133 @@
+#ifndef REACHABILITY_INDEX_H_
+#define REACHABILITY_INDEX_H_
+
+/**
+ *  The {@code ReachabilityIndex} class represents a data type for answering
+ *  reachability queries in a digraph too large for a
+ *  {@link TransitiveClosure}, whose matrix grows with the square of the
+ *  number of strong components. It has the same API.
+ *  <p>
+ *  This implementation works on the condensation of the digraph and labels
+ *  each strong component, as in GRAIL (Yildirim, Chaoji and Zaki), with one
+ *  interval per depth-first traversal of the condensation: a component
+ *  <em>c</em> finished <em>post</em>-th has the interval
+ *  [<em>low</em>, <em>post</em>], where <em>low</em> is the smallest
+ *  <em>post</em> of the components it reaches. The traversals take the
+ *  roots and the edges in different random orders. If <em>c</em> reaches
+ *  <em>d</em>, every interval of <em>d</em> nests in that of <em>c</em>, so
+ *  a query is answered <em>no</em> in constant time when
+ *  <ul>
+ *  <li> the component id of <em>d</em> is above that of <em>c</em> ({@link TarjanSCC}
+ *       numbers the components in reverse topological order),
+ *  <li> the longest path out of <em>d</em> is no shorter than that out of
+ *       <em>c</em>, or
+ *  <li> some interval of <em>d</em> does not nest in that of <em>c</em>;
+ *  </ul>
+ *  and <em>yes</em> in constant time when <em>d</em> is in the subtree of
+ *  <em>c</em> in the depth-first forest of a traversal. Otherwise it
+ *  searches the condensation from <em>c</em>, only through the components
+ *  that pass the same tests, and stops at the first one whose subtree
+ *  holds <em>d</em>.
+ *  <p>
+ *  The constructor takes &Theta;(<em>k</em>(<em>V</em> + <em>E</em>)) time
+ *  and the index &Theta;(<em>V</em> + <em>E</em> + <em>k C</em>) space,
+ *  where <em>V</em> is the number of vertices, <em>E</em> is the number of
+ *  edges, <em>C</em> is the number of strong components and <em>k</em> the
+ *  number of traversals. A query takes &Theta;(<em>k</em>) time when the
+ *  labels decide it, and time proportional to the size of the condensation
+ *  in the worst case. Queries may run concurrently: the search workspace
+ *  is per thread.
+ *  <p>
+ *  For additional documentation,
+ *  see <a href="https://algs4.cs.princeton.edu/42digraph">Section 4.2</a> of
+ *  <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "compact_digraph.h"
+#include "graph_concepts.h"
+#include "tarjan_scc.h"
+
+namespace algs4 {
+
+class ReachabilityIndex {
+public:
+  /**
+   * Indexes the reachability relation of the digraph {@code G}.
+   * @param G the digraph
+   * @param traversals the number of depth-first traversals, each adding
+   *        an interval to the label of every strong component
+   * @param seed the seed of the random orders of the traversals
+   * @throws IllegalArgumentException if {@code traversals < 1}
+   */
+  template <DirectedGraph Graph>
+  explicit ReachabilityIndex(const Graph& G, int traversals = 3, uint64_t seed = 0) :
+    ReachabilityIndex(G, TarjanSCC(G), traversals, seed) {}
+  ReachabilityIndex() = delete;
+  ReachabilityIndex(const ReachabilityIndex& other) = default;
+  ReachabilityIndex &operator=(const ReachabilityIndex& other) = default;
+  ReachabilityIndex(ReachabilityIndex&& other) = default;
+  ReachabilityIndex &operator=(ReachabilityIndex&& other) = default;
+
+  /**
+   * Is there a directed path from vertex {@code v} to vertex {@code w} in the digraph?
+   * @param  v the source vertex
+   * @param  w the target vertex
+   * @return {@code true} if there is a directed path from {@code v} to {@code w},
+   *         {@code false} otherwise
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   * @throws IllegalArgumentException unless {@code 0 <= w < V}
+   */
+  bool Reachable(int v, int w) const;
+  /**
+   * Returns the number of strong components.
+   * @return the number of strong components
+   */
+  int components() const { return dag_.V(); }
+  /**
+   * Returns the number of depth-first traversals labelling the components.
+   * @return the number of depth-first traversals
+   */
+  int traversals() const { return traversals_; }
+
+private:
+  template <DirectedGraph Graph>
+  ReachabilityIndex(const Graph& G, const TarjanSCC& scc, int traversals, uint64_t seed) :
+    id_(G.V()), dag_(scc.Condensation(G)), traversals_(traversals) {
+    for (int v = 0; v < G.V(); v++)
+      id_[v] = scc.id(v);
+    Build(seed);
+  }
+
+  // the interval of a component in one traversal: the post-order numbers
+  // of the components it reaches lie in [low, post], those of its subtree
+  // in [first, post]
+  struct Label {
+    int low;
+    int first;
+    int post;
+  };
+
+  // label the components of dag_
+  void Build(uint64_t seed);
+  // may component c reach component d, as far as the labels tell?
+  bool MayReach(int c, int d) const;
+  // is component d in the subtree of component c in some traversal?
+  bool InSubtree(int c, int d) const;
+  // search the condensation from component c for component d
+  bool Search(int c, int d) const;
+  // throw an IllegalArgumentException unless {@code 0 <= v < V}
+  void ValidateVertex(int v) const;
+
+private:
+  std::vector<int> id_;           // id_[v] = strong component containing v
+  CompactDigraph dag_;            // the condensation
+  int traversals_;                // labels per component
+  std::vector<int> level_;        // level_[c] = length of the longest path out of c
+  std::vector<Label> labels_;     // labels_[c * traversals_ + i] = label of c in traversal i
+};
+}
+
+#endif  // REACHABILITY_INDEX_H_
@@ -0,0 +1,218 @@
+/******************************************************************************
+ *  Compilation:  clang++ -c -DNDEBUG -O2 digraph.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 compact_digraph.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 directed_edge.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 edge_weighted_digraph.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 directed_dfs.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 depth_first_directed_paths.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 edge.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 edge_weighted_graph.cc -std=c++20
+ *                clang++ -c -DNDEBUG -O2 graph_generator.cc -std=c++20
+ *                clang++ -DDebug -DNDEBUG -O2 search_workspace.cc digraph.o compact_digraph.o directed_edge.o edge_weighted_digraph.o directed_dfs.o depth_first_directed_paths.o edge.o edge_weighted_graph.o graph_generator.o -std=c++20 -pthread -o search_workspace
+ *  Execution:    ./search_workspace V E seed queries
+ *  Dependencies: search_workspace.h directed_dfs.h depth_first_directed_paths.h
+ *                dijkstra_sp.h bellman_ford_sp.h graph_generator.h
+ *
+ *  Runs searches from many random sources of a sparse random digraph, in
+ *  which each source reaches few vertices, each search allocating its own
+ *  arrays and all of them sharing one workspace, and compares them. A
+ *  fresh DijkstraSP also checks the weights of all the edges, in time
+ *  proportional to E, and its row includes that scan; the optimality
+ *  checks are compiled out with NDEBUG. Last, BellmanFordSP from a few of
+ *  the sources is run fresh and borrowed, with and without negative cycles,
+ *  and the results compared.
+ *
+ *  % ./search_workspace 1000000 500000 1 300
+ *  random digraph: 1000000 vertices, 500000 edges
+ *  DirectedDFS                fresh     0.088 ms, borrowed     0.000 ms per search
+ *  DepthFirstDirectedPaths    fresh     0.513 ms, borrowed     0.000 ms per search
+ *  DijkstraSP (fresh scans E) fresh    33.671 ms, borrowed     0.001 ms per search
+ *  BellmanFordSP              20 sources, 0 with a reachable negative cycle
+ *  2.0 vertices reached per search, searches agree
+ *
+ *  % ./search_workspace 200000 400000 2 50
+ *  random digraph: 200000 vertices, 400000 edges
+ *  DirectedDFS                fresh     5.057 ms, borrowed     4.943 ms per search
+ *  DepthFirstDirectedPaths    fresh     5.511 ms, borrowed     4.744 ms per search
+ *  DijkstraSP (fresh scans E) fresh    49.858 ms, borrowed    46.921 ms per search
+ *  BellmanFordSP              20 sources, 16 with a reachable negative cycle
+ *  120952.3 vertices reached per search, searches agree
+ *
+ ******************************************************************************/
+
+#include "search_workspace.h"
+
+/**
+ * Unit tests the {@code SearchWorkspace} data type.
+ *
+ * @param args the command-line arguments
+ */
+#ifdef Debug
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <stack>
+#include <string>
+
+#include "bellman_ford_sp.h"
+#include "depth_first_directed_paths.h"
+#include "dijkstra_sp.h"
+#include "directed_dfs.h"
+#include "graph_generator.h"
+
+using namespace algs4;
+using std::vector;
+using Clock = std::chrono::steady_clock;
+
+double MillisSince(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main(int argc, char *argv[]) {
+  int V = std::stoi(argv[1]);
+  int E = std::stoi(argv[2]);
+  uint64_t seed = std::stoull(argv[3]);
+  int queries = std::stoi(argv[4]);
+  GraphModel model = GraphModel::ErdosRenyi(V, E, seed);
+  CompactDigraph G = GenerateDigraph(model);
+  EdgeWeightedDigraph H = GenerateEdgeWeightedDigraph(model);
+  printf("random digraph: %d vertices, %d edges\n", G.V(), G.E());
+
+  std::mt19937_64 random(seed);
+  vector<int> sources(queries);
+  for (int& s : sources)
+    s = static_cast<int>(random() % V);
+
+  // runs search(s) from every source, and returns the time per search
+  auto time = [&](auto search) {
+    Clock::time_point start = Clock::now();
+    for (int s : sources)
+      search(s);
+    return MillisSince(start) / queries;
+  };
+  auto report = [](const char* name, double fresh, double borrowed) {
+    printf("%-26s fresh %9.3f ms, borrowed %9.3f ms per search\n", name, fresh, borrowed);
+  };
+
+  // the workspaces grow to V on their first search, once
+  SearchWorkspace workspace, paths;
+  DirectedDFS warm(G, sources[0], workspace);
+  DepthFirstDirectedPaths warm_dfs(G, sources[0], workspace);
+  DijkstraSP warm_paths(H, sources[0], paths);
+
+  bool agree = true;
+  long long reached = 0;
+  vector<int> counts;
+  double fresh = time([&](int s) {
+    DirectedDFS dfs(G, s);
+    counts.push_back(dfs.count());
+  });
+  int k = 0;
+  double borrowed = time([&](int s) {
+    DirectedDFS dfs(G, s, workspace);
+    agree = agree && dfs.count() == counts[k++];
+    reached += dfs.count();
+  });
+  report("DirectedDFS", fresh, borrowed);
+
+  fresh = time([&](int s) {
+    DepthFirstDirectedPaths paths(G, s);
+  });
+  borrowed = time([&](int s) {
+    DepthFirstDirectedPaths paths(G, s, workspace);
+  });
+  report("DepthFirstDirectedPaths", fresh, borrowed);
+
+  // a borrowed search reaches every vertex a fresh one does, whatever
+  // earlier searches left in the workspace, and finds the same paths to a
+  // sample of them; comparing every path would take time proportional to
+  // the vertices reached times the depth of the search
+  const size_t kSampled = 8;
+  vector<char> seen(V);
+  vector<int> stack, visited;
+  for (int s : sources) {
+    DepthFirstDirectedPaths own(G, s);
+    DepthFirstDirectedPaths shared(G, s, workspace);
+    stack.assign(1, s);
+    seen[s] = 1;
+    while (!stack.empty()) {
+      int v = stack.back();
+      stack.pop_back();
+      visited.push_back(v);
+      agree = agree && own.hasPathTo(v) && shared.hasPathTo(v);
+      for (int w : G.Adj(v)) {
+        if (!seen[w]) {
+          seen[w] = 1;
+          stack.push_back(w);
+        }
+      }
+    }
+    size_t sampled = std::min(kSampled, visited.size());
+    for (size_t i = 0; i < sampled; i++) {
+      int v = visited[i * visited.size() / sampled];
+      agree = agree && own.pathTo(v) == shared.pathTo(v);
+    }
+    for (int v : visited)
+      seen[v] = 0;
+    visited.clear();
+  }
+
+  // the distances to the out-neighbors of the source
+  vector<double> distances;
+  fresh = time([&](int s) {
+    DijkstraSP sp(H, s);
+    double max = 0.0;
+    for (int e : H.Adj(s))
+      max = std::max(max, sp.distTo(H.to(e)));
+    distances.push_back(max);
+  });
+  k = 0;
+  borrowed = time([&](int s) {
+    DijkstraSP sp(H, s, paths);
+    double max = 0.0;
+    for (int e : H.Adj(s))
+      max = std::max(max, sp.distTo(H.to(e)));
+    agree = agree && max == distances[k++];
+  });
+  report("DijkstraSP (fresh scans E)", fresh, borrowed);
+
+  // a borrowed BellmanFordSP agrees with a fresh one, on the digraph and on
+  // the same digraph with every weight lowered by 0.5, which has negative
+  // cycles; the workspace is shared with DijkstraSP, so it starts out full
+  EdgeWeightedDigraph N(V);
+  for (int e = 0; e < H.E(); e++)
+    N.AddEdge(H.from(e), H.to(e), H.weight(e) - 0.5);
+  auto same = [&](const auto& G, const auto& own, const auto& shared) {
+    if (own.HasNegativeCycle() != shared.HasNegativeCycle()) return false;
+    if (own.HasNegativeCycle()) {
+      std::stack<DirectedEdge> a = own.NegativeCycle(), b = shared.NegativeCycle();
+      for (; !a.empty() && !b.empty(); a.pop(), b.pop()) {
+        if (a.top().from() != b.top().from() || a.top().to() != b.top().to()) return false;
+      }
+      return a.empty() && b.empty();
+    }
+    for (int v = 0; v < G.V(); v++) {
+      if (own.HasPathTo(v) != shared.HasPathTo(v)) return false;
+      if (own.HasPathTo(v) && own.distTo(v) != shared.distTo(v)) return false;
+    }
+    return true;
+  };
+  // a fresh search takes time proportional to V, so only a few are compared
+  int compared = std::min(queries, 20), cycles = 0;
+  for (int k = 0; k < compared; k++) {
+    int s = sources[k];
+    BellmanFordSP own(H, s), shared(H, s, paths);
+    agree = agree && same(H, own, shared);
+    BellmanFordSP own_negative(N, s), shared_negative(N, s, paths);
+    agree = agree && same(N, own_negative, shared_negative);
+    cycles += own_negative.HasNegativeCycle();
+  }
+  printf("BellmanFordSP              %d sources, %d with a reachable negative cycle\n",
+         compared, cycles);
+
+  printf("%.1f vertices reached per search, searches %s\n",
+         static_cast<double>(reached) / queries, agree ? "agree" : "differ");
+  return agree ? 0 : 1;
+}
+#endif
@@ -0,0 +1,184 @@
+#ifndef SEARCH_WORKSPACE_H_
+#define SEARCH_WORKSPACE_H_
+
+#include <algorithm>
+#include <any>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "index_min_priority_queue.h"
+
+/**
+ *  {@code EpochMarks} and {@code EpochArray} are per-vertex arrays that are
+ *  reset in constant time, and {@code SearchWorkspace} bundles the ones
+ *  that {@link DirectedDFS}, {@link DepthFirstDirectedPaths},
+ *  {@link DijkstraSP} and {@link BellmanFordSP} need, along with the stack
+ *  of a {@link DepthFirstTraversal}.
+ *  <p>
+ *  Each entry carries the <em>epoch</em> in which it was last written, and
+ *  {@code Reset} starts a new epoch, so every entry written before reads
+ *  as unset again without being touched. The arrays grow, and are cleared
+ *  for real, only when a reset asks for more entries than they hold or
+ *  when the 32-bit epoch wraps around, once every 2<sup>32</sup> resets.
+ *  <p>
+ *  A search constructed with a workspace keeps its results in it, so a
+ *  search from a vertex that reaches few others takes time proportional to
+ *  the vertices and edges it touches, however large the digraph; a
+ *  workspace holds the results of the last search that borrowed it, and
+ *  only one search may use it at a time.
+ */
+
+namespace algs4 {
+
+/**
+ * A set of the integers 0 to <em>n</em> - 1, emptied in constant time.
+ */
+class EpochMarks {
+public:
+  // marked[v] = true, as for a vector<bool>
+  class Reference {
+  public:
+    Reference(EpochMarks& marks, int v) : marks_(marks), v_(v) {}
+    operator bool() const { return std::as_const(marks_)[v_]; }
+    Reference &operator=(bool marked) {
+      if (marked) marks_.Mark(v_);
+      else        marks_.Unmark(v_);
+      return *this;
+    }
+
+  private:
+    EpochMarks& marks_;
+    int v_;
+  };
+
+  EpochMarks() = default;
+  EpochMarks(const EpochMarks& other) = default;
+  EpochMarks &operator=(const EpochMarks& other) = default;
+  EpochMarks(EpochMarks&& other) = default;
+  EpochMarks &operator=(EpochMarks&& other) = default;
+
+  /**
+   * Empties the set, and makes room for the integers 0 to {@code n} - 1.
+   * @param n the number of integers
+   */
+  void Reset(int n) {
+    n_ = n;
+    if (stamps_.size() < static_cast<size_t>(n))
+      stamps_.resize(n);
+    if (++epoch_ == 0) {
+      std::fill(stamps_.begin(), stamps_.end(), 0);
+      epoch_ = 1;
+    }
+  }
+  /**
+   * Returns the number of integers, as of the last {@code Reset}.
+   * @return the number of integers
+   */
+  int size() const { return n_; }
+
+  bool operator[](int v) const { return stamps_[v] == epoch_; }
+  Reference operator[](int v) { return Reference(*this, v); }
+  void Mark(int v) { stamps_[v] = epoch_; }
+  void Unmark(int v) { stamps_[v] = 0; }
+
+private:
+  std::vector<unsigned> stamps_;  // stamps_[v] = epoch_ iff v is marked
+  unsigned epoch_{0};             // the epoch of the last Reset
+  int n_{0};                      // the number of integers
+};
+
+/**
+ * An array of <em>n</em> values that all return to a fill value in
+ * constant time.
+ */
+template <typename T>
+class EpochArray {
+public:
+  /**
+   * Initializes an empty array whose entries read as {@code fill} until set.
+   * @param fill the value of an entry not set since the last {@code Reset}
+   */
+  explicit EpochArray(T fill) : fill_(fill) {}
+  EpochArray() = delete;
+  EpochArray(const EpochArray& other) = default;
+  EpochArray &operator=(const EpochArray& other) = default;
+  EpochArray(EpochArray&& other) = default;
+  EpochArray &operator=(EpochArray&& other) = default;
+
+  /**
+   * Sets every entry back to the fill value, and makes room for
+   * {@code n} entries.
+   * @param n the number of entries
+   */
+  void Reset(int n) {
+    n_ = n;
+    if (slots_.size() < static_cast<size_t>(n))
+      slots_.resize(n);
+    if (++epoch_ == 0) {
+      for (Slot& slot : slots_)
+        slot.stamp = 0;
+      epoch_ = 1;
+    }
+  }
+  /**
+   * Returns the number of entries, as of the last {@code Reset}.
+   * @return the number of entries
+   */
+  int size() const { return n_; }
+
+  T operator[](int i) const { return slots_[i].stamp == epoch_ ? slots_[i].value : fill_; }
+  void Set(int i, T value) { slots_[i] = Slot{epoch_, value}; }
+
+private:
+  // the value sits next to its stamp, so a read touches one cache line
+  struct Slot {
+    unsigned stamp{0};
+    T value{};
+  };
+
+  std::vector<Slot> slots_;
+  unsigned epoch_{0};   // the epoch of the last Reset
+  int n_{0};            // the number of entries
+  T fill_;              // the value of an entry not set in this epoch
+};
+
+/**
+ * The per-vertex state of a graph search, kept from one search to the
+ * next. A search resets only the parts it uses, so a workspace that only
+ * ever serves {@code DirectedDFS} holds a stamp per vertex and nothing more.
+ */
+struct SearchWorkspace {
+  EpochMarks marked;                      // marked[v] = has v been reached (or queued)?
+  EpochArray<int> edgeTo{-1};             // edgeTo[v] = last edge on path to v
+  EpochArray<double> distTo{std::numeric_limits<double>::max()};  // distTo[v] = length of path to v
+  EpochArray<int> label{-1};              // label[v] = scratch label of v
+  // the vertices to relax; a finished search leaves it empty, so it is
+  // allocated once and never cleared
+  std::optional<IndexMinPriorityQueue<double>> pq;
+  int pq_capacity{0};                     // the capacity of pq
+  // the frame stack of a DepthFirstTraversal, a std::vector whose type
+  // depends on the digraph; a finished search leaves it empty
+  std::any frames;
+
+  /**
+   * Makes sure {@code pq} has room for the vertices 0 to {@code V} - 1,
+   * and is empty.
+   * @param V the number of vertices
+   * @return the priority queue
+   */
+  IndexMinPriorityQueue<double>& ResetQueue(int V) {
+    if (!pq || pq_capacity < V) {
+      pq.emplace(V, std::greater<double>());
+      pq_capacity = V;
+    }
+    while (!pq->IsEmpty())
+      pq->DelMin();
+    return *pq;
+  }
+};
+}
+
+#endif  // SEARCH_WORKSPACE_H_
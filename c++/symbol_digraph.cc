@@ -1,8 +1,9 @@
 /******************************************************************************
  *  Compilation:  clang++ -c -O2 digraph.cc -std=c++20
- *                clang++ -DDebug -O2 symbol_digraph.cc digraph.o -std=c++20 -o symbol_digraph
+ *                clang++ -c -O2 mapped_file.cc -std=c++20
+ *                clang++ -DDebug -O2 symbol_digraph.cc digraph.o mapped_file.o -std=c++20 -pthread -o symbol_digraph
  *  Execution:    ./symbol_digraph routes.txt
- *  Dependencies: digraph.h
+ *  Dependencies: digraph.h mapped_file.h
  *  Data files:   https://algs4.cs.princeton.edu/42digraph/routes.txt
  *  
  *  %  ./symbol_digraph routes.txt
@@ -19,17 +20,22 @@
 
 #include "symbol_digraph.h"
 
-#include <fstream>
 #include <exception>
+#include <functional>
+#include <utility>
 
-#include "digraph.h"
+#include "mapped_file.h"
 
-using std::map;
 using std::vector;
 using std::string;
-using std::fstream;
+using std::string_view;
 
 namespace algs4 {
+namespace {
+// the initial number of slots of the hash index, a power of 2
+constexpr size_t kInitialSlots = 1 << 10;
+}
+
 /**
  *  The {@code SymbolDigraph} class represents a digraph, where the
  *  vertex names are arbitrary strings.
@@ -39,12 +45,13 @@ namespace algs4 {
  *  between 0 and <em>V</em> - 1.
  *  It also supports initializing a symbol digraph from a file.
  *  <p>
- *  This implementation uses an {@link ST} to map from strings to integers,
- *  an array to map from integers to strings, and a {@link Digraph} to store
- *  the underlying graph.
- *  The <em>indexOf</em> and <em>contains</em> operations take time 
- *  proportional to log <em>V</em>, where <em>V</em> is the number of vertices.
- *  The <em>nameOf</em> operation takes constant time.
+ *  This implementation reads the file once. The names are interned into a
+ *  single contiguous arena, in order of first appearance, and indexed by an
+ *  open-addressing hash table of vertex ids; the edges are buffered as pairs
+ *  of ids and added to the {@link Digraph} in bulk at the end.
+ *  The <em>indexOf</em> and <em>contains</em> operations take expected
+ *  constant time (plus the length of the name) and the <em>nameOf</em>
+ *  operation takes constant time; none of them allocates memory.
  *  <p>
  *  For additional documentation, see <a href="https://algs4.cs.princeton.edu/42digraph">Section 4.2</a> of
  *  <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
@@ -60,64 +67,71 @@ namespace algs4 {
  * of the vertices adjacent to that vertex, separated by the delimiter.
  * @param filename the name of the file
  * @param delimiter the delimiter between fields
+ * @throws std::runtime_error if the file cannot be read
+ * @throws IllegalArgumentException if the delimiter is empty
  */
-SymbolDigraph::SymbolDigraph(const string& filename, const string& delimiter) noexcept {
-  // First pass builds the index by reading strings to associate
-  // distinct strings with an index
-  fstream in(filename);
-  while (!in.eof()) {
-    string line;
-    std::getline(in, line);
-    if (line == "") break;
-
-    string::size_type pos = 0;
-    while (pos != string::npos) {
-      string::size_type new_pos = line.find(delimiter, pos);
-      string vertice;
-      if (new_pos != string::npos) {
-        vertice = line.substr(pos, new_pos - pos);
-        pos = new_pos + 1;
-      } else {
-        vertice = line.substr(pos);
-        pos = new_pos;
-      }
-      auto it = vertex_.find(vertice);
-      if (it == vertex_.end()) {
-        vertex_[vertice] = vertex_.size();
-        keys_.push_back(vertice);
-      }
+SymbolDigraph::SymbolDigraph(const string& filename, const string& delimiter) :
+  slots_(kInitialSlots, -1) {
+  if (delimiter.empty()) throw std::invalid_argument("the delimiter must not be empty");
+
+  // a single pass interns the names straight from the mapped file and
+  // buffers the edges as pairs of ids
+  MappedFile file(filename);
+  string_view text = file.view();
+  vector<std::pair<int, int>> edges;
+  while (!text.empty()) {
+    string_view::size_type eol = text.find('\n');
+    string_view line = text.substr(0, eol);
+    text = eol == string_view::npos ? string_view() : text.substr(eol + 1);
+    if (line.empty()) continue;
+
+    string_view::size_type pos = line.find(delimiter);
+    int v = Intern(line.substr(0, pos));
+    while (pos != string_view::npos) {
+      line.remove_prefix(pos + delimiter.size());
+      pos = line.find(delimiter);
+      edges.emplace_back(v, Intern(line.substr(0, pos)));
     }
   }
 
-  // second pass builds the digraph by connecting first vertex on each
-  // line to all others
-  graph_ = new Digraph(vertex_.size());
-  fstream in2(filename);
-  while (!in2.eof()) {
-    string line;
-    std::getline(in2, line);
-
-    string::size_type pos = line.find(delimiter);
-    if (pos == string::npos) continue;
-    int v = vertex_[line.substr(0, pos)];
-    ++pos;
-    while (true) {
-      string::size_type new_pos = line.find(delimiter, pos);
-      if (new_pos != string::npos) {
-        graph_->AddEdge(v, vertex_[line.substr(pos, new_pos - pos)]);
-        pos = new_pos + 1;
-      } else {
-        string w = line.substr(pos);
-        graph_->AddEdge(v, vertex_[line.substr(pos)]);
-        break;
-      }
-    }
+  graph_ = Digraph(static_cast<int>(offsets_.size()) - 1);
+  graph_.AddEdges(edges);
+}
+
+// the slot of slots_ holding the vertex named s, or the empty slot where it
+// belongs; slots_ is a power of 2 in size and at most half full
+size_t SymbolDigraph::Slot(string_view s) const {
+  size_t mask = slots_.size() - 1;
+  size_t i = std::hash<string_view>()(s) & mask;
+  while (slots_[i] >= 0 && Key(slots_[i]) != s)
+    i = (i + 1) & mask;
+
+  return i;
+}
+
+// the id of the vertex named s, adding it to the arena and the index if it is new
+int SymbolDigraph::Intern(string_view s) {
+  size_t i = Slot(s);
+  if (slots_[i] >= 0) return slots_[i];
+
+  int v = static_cast<int>(offsets_.size()) - 1;
+  names_.append(s);
+  offsets_.push_back(names_.size());
+  if (2 * offsets_.size() > slots_.size()) {
+    // double the index and reinsert every vertex
+    slots_.assign(2 * slots_.size(), -1);
+    for (int w = 0; w < v; w++)
+      slots_[Slot(Key(w))] = w;
+    i = Slot(s);
   }
+  slots_[i] = v;
+
+  return v;
 }
 
 // throw an IllegalArgumentException unless {@code 0 <= v < V}
 void SymbolDigraph::ValidateVertex(int v) const {
-  int V = graph_->V();
+  int V = graph_.V();
   if (v < 0 || v >= V)
     throw std::invalid_argument("vertex " + std::to_string(v) + 
                                 " is not between 0 and " + std::to_string(V-1));
@@ -131,19 +145,19 @@ void SymbolDigraph::ValidateVertex(int v) const {
  */
 #ifdef Debug
 #include <iostream>
-#include <cstdio>
-#include <algorithm>
 using namespace algs4;
 int main(int argc, char *argv[]) {
   string delimiter{" "};
   if (argc > 2) delimiter = argv[2];
   SymbolDigraph sg(argv[1], delimiter);
-  Digraph* graph = sg.digraph();
+  const Digraph* graph = sg.digraph();
   string t;
-  auto print = [&](const int& n) { std::cout << "    " << sg.Name(n) << std::endl; };
-  while (std::cin >> t) {
-    vector<int> array = graph->adj(sg.Index(t));
-    std::for_each(array.cbegin(), array.cend(), print);
+  while (std::getline(std::cin, t)) {
+    int s = sg.Index(t);
+    if (s < 0) continue;
+    std::cout << t << std::endl;
+    for (int v : graph->Adj(s))
+      std::cout << "    " << sg.Name(v) << std::endl;
   }
 }
 #endif
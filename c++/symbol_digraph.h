@@ -10,12 +10,13 @@
  *  between 0 and <em>V</em> - 1.
  *  It also supports initializing a symbol digraph from a file.
  *  <p>
- *  This implementation uses an {@link ST} to map from strings to integers,
- *  an array to map from integers to strings, and a {@link Digraph} to store
- *  the underlying graph.
- *  The <em>indexOf</em> and <em>contains</em> operations take time 
- *  proportional to log <em>V</em>, where <em>V</em> is the number of vertices.
- *  The <em>nameOf</em> operation takes constant time.
+ *  This implementation reads the file once. The names are interned into a
+ *  single contiguous arena, in order of first appearance, and indexed by an
+ *  open-addressing hash table of vertex ids; the edges are buffered as pairs
+ *  of ids and added to the {@link Digraph} in bulk at the end.
+ *  The <em>indexOf</em> and <em>contains</em> operations take expected
+ *  constant time (plus the length of the name) and the <em>nameOf</em>
+ *  operation takes constant time; none of them allocates memory.
  *  <p>
  *  For additional documentation, see <a href="https://algs4.cs.princeton.edu/42digraph">Section 4.2</a> of
  *  <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
@@ -24,13 +25,14 @@
  *  @author Kevin Wayne
  */
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <map>
 
-namespace algs4 {
+#include "digraph.h"
 
-class Digraph;
+namespace algs4 {
 
 class SymbolDigraph {
 public:
@@ -41,8 +43,10 @@ public:
    * of the vertices adjacent to that vertex, separated by the delimiter.
    * @param filename the name of the file
    * @param delimiter the delimiter between fields
+   * @throws std::runtime_error if the file cannot be read
+   * @throws IllegalArgumentException if the delimiter is empty
    */
-  SymbolDigraph(const std::string& filename, const std::string& delimiter) noexcept;
+  SymbolDigraph(const std::string& filename, const std::string& delimiter);
   SymbolDigraph() = delete;
   SymbolDigraph(const SymbolDigraph& other) = delete;
   SymbolDigraph &operator=(const SymbolDigraph& other) = delete;
@@ -53,65 +57,75 @@ public:
    * @param s the name of a vertex
    * @return {@code true} if {@code s} is the name of a vertex, and {@code false} otherwise
    */
-  bool Contains(const std::string& s) const { return vertex_.find(s) != vertex_.end(); }
+  bool Contains(std::string_view s) const { return Find(s) >= 0; }
   /**
    * Returns the integer associated with the vertex named {@code s}.
    * @param s the name of a vertex
-   * @return the integer (between 0 and <em>V</em> - 1) associated with the vertex named {@code s}
+   * @return the integer (between 0 and <em>V</em> - 1) associated with the vertex named {@code s},
+   *         or -1 if there is no such vertex
    * @deprecated Replaced by {@link #indexOf(String)}.
    */
-  int Index(const std::string& s) { return vertex_[s]; }
+  int Index(std::string_view s) const { return Find(s); }
   /**
    * Returns the integer associated with the vertex named {@code s}.
    * @param s the name of a vertex
-   * @return the integer (between 0 and <em>V</em> - 1) associated with the vertex named {@code s}
+   * @return the integer (between 0 and <em>V</em> - 1) associated with the vertex named {@code s},
+   *         or -1 if there is no such vertex
    */
-  int IndexOf(const std::string& s) { return vertex_[s]; }
+  int IndexOf(std::string_view s) const { return Find(s); }
   /**
    * Returns the name of the vertex associated with the integer {@code v}.
    * @param  v the integer corresponding to a vertex (between 0 and <em>V</em> - 1) 
-   * @return the name of the vertex associated with the integer {@code v}
+   * @return the name of the vertex associated with the integer {@code v},
+   *         as a view into the name arena of this symbol digraph
    * @throws IllegalArgumentException unless {@code 0 <= v < V}
    * @deprecated Replaced by {@link #nameOf(int)}.
    */
-  std::string Name(int v) const { 
-    ValidateVertex(v);
-    return keys_[v];
-  }
+  std::string_view Name(int v) const { return NameOf(v); }
   /**
    * Returns the name of the vertex associated with the integer {@code v}.
    * @param  v the integer corresponding to a vertex (between 0 and <em>V</em> - 1) 
-   * @return the name of the vertex associated with the integer {@code v}
+   * @return the name of the vertex associated with the integer {@code v},
+   *         as a view into the name arena of this symbol digraph
    * @throws IllegalArgumentException unless {@code 0 <= v < V}
    */
-  std::string NameOf(int v) const {
+  std::string_view NameOf(int v) const {
     ValidateVertex(v);
-    return keys_[v];
+    return Key(v);
   }
 
   /**
-   * Returns the digraph assoicated with the symbol graph. It is the client's responsibility
-   * not to mutate the digraph.
+   * Returns the digraph assoicated with the symbol graph.
    *
    * @return the digraph associated with the symbol digraph
    * @deprecated Replaced by {@link #digraph()}.
    */
-  Digraph* G() const { return graph_; }
+  const Digraph* G() const { return &graph_; }
   /**
-   * Returns the digraph assoicated with the symbol graph. It is the client's responsibility
-   * not to mutate the digraph.
+   * Returns the digraph assoicated with the symbol graph.
    *
    * @return the digraph associated with the symbol digraph
    */
-  Digraph* digraph() const { return graph_; }
+  const Digraph* digraph() const { return &graph_; }
 private:
   // throw an IllegalArgumentException unless {@code 0 <= v < V}
   void ValidateVertex(int v) const;
+  // the name of vertex v, not validated
+  std::string_view Key(int v) const {
+    return std::string_view(names_).substr(offsets_[v], offsets_[v + 1] - offsets_[v]);
+  }
+  // the slot of slots_ holding the vertex named s, or the empty slot where it belongs
+  size_t Slot(std::string_view s) const;
+  // the id of the vertex named s, or -1 if there is none
+  int Find(std::string_view s) const { return slots_[Slot(s)]; }
+  // the id of the vertex named s, adding it to the arena and the index if it is new
+  int Intern(std::string_view s);
 
 private:
-  std::map<std::string, int> vertex_;  // string -> index
-  std::vector<std::string> keys_;           // index  -> string
-  Digraph* graph_;           // the underlying digraph
+  std::string names_;                // the names of all vertices, concatenated in order of id
+  std::vector<size_t> offsets_{0};   // name of v = names_[offsets_[v]..offsets_[v+1])
+  std::vector<int> slots_;           // open-addressing hash index of vertex ids, -1 if empty
+  Digraph graph_{0};                 // the underlying digraph
 };
 }
 
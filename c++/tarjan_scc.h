@@ -0,0 +1,205 @@
+#ifndef TARJAN_SCC_H_
+#define TARJAN_SCC_H_
+
+/**
+ *  The {@code TarjanSCC} class represents a data type for
+ *  determining the strong components in a digraph.
+ *  The <em>id</em> operation determines in which strong component
+ *  a given vertex lies; the <em>areStronglyConnected</em> operation
+ *  determines whether two vertices are in the same strong component;
+ *  and the <em>count</em> operation determines the number of strong
+ *  components.
+ *  <p>
+ *  The <em>component identifier</em> of a component is an integer between
+ *  0 and <em>count</em> - 1: two vertices have the same component
+ *  identifier if and only if they are in the same strong component. The
+ *  components are numbered in reverse topological order: an edge between
+ *  two components goes from the higher identifier to the lower one.
+ *  <p>
+ *  This implementation uses Pearce's space-efficient variant of Tarjan's
+ *  algorithm, on the iterative {@link DepthFirstTraversal}. A single array
+ *  holds the rank of each vertex in preorder, lowered to the smallest rank
+ *  it reaches while the vertex is on the search path, and then its
+ *  component; a single stack holds the vertices whose component is not yet
+ *  known. All the workspace, O(<em>V</em>), is allocated once, up front,
+ *  and the search has no depth limit.
+ *  The constructor takes &Theta;(<em>V</em> + <em>E</em>) time,
+ *  where <em>V</em> is the number of vertices and <em>E</em>
+ *  is the number of edges.
+ *  Each instance method takes &Theta;(1) time, except
+ *  {@code Condensation}, which takes &Theta;(<em>V</em> + <em>E</em>) time.
+ *  For an alternative implementation of the same API, see
+ *  {@link KosarajuSharirSCC}.
+ *  <p>
+ *  For additional documentation, see
+ *  <a href="https://algs4.cs.princeton.edu/42digraph">Section 4.2</a> of
+ *  <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
+ *
+ *  @author Robert Sedgewick
+ *  @author Kevin Wayne
+ */
+
+#include <utility>
+#include <vector>
+
+#include "compact_digraph.h"
+#include "depth_first_traversal.h"
+#include "graph_concepts.h"
+
+namespace algs4 {
+
+class TarjanSCC {
+public:
+  /**
+   * Computes the strong components of the digraph {@code G}, which may be
+   * any adjacency digraph or edge-weighted digraph.
+   * @param G the digraph
+   */
+  template <DirectedGraph Graph>
+  TarjanSCC(const Graph& G) : id_(G.V()) {
+    int V = G.V();
+    std::vector<bool> marked(V);
+    std::vector<bool> root(V);
+    std::vector<int> stack;
+    stack.reserve(V);
+
+    // rank[v] runs from 0 up for the vertices on the search path and the
+    // stack, and component c is numbered V - 1 - c, so that a finished
+    // vertex never lowers the rank of an unfinished one
+    struct Visitor {
+      std::vector<int>& rank;
+      std::vector<bool>& root;
+      std::vector<int>& stack;
+      int next;
+      int component;
+
+      void PreVisit(int v) {
+        rank[v] = next++;
+        root[v] = true;
+      }
+      void Lower(int v, int w) {
+        if (rank[w] < rank[v]) {
+          rank[v] = rank[w];
+          root[v] = false;
+        }
+      }
+      void NonTreeEdge(int v, int w, int) { Lower(v, w); }
+      void Backtrack(int v, int w, int) { Lower(v, w); }
+      void PostVisit(int v) {
+        if (!root[v]) {
+          stack.push_back(v);
+          return;
+        }
+        // v is the root of a component: pop the rest of it
+        next--;
+        while (!stack.empty() && rank[v] <= rank[stack.back()]) {
+          rank[stack.back()] = component;
+          stack.pop_back();
+          next--;
+        }
+        rank[v] = component--;
+      }
+    };
+    Visitor visitor{id_, root, stack, 0, V - 1};
+    DepthFirstTraversal<Graph> dfs(G);
+    for (int v = 0; v < V; v++)
+      if (!marked[v]) dfs.Run(v, marked, visitor);
+
+    count_ = V - 1 - visitor.component;
+    for (int& id : id_)
+      id = V - 1 - id;
+  }
+  TarjanSCC() = delete;
+  TarjanSCC(const TarjanSCC& other) = default;
+  TarjanSCC &operator=(const TarjanSCC& other) = default;
+  TarjanSCC(TarjanSCC&& other) = default;
+  TarjanSCC &operator=(TarjanSCC&& other) = default;
+
+  /**
+   * Returns the number of strong components.
+   * @return the number of strong components
+   */
+  int count() const { return count_; }
+
+  /**
+   * Are vertices {@code v} and {@code w} in the same strong component?
+   * @param  v one vertex
+   * @param  w the other vertex
+   * @return {@code true} if vertices {@code v} and {@code w} are in the same
+   *         strong component, and {@code false} otherwise
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   * @throws IllegalArgumentException unless {@code 0 <= w < V}
+   */
+  bool StronglyConnected(int v, int w) const;
+
+  /**
+   * Returns the component id of the strong component containing vertex {@code v}.
+   * @param  v the vertex
+   * @return the component id of the strong component containing vertex {@code v}
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   */
+  int id(int v) const;
+
+  /**
+   * Returns the condensation of the digraph {@code G} the components were
+   * computed for: the DAG with a vertex per strong component and an edge
+   * from component <em>a</em> to component <em>b</em> if some edge of
+   * {@code G} leads from <em>a</em> to <em>b</em>. The adjacency list of a
+   * component has no duplicates, in the order the edges leaving its
+   * vertices are met, taking the vertices in increasing order.
+   * @param  G the digraph
+   * @return the condensation of {@code G}, in compressed sparse row form
+   * @throws IllegalArgumentException unless {@code G} has <em>V</em> vertices
+   */
+  template <DirectedGraph Graph>
+  CompactDigraph Condensation(const Graph& G) const {
+    ValidateGraph(G.V());
+    int V = G.V();
+
+    // the vertices grouped by component
+    std::vector<int> first(count_ + 1);
+    for (int v = 0; v < V; v++)
+      ++first[id_[v] + 1];
+    for (int c = 0; c < count_; c++)
+      first[c + 1] += first[c];
+    std::vector<int> vertices(V);
+    {
+      std::vector<int> next(first.cbegin(), first.cend() - 1);
+      for (int v = 0; v < V; v++)
+        vertices[next[id_[v]]++] = v;
+    }
+
+    // the distinct components reached from each component; seen[d] == c
+    // once the edge c->d is recorded
+    std::vector<int> offsets(count_ + 1);
+    std::vector<int> targets;
+    std::vector<int> seen(count_, -1);
+    for (int c = 0; c < count_; c++) {
+      seen[c] = c;
+      for (int i = first[c]; i < first[c + 1]; i++) {
+        for (int w : Heads(G, vertices[i])) {
+          int d = id_[w];
+          if (seen[d] == c) continue;
+          seen[d] = c;
+          targets.push_back(d);
+        }
+      }
+      offsets[c + 1] = static_cast<int>(targets.size());
+    }
+
+    return CompactDigraph(count_, std::move(offsets), std::move(targets));
+  }
+
+private:
+  // throw an IllegalArgumentException unless {@code 0 <= v < V}
+  void ValidateVertex(int v) const;
+  // throw an IllegalArgumentException unless {@code V} is the number of vertices
+  void ValidateGraph(int V) const;
+
+private:
+  std::vector<int> id_;     // id_[v] = id of strong component containing v
+  int count_{0};            // number of strongly-connected components
+};
+}
+
+#endif  // TARJAN_SCC_H_
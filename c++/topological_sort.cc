@@ -1,15 +1,15 @@
 /******************************************************************************
  *  Compilation:  clang++ -c -O2 digraph.cc -std=c++20
+ *                clang++ -c -O2 compact_digraph.cc -std=c++20
  *                clang++ -c -O2 directed_edge.cc -std=c++20
  *                clang++ -c -O2 edge_weighted_digraph.cc -std=c++20
  *                clang++ -c -O2 depth_first_order.cc -std=c++20
- *                clang++ -c -O2 directed_cycle.cc -std=c++20
- *                clang++ -c -O2 edge_weighted_directed_cycle.cc -std=c++20
+ *                clang++ -c -O2 mapped_file.cc -std=c++20
  *                clang++ -c -O2 symbol_digraph.cc -std=c++20
- *                clang++ -DDebug -O2 topological_sort.cc digraph.o directed_edge.o edge_weighted_digraph.o depth_first_order.o directed_cycle.o edge_weighted_directed_cycle.o symbol_digraph.o -std=c++20 -o topological_sort
+ *                clang++ -DDebug -O2 topological_sort.cc digraph.o compact_digraph.o directed_edge.o edge_weighted_digraph.o depth_first_order.o mapped_file.o symbol_digraph.o -std=c++20 -pthread -o topological_sort
  *  Execution:    ./topological filename.txt delimiter
- *  Dependencies: digraph.h depth_first_order.h directed_cycle.h
- *                depth_first_order.h edge_weighted_directed_cycle.h
+ *  Dependencies: digraph.h compact_digraph.h depth_first_order.h
+ *                graph_concepts.h
  *                symbol_digraph.h
  *  Data files:   https://algs4.cs.princeton.edu/42digraph/jobs.txt
  *
@@ -53,6 +53,8 @@
  *  directed cycle if the digraph is not a DAG.
  *  See {@link TopologicalX} for a nonrecursive queue-based algorithm
  *  to compute a topological order of a DAG.
+ *  See {@link IncrementalTopological} to keep a topological order up to date
+ *  as edges are added one at a time, rejecting those that close a cycle.
  *  <p>
  *  For additional documentation,
  *  see <a href="https://algs4.cs.princeton.edu/42digraph">Section 4.2</a> of
@@ -66,10 +68,8 @@
 
 #include <exception>
 
-#include "directed_cycle.h"
-#include "depth_first_order.h"
+#include "digraph.h"
 #include "symbol_digraph.h"
-#include "edge_weighted_directed_cycle.h"
 
 using std::vector;
 using std::string;
@@ -80,40 +80,6 @@ namespace algs4 {
  * finds such a topological order.
  * @param G the digraph
  */
-Topological::Topological(const Digraph& G) noexcept {
-  DirectedCycle finder(G);
-  if (!finder.HasCycle()) {
-    DepthFirstOrder dfs(G);
-    order_ = dfs.ReversePost();
-    rank_.resize(G.V());
-    int i = 0;
-    for (int v : order_)
-      rank_[v] = i++;
-  }
-}
-
-/**
- * Determines whether the edge-weighted digraph {@code G} has a topological
- * order and, if so, finds such an order.
- * @param G the edge-weighted digraph
- */
-Topological::Topological(const EdgeWeightedDigraph& G) noexcept {
-  EdgeWeightedDirectedCycle finder(G);
-  if (!finder.HasCycle()) {
-    DepthFirstOrder dfs(G);
-    order_ = dfs.ReversePost();
-  }
-}
-
-/**
- * The the rank of vertex {@code v} in the topological order;
- * -1 if the digraph is not a DAG
- *
- * @param v the vertex
- * @return the position of vertex {@code v} in a topological order
- *    of the digraph; -1 if the digraph is not a DAG
- * @throws IllegalArgumentException unless {@code 0 <= v < V}
- */
 int Topological::rank(int v) const {
   ValidateVertex(v);
   if (HasOrder()) return rank_[v];
@@ -143,7 +109,7 @@ int main(int argc, char *argv[]) {
   SymbolDigraph sg(argv[1], delimiter);
   Topological topological(*sg.digraph());
   for (int v : topological.order()) {
-    printf("%s\n", sg.nameOf(v).c_str());
+    printf("%s\n", string(sg.NameOf(v)).c_str());
   }
 }
 #endif
@@ -18,6 +18,8 @@
  *  directed cycle if the digraph is not a DAG.
  *  See {@link TopologicalX} for a nonrecursive queue-based algorithm
  *  to compute a topological order of a DAG.
+ *  See {@link IncrementalTopological} to keep a topological order up to date
+ *  as edges are added one at a time, rejecting those that close a cycle.
  *  <p>
  *  For additional documentation,
  *  see <a href="https://algs4.cs.princeton.edu/42digraph">Section 4.2</a> of
@@ -32,24 +34,37 @@
 
 #include <vector>
 
-#include "digraph.h"
-#include "edge_weighted_digraph.h"
+#include "depth_first_order.h"
+#include "graph_concepts.h"
 
 namespace algs4 {
 class Topological {
 public:
   /**
    * Determines whether the digraph {@code G} has a topological order and, if so,
-   * finds such a topological order.
+   * finds such a topological order. {@code G} may be any adjacency digraph or
+   * edge-weighted digraph.
    * @param G the digraph
    */
-  Topological(const Digraph& G) noexcept;
-  /**
-   * Determines whether the edge-weighted digraph {@code G} has a topological
-   * order and, if so, finds such an order.
-   * @param G the edge-weighted digraph
-   */
-  Topological(const EdgeWeightedDigraph& G) noexcept;
+  template <DirectedGraph Graph>
+  Topological(const Graph& G) {
+    // a reverse postorder is a topological order if and only if G is a DAG,
+    // so check every edge against it instead of running a separate cycle search
+    DepthFirstOrder dfs(G);
+    order_ = dfs.ReversePost();
+    rank_.resize(G.V());
+    int i = 0;
+    for (int v : order_)
+      rank_[v] = i++;
+    for (int v = 0; v < G.V(); v++) {
+      for (int w : Heads(G, v)) {
+        if (rank_[v] >= rank_[w]) {
+          order_.clear();
+          return;
+        }
+      }
+    }
+  }
   Topological() = delete;
   Topological(const Topological& other) = default;
   Topological &operator=(const Topological& other) = default;
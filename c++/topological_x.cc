@@ -0,0 +1,176 @@
+/******************************************************************************
+ *  Compilation:  clang++ -c -O2 digraph.cc -std=c++20
+ *                clang++ -c -O2 compact_digraph.cc -std=c++20
+ *                clang++ -c -O2 depth_first_order.cc -std=c++20
+ *                clang++ -c -O2 topological_sort.cc -std=c++20
+ *                clang++ -c -O2 mapped_file.cc -std=c++20
+ *                clang++ -c -O2 symbol_digraph.cc -std=c++20
+ *                clang++ -c -O2 directed_edge.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_digraph.cc -std=c++20
+ *                clang++ -c -O2 edge.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_graph.cc -std=c++20
+ *                clang++ -c -O2 graph_generator.cc -std=c++20
+ *                clang++ -DDebug -O2 topological_x.cc digraph.o compact_digraph.o depth_first_order.o topological_sort.o mapped_file.o symbol_digraph.o directed_edge.o edge_weighted_digraph.o edge.o edge_weighted_graph.o graph_generator.o -std=c++20 -pthread -o topological_x
+ *  Execution:    ./topological_x filename.txt delimiter
+ *                ./topological_x V E seed [threads]
+ *  Dependencies: digraph.h compact_digraph.h graph_concepts.h parallel.h
+ *                symbol_digraph.h topological_sort.h graph_generator.h
+ *  Data files:   https://algs4.cs.princeton.edu/42digraph/jobs.txt
+ *
+ *  Compute topological ordering of a DAG, level by level, using a
+ *  queue-based algorithm. Runs in O(E + V) time.
+ *
+ *  % ./topological_x jobs.txt "/"
+ *  level 0: Introduction to CS; Calculus;
+ *  level 1: Algorithms; Advanced Programming; Linear Algebra;
+ *  level 2: Theoretical CS; Databases; Scientific Computing;
+ *  level 3: Computational Biology; Artificial Intelligence;
+ *  level 4: Robotics; Machine Learning;
+ *  level 5: Neural Networks;
+ *
+ *  % ./topological_x 2000000 8000000 1
+ *  random DAG: 2000000 vertices, 7999987 edges
+ *  Topological               519.3 ms
+ *  TopologicalX              242.4 ms, 1 threads, 28 levels, valid
+ *
+ ******************************************************************************/
+
+#include "topological_x.h"
+
+#include <stdexcept>
+#include <string>
+
+using std::to_string;
+
+namespace algs4 {
+void TopologicalX::Order(int levels) {
+  int V = level_.size();
+  first_.assign(levels + 1, 0);
+  for (int v = 0; v < V; v++)
+    ++first_[level_[v] + 1];
+  for (int l = 0; l < levels; l++)
+    first_[l + 1] += first_[l];
+
+  order_.resize(V);
+  rank_.resize(V);
+  std::vector<int> next(first_.cbegin(), first_.cend() - 1);
+  for (int v = 0; v < V; v++) {
+    rank_[v] = next[level_[v]]++;
+    order_[rank_[v]] = v;
+  }
+}
+
+int TopologicalX::rank(int v) const {
+  ValidateVertex(v);
+  if (HasOrder()) return rank_[v];
+  else            return -1;
+}
+
+int TopologicalX::level(int v) const {
+  ValidateVertex(v);
+  return level_[v];
+}
+
+std::span<const int> TopologicalX::Wavefront(int l) const {
+  if (l < 0 || l >= levels())
+    throw std::invalid_argument("level " + to_string(l) + " is not between 0 and " +
+                                to_string(levels() - 1));
+  return std::span<const int>(order_).subspan(first_[l], first_[l + 1] - first_[l]);
+}
+
+void TopologicalX::ValidateVertex(int v) const {
+  int V = level_.size();
+  if (v < 0 || v >= V)
+    throw std::invalid_argument("vertex " + to_string(v) + " is not between 0 and " + to_string(V-1));
+}
+}
+
+/**
+ * Unit tests the {@code TopologicalX} data type.
+ *
+ * @param args the command-line arguments
+ */
+#ifdef Debug
+#include <chrono>
+#include <cstdio>
+
+#include "compact_digraph.h"
+#include "graph_generator.h"
+#include "symbol_digraph.h"
+#include "topological_sort.h"
+
+using namespace algs4;
+using std::string;
+using std::vector;
+using Clock = std::chrono::steady_clock;
+
+double MillisSince(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// is the level of each vertex one more than the largest level of the
+// vertices with an edge to it, and the order sorted by level?
+bool Check(const CompactDigraph& G, const TopologicalX& topological) {
+  vector<int> expected(G.V(), 0);
+  for (int v : topological.order())
+    for (int w : G.Adj(v))
+      expected[w] = std::max(expected[w], expected[v] + 1);
+  for (int v = 0; v < G.V(); v++)
+    if (topological.level(v) != expected[v]) return false;
+  for (int v = 0; v < G.V(); v++)
+    for (int w : G.Adj(v))
+      if (topological.rank(v) >= topological.rank(w)) return false;
+  return true;
+}
+
+int Benchmark(int V, int E, uint64_t seed, int threads) {
+  // a random DAG: each edge of a random digraph goes from its lower
+  // endpoint to its higher one
+  CompactDigraph random = GenerateDigraph(GraphModel::ErdosRenyi(V, E, seed), threads);
+  vector<int> offsets(V + 1), targets;
+  vector<vector<int>> adj(V);
+  for (int v = 0; v < V; v++)
+    for (int w : random.Adj(v))
+      if (v != w) adj[std::min(v, w)].push_back(std::max(v, w));
+  for (int v = 0; v < V; v++) {
+    targets.insert(targets.end(), adj[v].cbegin(), adj[v].cend());
+    offsets[v + 1] = targets.size();
+  }
+  CompactDigraph G(V, std::move(offsets), std::move(targets));
+  printf("random DAG: %d vertices, %d edges\n", G.V(), G.E());
+
+  Clock::time_point start = Clock::now();
+  Topological topological(G);
+  printf("Topological            %8.1f ms\n", MillisSince(start));
+
+  bool ok = topological.HasOrder();
+  for (int t = 1; t <= threads; t *= 2) {
+    start = Clock::now();
+    TopologicalX topological_x(G, t);
+    double time = MillisSince(start);
+    bool valid = topological_x.HasOrder() && Check(G, topological_x);
+    printf("TopologicalX           %8.1f ms, %d threads, %d levels, %s\n",
+           time, t, topological_x.levels(), valid ? "valid" : "invalid");
+    ok = ok && valid;
+  }
+  return ok ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc > 3) {
+    return Benchmark(std::stoi(argv[1]), std::stoi(argv[2]), std::stoull(argv[3]),
+                     argc > 4 ? std::stoi(argv[4]) : DefaultThreads());
+  }
+  string delimiter{" "};
+  if (argc > 2) delimiter = argv[2];
+  SymbolDigraph sg(argv[1], delimiter);
+  TopologicalX topological(*sg.digraph());
+  for (int l = 0; l < topological.levels(); l++) {
+    printf("level %d:", l);
+    for (int v : topological.Wavefront(l))
+      printf(" %s;", string(sg.NameOf(v)).c_str());
+    printf("\n");
+  }
+  return 0;
+}
+#endif
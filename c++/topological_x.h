@@ -0,0 +1,186 @@
+/**
+ *  The {@code TopologicalX} class represents a data type for
+ *  determining a topological order of a directed acyclic graph (DAG).
+ *  A digraph has a topological order if and only if it is a DAG.
+ *  The <em>hasOrder</em> operation determines whether the digraph has
+ *  a topological order, and if so, the <em>order</em> operation
+ *  returns one.
+ *  <p>
+ *  This implementation uses a nonrecursive, queue-based algorithm (Kahn's),
+ *  one level at a time. Level 0 holds the vertices of indegree 0, and level
+ *  <em>l</em> + 1 the vertices whose last edge in comes from level
+ *  <em>l</em>: the <em>level</em> of a vertex is the length of the longest
+ *  path that ends at it, and the vertices of a level, its
+ *  <em>wavefront</em>, do not depend on one another. Each level is
+ *  expanded on several threads, which count down the indegrees of the
+ *  heads of the edges leaving it with atomic decrements; the vertex whose
+ *  count reaches 0 joins the next level. The order lists the levels one
+ *  after the other, each in increasing order of vertex, so it does not
+ *  depend on the number of threads.
+ *  The constructor takes &Theta;(<em>V</em> + <em>E</em>) time in the
+ *  worst case, where <em>V</em> is the number of vertices and <em>E</em>
+ *  is the number of edges.
+ *  Afterwards, the <em>hasOrder</em>, <em>rank</em>, <em>level</em> and
+ *  <em>wavefront</em> operations take constant time.
+ *  It uses &Theta;(<em>V</em>) extra space (not including the digraph).
+ *  <p>
+ *  See {@link DirectedCycle}, {@link DirectedCycleX}, and
+ *  {@link EdgeWeightedDirectedCycle} to compute a
+ *  directed cycle if the digraph is not a DAG.
+ *  See {@link Topological} for a recursive version that uses depth-first search.
+ *  <p>
+ *  For additional documentation,
+ *  see <a href="https://algs4.cs.princeton.edu/42digraph">Section 4.2</a> of
+ *  <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
+ *
+ *  @author Robert Sedgewick
+ *  @author Kevin Wayne
+ */
+
+#ifndef TOPOLOGICAL_X_H_
+#define TOPOLOGICAL_X_H_
+
+#include <algorithm>
+#include <atomic>
+#include <span>
+#include <vector>
+
+#include "graph_concepts.h"
+#include "parallel.h"
+
+namespace algs4 {
+class TopologicalX {
+public:
+  /**
+   * Determines whether the digraph {@code G} has a topological order and, if so,
+   * finds such a topological order and the level of each vertex. {@code G} may
+   * be any adjacency digraph or edge-weighted digraph.
+   * @param G the digraph
+   * @param threads the number of threads
+   */
+  template <DirectedGraph Graph>
+  TopologicalX(const Graph& G, int threads = DefaultThreads()) : level_(G.V(), -1) {
+    int V = G.V();
+    // indegree[v] counts down the edges into v not yet removed
+    std::vector<int> indegree(V);
+    if constexpr (requires { G.Indegree(0); }) {
+      for (int v = 0; v < V; v++)
+        indegree[v] = G.Indegree(v);
+    } else {
+      for (int v = 0; v < V; v++)
+        for (int w : Heads(G, v))
+          indegree[w]++;
+    }
+
+    std::vector<int> frontier;
+    for (int v = 0; v < V; v++)
+      if (indegree[v] == 0) frontier.push_back(v);
+
+    int level = 0;
+    int count = 0;
+    while (!frontier.empty()) {
+      for (int v : frontier)
+        level_[v] = level;
+      count += frontier.size();
+
+      int t = static_cast<int>(
+          std::clamp<long long>(frontier.size() / kGrain, 1, std::max(threads, 1)));
+      std::vector<std::vector<int>> found(t);
+      ParallelInvoke(t, [&](int k) {
+        size_t begin = frontier.size() * k / t, end = frontier.size() * (k + 1) / t;
+        for (size_t i = begin; i < end; i++) {
+          for (int w : Heads(G, frontier[i])) {
+            int left = t == 1 ? --indegree[w] :
+              std::atomic_ref<int>(indegree[w]).fetch_sub(1, std::memory_order_relaxed) - 1;
+            if (left == 0) found[k].push_back(w);
+          }
+        }
+      });
+      frontier.clear();
+      for (const std::vector<int>& next : found)
+        frontier.insert(frontier.end(), next.cbegin(), next.cend());
+      level++;
+    }
+
+    if (count == V) Order(level);
+    else std::fill(level_.begin(), level_.end(), -1);
+  }
+  TopologicalX() = delete;
+  TopologicalX(const TopologicalX& other) = default;
+  TopologicalX &operator=(const TopologicalX& other) = default;
+  TopologicalX(TopologicalX&& other) = default;
+  TopologicalX &operator=(TopologicalX&& other) = default;
+
+  /**
+   * Returns a topological order if the digraph has a topologial order,
+   * and an empty list otherwise.
+   * @return a topological order of the vertices (as an interable) if the
+   *    digraph has a topological order (or equivalently, if the digraph is a DAG),
+   *    and an empty list otherwise
+   */
+  const std::vector<int>& order() const { return order_; }
+  /**
+   * Does the digraph have a topological order?
+   * @return {@code true} if the digraph has a topological order (or equivalently,
+   *    if the digraph is a DAG), and {@code false} otherwise
+   */
+  bool HasOrder() const { return order_.size() == level_.size(); }
+  /**
+   * Does the digraph have a topological order?
+   * @return {@code true} if the digraph has a topological order (or equivalently,
+   *    if the digraph is a DAG), and {@code false} otherwise
+   * @deprecated Replaced by {@link #hasOrder()}.
+   */
+  bool IsDAG() const { return HasOrder(); }
+  /**
+   * The the rank of vertex {@code v} in the topological order;
+   * -1 if the digraph is not a DAG
+   *
+   * @param v vertex
+   * @return the position of vertex {@code v} in a topological order
+   *    of the digraph; -1 if the digraph is not a DAG
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   */
+  int rank(int v) const;
+  /**
+   * Returns the level of vertex {@code v}: the number of edges on the
+   * longest path that ends at {@code v}; -1 if the digraph is not a DAG.
+   *
+   * @param v vertex
+   * @return the level of vertex {@code v}; -1 if the digraph is not a DAG
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   */
+  int level(int v) const;
+  /**
+   * Returns the number of levels; 0 if the digraph is not a DAG.
+   * @return the number of levels
+   */
+  int levels() const { return static_cast<int>(first_.size()) - 1; }
+  /**
+   * Returns the vertices of level {@code l}, in increasing order: a
+   * contiguous part of the topological order.
+   *
+   * @param l the level
+   * @return the vertices of level {@code l}
+   * @throws IllegalArgumentException unless {@code 0 <= l < levels()}
+   */
+  std::span<const int> Wavefront(int l) const;
+
+private:
+  // enough frontier vertices to pay for starting a thread
+  static constexpr long long kGrain = 1 << 12;
+
+  // group the vertices by level into order_, and rank them
+  void Order(int levels);
+  // throw an IllegalArgumentException unless {@code 0 <= v < V}
+  void ValidateVertex(int v) const;
+
+private:
+  std::vector<int> level_;   // level_[v] = level of vertex v
+  std::vector<int> order_;   // vertices in topological order, level by level
+  std::vector<int> rank_;    // rank_[v] = rank of vertex v in order
+  std::vector<int> first_{0};   // level l is order_[first_[l], first_[l + 1])
+};
+}
+
+#endif  // TOPOLOGICAL_X_H_
@@ -1,17 +1,27 @@
 /******************************************************************************
  *  Compilation:  clang++ -c -O2 digraph.cc -std=c++20
+ *                clang++ -c -O2 compact_digraph.cc -std=c++20
+ *                clang++ -c -O2 tarjan_scc.cc -std=c++20
  *                clang++ -c -O2 directed_dfs.cc -std=c++20
- *                clang++ -DDebug -O2 transitive_closure.cc directed_dfs.o digraph.o -std=c++20 -o transitive_closure
+ *                clang++ -c -O2 directed_edge.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_digraph.cc -std=c++20
+ *                clang++ -c -O2 edge.cc -std=c++20
+ *                clang++ -c -O2 edge_weighted_graph.cc -std=c++20
+ *                clang++ -c -O2 graph_generator.cc -std=c++20
+ *                clang++ -DDebug -O2 transitive_closure.cc digraph.o compact_digraph.o tarjan_scc.o directed_dfs.o directed_edge.o edge_weighted_digraph.o edge.o edge_weighted_graph.o graph_generator.o -std=c++20 -pthread -o transitive_closure
  *  Execution:    ./transitive_closure filename.txt
- *  Dependencies: digraph.cc directed_dfs.cc
+ *                ./transitive_closure V E seed [threads]
+ *  Dependencies: digraph.cc compact_digraph.cc tarjan_scc.cc parallel.h
+ *                directed_dfs.cc graph_generator.h
  *  Data files:   https://algs4.cs.princeton.edu/42digraph/tinyDG.txt
  *
  *  Compute transitive closure of a digraph and support
  *  reachability queries.
  *
- *  Preprocessing time: O(V(E + V)) time.
+ *  Preprocessing time: O(V + E + C * E' / 64), for C strong components
+ *  and E' edges between them.
  *  Query time: O(1).
- *  Space: O(V^2).
+ *  Space: O(V + C^2 / 8) bytes.
  *
  *  % ./transitive_closure tinyDG.txt
  *         0  1  2  3  4  5  6  7  8  9 10 11 12
@@ -30,23 +40,41 @@
  *   11:   T  T  T  T  T  T           T  T  T  T
  *   12:   T  T  T  T  T  T           T  T  T  T
  *
+ *  % ./transitive_closure 20000 30000 1
+ *  random digraph: 20000 vertices, 30000 edges
+ *  TransitiveClosure:      21.1 ms, 13119 strong components
+ *  DirectedDFS from every vertex:  11012.7 ms
+ *  closures agree
+ *
  ******************************************************************************/
 
 /**
  *  The {@code TransitiveClosure} class represents a data type for
  *  computing the transitive closure of a digraph.
  *  <p>
- *  This implementation runs depth-first search from each vertex.
- *  The constructor takes &Theta;(<em>V</em>(<em>V</em> + <em>E</em>))
- *  in the worst case, where <em>V</em> is the number of vertices and
- *  <em>E</em> is the number of edges.
- *  Each instance method takes &Theta;(1) time.
- *  It uses &Theta;(<em>V</em><sup>2</sup>) extra space (not including the digraph).
+ *  This implementation works on the condensation of the digraph, since two
+ *  vertices of the same strong component reach the same vertices. It keeps
+ *  one row of bits per strong component, all in one contiguous matrix, and
+ *  fills the rows in reverse topological order: the row of a component is
+ *  its own bit OR-ed with the rows of the components it has edges to, 64
+ *  bits at a time in a loop the compiler vectorizes. As {@link TarjanSCC}
+ *  numbers the components in reverse topological order, the row of
+ *  component <em>c</em> has no bit beyond <em>c</em>, so only that prefix
+ *  is copied. The components are processed level by level, the level of a
+ *  component being the length of the longest path leaving it, and the
+ *  components of a level in parallel.
+ *  The constructor takes &Theta;(<em>V</em> + <em>E</em>) time plus
+ *  &Theta;(<em>C</em> / 64) time per edge of the condensation,
+ *  where <em>V</em> is the number of vertices, <em>E</em> is the number of
+ *  edges and <em>C</em> is the number of strong components.
+ *  Each instance method takes &Theta;(1) time: a bit test.
+ *  It uses &Theta;(<em>C</em><sup>2</sup>) bits of extra space (not including the digraph).
  *  <p>
- *  For large digraphs, you may want to consider a more sophisticated algorithm.
- *  <a href = "http://www.cs.hut.fi/~enu/thesis.html">Nuutila</a> proposes two
- *  algorithm for the problem (based on strong components and an interval representation)
- *  that runs in &Theta;(<em>E</em> + <em>V</em>) time on typical digraphs.
+ *  <a href = "http://www.cs.hut.fi/~enu/thesis.html">Nuutila</a> describes
+ *  this approach, and an interval representation of the rows that saves
+ *  space on typical digraphs.
+ *  For digraphs with too many strong components for the matrix, see
+ *  {@link ReachabilityIndex}, which has the same API.
  *
  *  For additional documentation,
  *  see <a href="https://algs4.cs.princeton.edu/42digraph">Section 4.2</a> of
@@ -58,30 +86,67 @@
 
 #include "transitive_closure.h"
 
+#include <algorithm>
 #include <exception>
 #include <string>
 
-#include "directed_dfs.h"
+#include "digraph.h"
 
 using std::vector;
 using std::to_string;
 
-TransitiveClosure::TransitiveClosure(const Digraph& G) : tc_(G.V()) {
-  for (int v = 0; v < G.V(); v++)
-    tc_[v] = new DirectedDFS(G, v);
-}
+namespace algs4 {
+void TransitiveClosure::Build(const CompactDigraph& dag, int threads) {
+  components_ = dag.V();
+  words_ = (components_ + 63) / 64;
+  rows_.assign(static_cast<size_t>(components_) * words_, 0);
+
+  // the level of each component, and the components grouped by level; the
+  // successors of a component have smaller ids, so they come first
+  vector<int> level(components_);
+  int levels = 0;
+  for (int c = 0; c < components_; c++) {
+    for (int d : dag.Adj(c))
+      level[c] = std::max(level[c], level[d] + 1);
+    levels = std::max(levels, level[c] + 1);
+  }
+  vector<int> first(levels + 1);
+  for (int c = 0; c < components_; c++)
+    ++first[level[c] + 1];
+  for (int l = 0; l < levels; l++)
+    first[l + 1] += first[l];
+  vector<int> order(components_);
+  {
+    vector<int> next(first.cbegin(), first.cend() - 1);
+    for (int c = 0; c < components_; c++)
+      order[next[level[c]]++] = c;
+  }
 
-bool TransitiveClosure::Reachable(int v, int w) const {
-  ValidateVertex(v);
-  ValidateVertex(w);
-  return tc_[v]->Marked(w);
+  for (int l = 0; l < levels; l++) {
+    int n = first[l + 1] - first[l];
+    // enough work per thread to pay for starting it
+    int t = static_cast<int>(std::clamp<long long>(1LL * n * words_ / 4096, 1, threads));
+    ParallelFor(n, t, [&](long long begin, long long end) {
+      for (long long i = begin; i < end; i++) {
+        int c = order[first[l] + i];
+        uint64_t *row = &rows_[static_cast<size_t>(c) * words_];
+        row[c / 64] |= uint64_t{1} << (c % 64);
+        for (int d : dag.Adj(c)) {
+          const uint64_t *from = &rows_[static_cast<size_t>(d) * words_];
+          for (int k = 0; k <= d / 64; k++)
+            row[k] |= from[k];
+        }
+      }
+    });
+  }
 }
 
 void TransitiveClosure::ValidateVertex(int v) const {
-  int V = tc_.size();
+  int V = id_.size();
   if (v < 0 || v >= V)
     throw std::invalid_argument("vertex " + to_string(v) + " is not between 0 and " + to_string(V-1));
 }
+}
 
 /**
  * Unit tests the {@code TransitiveClosure} data type.
@@ -89,9 +154,47 @@ void TransitiveClosure::ValidateVertex(int v) const {
  * @param args the command-line arguments
  */
 #ifdef Debug
+#include <chrono>
+#include <cstdio>
 #include <iostream>
 #include <cstdlib>
+
+#include "directed_dfs.h"
+#include "graph_generator.h"
+
+using namespace algs4;
+
+// compares the closure of a random digraph with a search from every vertex
+int Benchmark(int V, int E, uint64_t seed, int threads) {
+  using Clock = std::chrono::steady_clock;
+  CompactDigraph G = GenerateDigraph(GraphModel::ErdosRenyi(V, E, seed), threads);
+  printf("random digraph: %d vertices, %d edges\n", G.V(), G.E());
+
+  Clock::time_point start = Clock::now();
+  TransitiveClosure tc(G, threads);
+  printf("TransitiveClosure:  %8.1f ms, %d strong components\n",
+         std::chrono::duration<double, std::milli>(Clock::now() - start).count(),
+         tc.components());
+
+  start = Clock::now();
+  bool agree = true;
+  for (int v = 0; v < V; v++) {
+    DirectedDFS dfs(G, v);
+    for (int w = 0; w < V; w++)
+      agree = agree && dfs.Marked(w) == tc.Reachable(v, w);
+  }
+  printf("DirectedDFS from every vertex: %8.1f ms\n",
+         std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+  printf("closures %s\n", agree ? "agree" : "differ");
+
+  return agree ? 0 : 1;
+}
+
 int main(int argc, char *argv[]) {
+  if (argc > 2) {
+    return Benchmark(std::stoi(argv[1]), std::stoi(argv[2]), std::stoull(argv[3]),
+                     argc > 4 ? std::stoi(argv[4]) : DefaultThreads());
+  }
   std::fstream in(argv[1]);
   if (!in.is_open()) {
     std::cout << "failed to open " << argv[1] << '\n';
@@ -1,19 +1,30 @@
 #ifndef TRANSITIVE_CLOSURE
 #define TRANSITIVE_CLOSURE
 
+#include <cstdint>
 #include <vector>
 
-#include "digraph.h"
+#include "compact_digraph.h"
+#include "graph_concepts.h"
+#include "parallel.h"
+#include "tarjan_scc.h"
 
-class DirectedDFS;
+namespace algs4 {
 
 class TransitiveClosure {
 public:
   /**
    * Computes the transitive closure of the digraph {@code G}.
    * @param G the digraph
+   * @param threads the number of threads
    */
-  TransitiveClosure(const Digraph& G);
+  template <DirectedGraph Graph>
+  TransitiveClosure(const Graph& G, int threads = DefaultThreads()) : id_(G.V()) {
+    TarjanSCC scc(G);
+    for (int v = 0; v < G.V(); v++)
+      id_[v] = scc.id(v);
+    Build(scc.Condensation(G), threads);
+  }
   TransitiveClosure(const TransitiveClosure& other) = default;
   TransitiveClosure &operator=(const TransitiveClosure& other) = default;
   TransitiveClosure(TransitiveClosure&& other) = default;
@@ -28,13 +39,30 @@ public:
    * @throws IllegalArgumentException unless {@code 0 <= v < V}
    * @throws IllegalArgumentException unless {@code 0 <= w < V}
    */
-  bool Reachable(int v, int w) const;
+  bool Reachable(int v, int w) const {
+    ValidateVertex(v);
+    ValidateVertex(w);
+    int c = id_[w];
+    return rows_[static_cast<size_t>(id_[v]) * words_ + c / 64] >> (c % 64) & 1;
+  }
+  /**
+   * Returns the number of strong components, the side of the reachability matrix.
+   * @return the number of strong components
+   */
+  int components() const { return components_; }
 private:
+  // fill the reachability matrix of the condensation, whose edges all go
+  // from a higher component id to a lower one
+  void Build(const CompactDigraph& dag, int threads);
   // throw an IllegalArgumentException unless {@code 0 <= v < V}
   void ValidateVertex(int v) const;
 
 private:
-  std::vector<DirectedDFS *> tc_;  // tc[v] = Reachable from v
+  std::vector<int> id_;             // id_[v] = strong component containing v
+  int components_{0};               // number of strong components
+  int words_{0};                    // 64-bit words per row
+  std::vector<uint64_t> rows_;      // bit d of row c = is component d reachable from c?
 };
+}
 
 #endif
@@ -0,0 +1,207 @@
+#ifndef VERTEX_ORDERING_H_
+#define VERTEX_ORDERING_H_
+
+#include <vector>
+#include <span>
+
+#include "digraph.h"
+#include "directed_edge.h"
+#include "edge.h"
+#include "edge_weighted_digraph.h"
+#include "edge_weighted_graph.h"
+
+/**
+ *  The {@code VertexOrdering} class represents a relabeling of the vertices
+ *  of a graph, chosen so that vertices that are close in the graph get
+ *  nearby ids. Graph algorithms index their vertex arrays by id, so after
+ *  relabeling, the arrays touched while scanning an adjacency list lie
+ *  close together in memory.
+ *  <p>
+ *  Three orderings are supported, each computed on the graph with its edge
+ *  directions ignored:
+ *  <ul>
+ *  <li> {@code kBfs}: breadth-first order, starting from each unvisited
+ *       vertex in turn, in increasing order of id.
+ *  <li> {@code kReverseCuthillMcKee}: breadth-first order that starts each
+ *       component at a vertex of minimum degree and visits the neighbors of a
+ *       vertex in increasing order of degree, reversed. This keeps the
+ *       bandwidth of the adjacency matrix small.
+ *  <li> {@code kDegree}: decreasing order of degree, so that the hubs share
+ *       the first cache lines of every vertex array.
+ *  </ul>
+ *  Ties are broken by the original id, so every ordering is deterministic.
+ *  <p>
+ *  {@code Apply()} builds the relabeled graph. Results of an algorithm run
+ *  on it map back to the original ids with {@code OldId()},
+ *  {@code OldEdge()} and {@code ByOldId()}; a source vertex maps in with
+ *  {@code NewId()}. The relabeled adjacency lists keep the order of the
+ *  original ones, and edge ids of the relabeled {@link EdgeWeightedDigraph}
+ *  and {@link EdgeWeightedGraph} are renumbered to follow the new vertex
+ *  order, so that the edge arrays are scanned sequentially as well.
+ *  <p>
+ *  Computing an ordering takes time proportional to <em>V</em> + <em>E</em>,
+ *  plus <em>E</em> log <em>E</em> for {@code kReverseCuthillMcKee} and
+ *  <em>V</em> log <em>V</em> for {@code kDegree}.
+ */
+
+namespace algs4 {
+
+class VertexOrdering {
+public:
+  enum Method { kBfs, kReverseCuthillMcKee, kDegree };
+
+  /**
+   * Computes the ordering {@code method} of the vertices of the digraph {@code G}.
+   *
+   * @param  G the digraph
+   * @param  method the ordering to compute
+   */
+  VertexOrdering(const Digraph& G, Method method);
+  /**
+   * Computes the ordering {@code method} of the vertices of the edge-weighted
+   * digraph {@code G}.
+   *
+   * @param  G the edge-weighted digraph
+   * @param  method the ordering to compute
+   */
+  VertexOrdering(const EdgeWeightedDigraph& G, Method method);
+  /**
+   * Computes the ordering {@code method} of the vertices of the edge-weighted
+   * graph {@code G}.
+   *
+   * @param  G the edge-weighted graph
+   * @param  method the ordering to compute
+   */
+  VertexOrdering(const EdgeWeightedGraph& G, Method method);
+  /**
+   * Initializes an ordering from the list of original ids in their new order.
+   *
+   * @param  order {@code order[i]} = original id of the vertex with new id <em>i</em>
+   * @throws IllegalArgumentException unless {@code order} is a permutation of
+   *         0 through {@code order.size()} - 1
+   */
+  explicit VertexOrdering(std::vector<int> order);
+  VertexOrdering() = delete;
+  VertexOrdering(const VertexOrdering& other) = default;
+  VertexOrdering &operator=(const VertexOrdering& other) = default;
+  VertexOrdering(VertexOrdering&& other) = default;
+  VertexOrdering &operator=(VertexOrdering&& other) = default;
+  /**
+   * Returns the number of vertices.
+   *
+   * @return the number of vertices
+   */
+  int V() const { return static_cast<int>(new_id_.size()); }
+  /**
+   * Returns the new id of the vertex with original id {@code v}.
+   *
+   * @param  v the original id
+   * @return the new id of {@code v}
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   */
+  int NewId(int v) const;
+  /**
+   * Returns the original id of the vertex with new id {@code v}.
+   *
+   * @param  v the new id
+   * @return the original id of {@code v}
+   * @throws IllegalArgumentException unless {@code 0 <= v < V}
+   */
+  int OldId(int v) const;
+  /**
+   * Returns the forward permutation.
+   *
+   * @return the array whose entry <em>v</em> is the new id of original vertex <em>v</em>
+   */
+  std::span<const int> new_ids() const { return new_id_; }
+  /**
+   * Returns the inverse permutation.
+   *
+   * @return the array whose entry <em>v</em> is the original id of new vertex <em>v</em>
+   */
+  std::span<const int> old_ids() const { return old_id_; }
+  /**
+   * Returns the digraph {@code G} with its vertices relabeled.
+   *
+   * @param  G the digraph
+   * @return the relabeled digraph
+   * @throws IllegalArgumentException unless {@code G} has <em>V</em> vertices
+   */
+  Digraph Apply(const Digraph& G) const;
+  /**
+   * Returns the edge-weighted digraph {@code G} with its vertices relabeled
+   * and its edges renumbered in order of new tail vertex.
+   *
+   * @param  G the edge-weighted digraph
+   * @return the relabeled edge-weighted digraph
+   * @throws IllegalArgumentException unless {@code G} has <em>V</em> vertices
+   */
+  EdgeWeightedDigraph Apply(const EdgeWeightedDigraph& G) const;
+  /**
+   * Returns the edge-weighted graph {@code G} with its vertices relabeled
+   * and its edges renumbered in order of their lower new endpoint.
+   *
+   * @param  G the edge-weighted graph
+   * @return the relabeled edge-weighted graph
+   * @throws IllegalArgumentException unless {@code G} has <em>V</em> vertices
+   */
+  EdgeWeightedGraph Apply(const EdgeWeightedGraph& G) const;
+  /**
+   * Returns the edge {@code e} of a relabeled graph with its endpoints
+   * mapped back to the original ids.
+   *
+   * @param  e the edge, with new ids
+   * @return the same edge, with original ids
+   * @throws IllegalArgumentException unless the endpoints are between 0 and <em>V</em> - 1
+   */
+  DirectedEdge OldEdge(const DirectedEdge& e) const;
+  Edge OldEdge(const Edge& e) const;
+  /**
+   * Maps an array indexed by new id to an array indexed by original id.
+   *
+   * @param  values {@code values[v]} = the value of the vertex with new id <em>v</em>
+   * @return the array whose entry <em>v</em> is the value of original vertex <em>v</em>
+   * @throws IllegalArgumentException unless {@code values} has <em>V</em> entries
+   */
+  template <typename T>
+  std::vector<T> ByOldId(std::span<const T> values) const {
+    if (static_cast<int>(values.size()) != V())
+      throw std::invalid_argument("expected " + std::to_string(V()) + " values");
+    std::vector<T> result;
+    result.reserve(values.size());
+    for (int v : new_id_) result.push_back(values[v]);
+
+    return result;
+  }
+  template <typename T>
+  std::vector<T> ByOldId(const std::vector<T>& values) const {
+    return ByOldId(std::span<const T>(values));
+  }
+
+private:
+  // the neighbors of every vertex, edge directions ignored, in CSR form
+  struct Neighbors {
+    std::vector<int> offsets;
+    std::vector<int> targets;
+  };
+  VertexOrdering(const Neighbors& G, Method method);
+  // compute old_id_ for the method, then new_id_ as its inverse
+  void Bfs(const Neighbors& G);
+  void ReverseCuthillMcKee(const Neighbors& G);
+  void DegreeSort(const Neighbors& G);
+  void Invert();
+  // throw an IllegalArgumentException unless {@code 0 <= v < V}
+  void ValidateVertex(int v) const;
+  // throw an IllegalArgumentException unless the graph has V vertices
+  void ValidateSize(int V) const;
+  static Neighbors Symmetrize(const Digraph& G);
+  static Neighbors Symmetrize(const EdgeWeightedDigraph& G);
+  static Neighbors Symmetrize(const EdgeWeightedGraph& G);
+
+private:
+  std::vector<int> new_id_;   // new_id_[v] = new id of original vertex v
+  std::vector<int> old_id_;   // old_id_[v] = original id of new vertex v
+};
+}
+
+#endif  // VERTEX_ORDERING_H_